@@ -389,11 +389,15 @@ data:
 This package provides header files for the HiPerConTracer I/O library.
 
 %files libhpctio-devel
+%{_includedir}/hipercontracer/compressionpool.h
 %{_includedir}/hipercontracer/compressortype.h
 %{_includedir}/hipercontracer/inputstream.h
 %{_includedir}/hipercontracer/logger.h
 %{_includedir}/hipercontracer/outputstream.h
+%{_includedir}/hipercontracer/resultsarchive.h
+%{_includedir}/hipercontracer/resultsindex.h
 %{_includedir}/hipercontracer/tools.h
+%{_includedir}/hipercontracer/zstddictionary.h
 %{_libdir}/libhpctio*.so
 %{_libdir}/libhpctio.a
 
@@ -502,16 +506,19 @@ them to integrate HiPerConTracer into your own programs.
 %files libhipercontracer-devel
 %dir %attr(0755, root, root) %{_includedir}/hipercontracer
 %{_includedir}/hipercontracer/check.h
+%{_includedir}/hipercontracer/ddsketch.h
 %{_includedir}/hipercontracer/destinationinfo.h
 %{_includedir}/hipercontracer/iomodule-base.h
 %{_includedir}/hipercontracer/iomodule-icmp.h
 %{_includedir}/hipercontracer/iomodule-udp.h
+%{_includedir}/hipercontracer/iomodule-tcp.h
 # {_includedir}/hipercontracer/jitter.h
 %{_includedir}/hipercontracer/ping.h
 %{_includedir}/hipercontracer/resultentry.h
 %{_includedir}/hipercontracer/resultswriter.h
 %{_includedir}/hipercontracer/service.h
 %{_includedir}/hipercontracer/traceroute.h
+%{_includedir}/hipercontracer/ttlcache.h
 %{_libdir}/libhipercontracer*.so
 %{_libdir}/libhipercontracer.a
 
@@ -619,6 +626,7 @@ This package provides header files for the HiPerConTracer
 database access library.
 
 %files libhpctdb-devel
+%{_includedir}/hipercontracer/database-bulkrows.h
 %{_includedir}/hipercontracer/database-configuration.h
 %{_includedir}/hipercontracer/database-statement.h
 %{_includedir}/hipercontracer/databaseclient-base.h
@@ -29,8 +29,10 @@
 
 
 TRUNCATE TABLE Ping;
+TRUNCATE TABLE PingSummary;
 TRUNCATE TABLE Traceroute;
 TRUNCATE TABLE Jitter;
 OPTIMIZE TABLE Ping;
+OPTIMIZE TABLE PingSummary;
 OPTIMIZE TABLE Traceroute;
 OPTIMIZE TABLE Jitter;
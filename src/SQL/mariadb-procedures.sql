@@ -267,12 +267,16 @@ DELIMITER ;
 
 -- ###### Add events to create partitions ###################################
 DROP EVENT IF EXISTS PingMaintenance;
+DROP EVENT IF EXISTS PingSummaryMaintenance;
 DROP EVENT IF EXISTS TracerouteMaintenance;
 DROP EVENT IF EXISTS JitterMaintenance;
 DELIMITER $$
 CREATE EVENT PingMaintenance ON SCHEDULE EVERY 1 DAY STARTS CURRENT_TIMESTAMP + INTERVAL 0 HOUR DO
    CALL CreateDailyPartitionsForTable("test4hpct", "Ping", "SendTimestamp");
 $$
+CREATE EVENT PingSummaryMaintenance ON SCHEDULE EVERY 1 DAY STARTS CURRENT_TIMESTAMP + INTERVAL 1 HOUR DO
+   CALL CreateDailyPartitionsForTable("test4hpct", "PingSummary", "WindowStart");
+$$
 CREATE EVENT TracerouteMaintenance ON SCHEDULE EVERY 1 DAY STARTS CURRENT_TIMESTAMP + INTERVAL 3 HOUR DO
    CALL CreateDailyPartitionsForTable("test4hpct", "Traceroute", "Timestamp");
 $$
@@ -76,6 +76,40 @@ PAGE_COMPRESSED=1;   -- Enable page compression!
 CREATE INDEX PingRelationIndex ON Ping (MeasurementID ASC, DestinationIP ASC, SendTimestamp ASC);
 
 
+-- ###### Ping Summary ######################################################
+DROP TABLE IF EXISTS PingSummary;
+CREATE TABLE PingSummary (
+   WindowStart      INT8 UNSIGNED NOT NULL,              -- Window start timestamp (nanoseconds since 1970-01-01, 00:00:00 UTC)
+   MeasurementID    INT8 UNSIGNED NOT NULL DEFAULT 0,    -- MeasurementID
+   SourceIP         INET6         NOT NULL,              -- Source IP address
+   DestinationIP    INET6         NOT NULL,              -- Destination IP address
+   Protocol         INT1 UNSIGNED NOT NULL DEFAULT 0,    -- Protocol (ICMP, UDP, ...)
+   TrafficClass     INT1 UNSIGNED NOT NULL DEFAULT 0,    -- Traffic Class
+   WindowEnd        INT8 UNSIGNED NOT NULL,              -- Window end timestamp (nanoseconds since 1970-01-01, 00:00:00 UTC)
+   PacketSize       INT2 UNSIGNED NOT NULL DEFAULT 0,    -- Packet size (bytes)
+   SourcePort       INT2 UNSIGNED NOT NULL DEFAULT 0,    -- Source port
+   DestinationPort  INT2 UNSIGNED NOT NULL DEFAULT 0,    -- Destination port
+   Sent             INT4 UNSIGNED NOT NULL DEFAULT 0,    -- Number of requests sent
+   Received         INT4 UNSIGNED NOT NULL DEFAULT 0,    -- Number of successful responses
+   Lost             INT4 UNSIGNED NOT NULL DEFAULT 0,    -- Number of timeouts
+   Errors           INT4 UNSIGNED NOT NULL DEFAULT 0,    -- Number of other results (ICMP errors, send errors)
+
+   RTT_Min          INT8          NOT NULL DEFAULT -1,   -- Minimum RTT (nanoseconds; -1 if not available)
+   RTT_Mean         INT8          NOT NULL DEFAULT -1,   -- Mean RTT (nanoseconds; -1 if not available)
+   RTT_Max          INT8          NOT NULL DEFAULT -1,   -- Maximum RTT (nanoseconds; -1 if not available)
+   RTT_P50          INT8          NOT NULL DEFAULT -1,   -- Estimated 50th percentile RTT (nanoseconds; -1 if not available)
+   RTT_P90          INT8          NOT NULL DEFAULT -1,   -- Estimated 90th percentile RTT (nanoseconds; -1 if not available)
+   RTT_P95          INT8          NOT NULL DEFAULT -1,   -- Estimated 95th percentile RTT (nanoseconds; -1 if not available)
+   RTT_P99          INT8          NOT NULL DEFAULT -1,   -- Estimated 99th percentile RTT (nanoseconds; -1 if not available)
+
+   PRIMARY KEY (WindowStart, MeasurementID, SourceIP, DestinationIP, Protocol, TrafficClass)
+)
+PAGE_COMPRESSED=1;   -- Enable page compression!
+-- NOTE: Partitioning is enabled in mariadb-procedures.sql!
+
+CREATE INDEX PingSummaryRelationIndex ON PingSummary (MeasurementID ASC, DestinationIP ASC, WindowStart ASC);
+
+
 -- ###### Traceroute ########################################################
 DROP TABLE IF EXISTS Traceroute;
 CREATE TABLE Traceroute (
@@ -47,6 +47,7 @@ GRANT ALL PRIVILEGES ON ${DATABASE}.* TO maintainer WITH GRANT OPTION;
 DROP USER IF EXISTS importer;
 CREATE USER importer IDENTIFIED BY '${IMPORTER_PASSWORD}';
 GRANT INSERT, UPDATE ON Ping TO importer;
+GRANT INSERT, UPDATE ON PingSummary TO importer;
 GRANT INSERT, UPDATE ON Traceroute TO importer;
 GRANT INSERT, UPDATE ON Jitter TO importer;
 
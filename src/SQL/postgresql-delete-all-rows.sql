@@ -29,5 +29,6 @@
 
 
 TRUNCATE TABLE Ping;
+TRUNCATE TABLE PingSummary;
 TRUNCATE TABLE Traceroute;
 TRUNCATE TABLE Jitter;
@@ -76,6 +76,45 @@ CREATE TABLE Ping_p2027 PARTITION OF Ping FOR VALUES FROM (1000000000 * EXTRACT(
 CREATE INDEX PingRelationIndex ON Ping (MeasurementID ASC, DestinationIP ASC, SendTimestamp ASC);
 
 
+-- ###### Ping Summary ######################################################
+DROP TABLE IF EXISTS PingSummary CASCADE;
+CREATE TABLE PingSummary (
+   WindowStart      BIGINT      NOT NULL,              -- Window start timestamp (nanoseconds since 1970-01-01, 00:00:00 UTC)
+   MeasurementID    INTEGER     NOT NULL DEFAULT 0,    -- MeasurementID
+   SourceIP         INET        NOT NULL,              -- Source IP address
+   DestinationIP    INET        NOT NULL,              -- Destination IP address
+   Protocol         SMALLINT    NOT NULL DEFAULT 0,    -- Protocol (ICMP, UDP, ...)
+   TrafficClass     SMALLINT    NOT NULL DEFAULT 0,    -- Traffic Class
+   WindowEnd        BIGINT      NOT NULL,              -- Window end timestamp (nanoseconds since 1970-01-01, 00:00:00 UTC)
+   PacketSize       INTEGER     NOT NULL DEFAULT 0,    -- Packet size (bytes)
+   SourcePort       INTEGER     NOT NULL DEFAULT 0,    -- Source port
+   DestinationPort  INTEGER     NOT NULL DEFAULT 0,    -- Destination port
+   Sent             INTEGER     NOT NULL DEFAULT 0,    -- Number of requests sent
+   Received         INTEGER     NOT NULL DEFAULT 0,    -- Number of successful responses
+   Lost             INTEGER     NOT NULL DEFAULT 0,    -- Number of timeouts
+   Errors           INTEGER     NOT NULL DEFAULT 0,    -- Number of other results (ICMP errors, send errors)
+
+   RTT_Min          BIGINT      NOT NULL DEFAULT -1,   -- Minimum RTT (nanoseconds; -1 if not available)
+   RTT_Mean         BIGINT      NOT NULL DEFAULT -1,   -- Mean RTT (nanoseconds; -1 if not available)
+   RTT_Max          BIGINT      NOT NULL DEFAULT -1,   -- Maximum RTT (nanoseconds; -1 if not available)
+   RTT_P50          BIGINT      NOT NULL DEFAULT -1,   -- Estimated 50th percentile RTT (nanoseconds; -1 if not available)
+   RTT_P90          BIGINT      NOT NULL DEFAULT -1,   -- Estimated 90th percentile RTT (nanoseconds; -1 if not available)
+   RTT_P95          BIGINT      NOT NULL DEFAULT -1,   -- Estimated 95th percentile RTT (nanoseconds; -1 if not available)
+   RTT_P99          BIGINT      NOT NULL DEFAULT -1,   -- Estimated 99th percentile RTT (nanoseconds; -1 if not available)
+
+   PRIMARY KEY (WindowStart, MeasurementID, SourceIP, DestinationIP, Protocol, TrafficClass)
+) PARTITION BY RANGE (WindowStart);
+CREATE TABLE PingSummary_p2021 PARTITION OF PingSummary FOR VALUES FROM (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2021-01-01')) TO (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2022-01-01'));
+CREATE TABLE PingSummary_p2022 PARTITION OF PingSummary FOR VALUES FROM (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2022-01-01')) TO (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2023-01-01'));
+CREATE TABLE PingSummary_p2023 PARTITION OF PingSummary FOR VALUES FROM (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2023-01-01')) TO (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2024-01-01'));
+CREATE TABLE PingSummary_p2024 PARTITION OF PingSummary FOR VALUES FROM (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2024-01-01')) TO (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2025-01-01'));
+CREATE TABLE PingSummary_p2025 PARTITION OF PingSummary FOR VALUES FROM (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2025-01-01')) TO (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2026-01-01'));
+CREATE TABLE PingSummary_p2026 PARTITION OF PingSummary FOR VALUES FROM (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2026-01-01')) TO (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2027-01-01'));
+CREATE TABLE PingSummary_p2027 PARTITION OF PingSummary FOR VALUES FROM (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2027-01-01')) TO (1000000000 * EXTRACT(EPOCH FROM TIMESTAMP '2028-01-01'));
+
+CREATE INDEX PingSummaryRelationIndex ON PingSummary (MeasurementID ASC, DestinationIP ASC, WindowStart ASC);
+
+
 -- ###### Traceroute ########################################################
 DROP TABLE IF EXISTS Traceroute CASCADE;
 CREATE TABLE Traceroute (
@@ -49,6 +49,7 @@ GRANT ALL PRIVILEGES ON DATABASE ${DATABASE} TO maintainer;
 GRANT ALL PRIVILEGES ON ALL TABLES IN SCHEMA public TO maintainer;
 ALTER DATABASE ${DATABASE} OWNER TO maintainer;
 ALTER TABLE Ping OWNER TO maintainer;
+ALTER TABLE PingSummary OWNER TO maintainer;
 ALTER TABLE Traceroute OWNER TO maintainer;
 ALTER TABLE Jitter OWNER TO maintainer;
 
@@ -58,6 +59,7 @@ DROP USER IF EXISTS importer;
 CREATE USER importer WITH LOGIN ENCRYPTED PASSWORD '${IMPORTER_PASSWORD}';
 GRANT CONNECT ON DATABASE ${DATABASE} TO importer;
 GRANT INSERT, UPDATE ON TABLE Ping TO importer;
+GRANT INSERT, UPDATE ON TABLE PingSummary TO importer;
 GRANT INSERT, UPDATE ON TABLE Traceroute TO importer;
 GRANT INSERT, UPDATE ON TABLE Jitter TO importer;
 
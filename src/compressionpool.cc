@@ -0,0 +1,999 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#include "compressionpool.h"
+#include "logger.h"
+#include "zstddictionary.h"
+
+#include <cassert>
+#include <time.h>
+#include <bzlib.h>
+#include <lzma.h>
+#include <zlib.h>
+#include <zstd.h>
+
+
+unsigned int CompressionPool::ConfiguredThreads      = 0;
+size_t       CompressionPool::ConfiguredMemoryBudget = CompressionPool::DefaultMemoryBudget;
+
+
+// ###### Sequential decoder for concatenated streams/members/frames ########
+class StreamDecoder
+{
+   public:
+   StreamDecoder(const CompressorType compressor);
+   ~StreamDecoder();
+
+   void decode(const char* data, const size_t size, std::string& output);
+   void finish();
+
+   private:
+   void beginStream(const char* data, const size_t size);
+   void endStream();
+
+   const CompressorType Compressor;
+   bool                 InStream;
+   z_stream             ZLibStream;
+   bz_stream            BZip2Stream;
+   ZSTD_DCtx*           ZSTDContext;
+   bool                 ZSTDDictionarySelected;
+   char                 Buffer[65536];
+};
+
+
+// ###### Constructor #######################################################
+StreamDecoder::StreamDecoder(const CompressorType compressor)
+   : Compressor(compressor)
+{
+   InStream               = false;
+   ZSTDContext            = nullptr;
+   ZSTDDictionarySelected = false;
+   memset(&ZLibStream, 0, sizeof(ZLibStream));
+   memset(&BZip2Stream, 0, sizeof(BZip2Stream));
+   if(Compressor == CT_ZSTD) {
+      ZSTDContext = ZSTD_createDCtx();
+      if(ZSTDContext == nullptr) {
+         throw std::bad_alloc();
+      }
+   }
+   else if( (Compressor != CT_GZip) && (Compressor != CT_BZip2) ) {
+      throw std::runtime_error("Unsupported compressor for stream decoder");
+   }
+}
+
+
+// ###### Destructor ########################################################
+StreamDecoder::~StreamDecoder()
+{
+   endStream();
+   if(ZSTDContext != nullptr) {
+      ZSTD_freeDCtx(ZSTDContext);
+   }
+}
+
+
+// ###### Begin a new stream/member/frame ###################################
+void StreamDecoder::beginStream(const char* data, const size_t size)
+{
+   switch(Compressor) {
+      case CT_GZip:
+         if(inflateInit2(&ZLibStream, 16 + MAX_WBITS) != Z_OK) {
+            throw std::runtime_error("Unable to initialise GZip decoder");
+         }
+       break;
+      case CT_BZip2:
+         if(BZ2_bzDecompressInit(&BZip2Stream, 0, 0) != BZ_OK) {
+            throw std::runtime_error("Unable to initialise BZip2 decoder");
+         }
+       break;
+      case CT_ZSTD:
+         // The dictionary is selected by the ID in the first frame
+         if(!ZSTDDictionarySelected) {
+            const unsigned int id = ZSTD_getDictID_fromFrame(data, size);
+            if(id != 0) {
+               const ZSTDDictionary* dictionary = ZSTDDictionary::getDictionary(id);
+               if(dictionary == nullptr) {
+                  throw std::runtime_error("ZSTD dictionary " + std::to_string(id) + " is not loaded");
+               }
+               ZSTD_DCtx_refDDict(ZSTDContext, dictionary->decompressionDictionary());
+            }
+            ZSTDDictionarySelected = true;
+         }
+       break;
+      default:
+       break;
+   }
+   InStream = true;
+}
+
+
+// ###### End the current stream/member/frame ###############################
+void StreamDecoder::endStream()
+{
+   if(InStream) {
+      switch(Compressor) {
+         case CT_GZip:
+            inflateEnd(&ZLibStream);
+            memset(&ZLibStream, 0, sizeof(ZLibStream));
+          break;
+         case CT_BZip2:
+            BZ2_bzDecompressEnd(&BZip2Stream);
+            memset(&BZip2Stream, 0, sizeof(BZip2Stream));
+          break;
+         default:
+          break;
+      }
+      InStream = false;
+   }
+}
+
+
+// ###### Decode data, appending the decoded data to output #################
+void StreamDecoder::decode(const char* data, const size_t size, std::string& output)
+{
+   size_t position = 0;
+   while(position < size) {
+      if(!InStream) {
+         beginStream(data + position, size - position);
+      }
+
+      size_t consumed;
+      size_t produced;
+      bool   streamEnd;
+      switch(Compressor) {
+         case CT_GZip: {
+            ZLibStream.next_in   = (Bytef*)(data + position);
+            ZLibStream.avail_in  = (uInt)std::min(size - position, (size_t)UINT32_MAX);
+            ZLibStream.next_out  = (Bytef*)Buffer;
+            ZLibStream.avail_out = sizeof(Buffer);
+            const int result = inflate(&ZLibStream, Z_NO_FLUSH);
+            if( (result != Z_OK) && (result != Z_STREAM_END) && (result != Z_BUF_ERROR) ) {
+               throw std::runtime_error("GZip decoding failed: " +
+                                        std::string((ZLibStream.msg != nullptr) ? ZLibStream.msg : "?"));
+            }
+            consumed  = (const char*)ZLibStream.next_in - (data + position);
+            produced  = sizeof(Buffer) - ZLibStream.avail_out;
+            streamEnd = (result == Z_STREAM_END);
+           }
+          break;
+         case CT_BZip2: {
+            BZip2Stream.next_in   = (char*)(data + position);
+            BZip2Stream.avail_in  = (unsigned int)std::min(size - position, (size_t)UINT32_MAX);
+            BZip2Stream.next_out  = Buffer;
+            BZip2Stream.avail_out = sizeof(Buffer);
+            const int result = BZ2_bzDecompress(&BZip2Stream);
+            if( (result != BZ_OK) && (result != BZ_STREAM_END) ) {
+               throw std::runtime_error("BZip2 decoding failed with error " + std::to_string(result));
+            }
+            consumed  = BZip2Stream.next_in - (data + position);
+            produced  = sizeof(Buffer) - BZip2Stream.avail_out;
+            streamEnd = (result == BZ_STREAM_END);
+           }
+          break;
+         case CT_ZSTD: {
+            ZSTD_inBuffer  input  = { data + position, size - position, 0 };
+            ZSTD_outBuffer output = { Buffer, sizeof(Buffer), 0 };
+            const size_t   result = ZSTD_decompressStream(ZSTDContext, &output, &input);
+            if(ZSTD_isError(result)) {
+               throw std::runtime_error(std::string("ZSTD decoding failed: ") +
+                                        ZSTD_getErrorName(result));
+            }
+            consumed  = input.pos;
+            produced  = output.pos;
+            streamEnd = (result == 0);
+           }
+          break;
+         default:
+            abort();
+      }
+
+      output.append(Buffer, produced);
+      position += consumed;
+      if(streamEnd) {
+         endStream();
+      }
+      else if( (consumed == 0) && (produced == 0) ) {
+         throw std::runtime_error("Decoder makes no progress");
+      }
+   }
+}
+
+
+// ###### Finish decoding ###################################################
+void StreamDecoder::finish()
+{
+   if(InStream) {
+      // The decoder may still have buffered output, which is not possible
+      // here: decode() only returns after all input has been consumed, and
+      // then the end of a stream has been reported.
+      throw std::runtime_error("Truncated input");
+   }
+}
+
+
+// ###### Configure the pool (before its first usage) #######################
+void CompressionPool::configure(const unsigned int threads,
+                                const size_t       memoryBudget)
+{
+   ConfiguredThreads      = threads;
+   ConfiguredMemoryBudget = memoryBudget;
+}
+
+
+// ###### Get the process-wide compression pool #############################
+CompressionPool& CompressionPool::getCompressionPool()
+{
+   static CompressionPool pool(
+      (ConfiguredThreads > 0) ? ConfiguredThreads : std::max(1U, std::thread::hardware_concurrency()),
+      ConfiguredMemoryBudget);
+   return pool;
+}
+
+
+// ###### Constructor #######################################################
+CompressionPool::CompressionPool(const unsigned int threads,
+                                 const size_t       memoryBudget)
+   : MemoryBudget(memoryBudget)
+{
+   BytesInFlight = 0;
+   StopRequested = false;
+   for(unsigned int i = 0; i < threads; i++) {
+      Threads.emplace_back(std::thread(&CompressionPool::run, this));
+   }
+   HPCT_LOG(debug) << "Compression pool: " << threads << " threads, "
+                   << (MemoryBudget / (1024 * 1024)) << " MiB memory budget";
+}
+
+
+// ###### Destructor ########################################################
+CompressionPool::~CompressionPool()
+{
+   {
+      std::lock_guard<std::mutex> lock(Mutex);
+      StopRequested = true;
+   }
+   NewJob.notify_all();
+   for(std::thread& thread : Threads) {
+      thread.join();
+   }
+}
+
+
+// ###### Submit job ########################################################
+void CompressionPool::submit(std::shared_ptr<CompressionJob>& job)
+{
+   job->InputSize = job->Input.size();
+   job->Budget    = job->InputSize;
+   job->CPUTime   = std::chrono::nanoseconds(0);
+   job->Done      = false;
+
+   std::unique_lock<std::mutex> lock(Mutex);
+   // ====== Wait until the job fits into the memory budget =================
+   // A single job is always accepted, in order to ensure progress.
+   Completed.wait(lock, [this, &job]() {
+      return (BytesInFlight == 0) || (BytesInFlight + job->Budget <= MemoryBudget);
+   });
+   BytesInFlight += job->Budget;
+   Queue.push_back(job);
+   lock.unlock();
+   NewJob.notify_one();
+}
+
+
+// ###### Check whether a job is done #######################################
+bool CompressionPool::isDone(const std::shared_ptr<CompressionJob>& job)
+{
+   std::lock_guard<std::mutex> lock(Mutex);
+   return job->Done;
+}
+
+
+// ###### Wait until a job is done ##########################################
+void CompressionPool::waitFor(const std::shared_ptr<CompressionJob>& job)
+{
+   std::unique_lock<std::mutex> lock(Mutex);
+   Completed.wait(lock, [&job]() { return job->Done; });
+}
+
+
+// ###### Get CPU time of the calling thread ###############################
+static std::chrono::nanoseconds getThreadCPUTime()
+{
+   struct timespec ts;
+   if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+      return std::chrono::nanoseconds(0);
+   }
+   return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+
+// ###### Compression thread ################################################
+void CompressionPool::run()
+{
+   std::unique_lock<std::mutex> lock(Mutex);
+   while(true) {
+      NewJob.wait(lock, [this]() { return (StopRequested) || (!Queue.empty()); });
+      if(Queue.empty()) {
+         break;   // Stop requested, and nothing left to do
+      }
+      std::shared_ptr<CompressionJob> job = Queue.front();
+      Queue.pop_front();
+
+      lock.unlock();
+      const std::chrono::nanoseconds cpuTimeStart = getThreadCPUTime();
+      try {
+         if(job->Decompress) {
+            decompress(*job);
+         }
+         else {
+            compress(*job);
+         }
+      }
+      catch(...) {
+         job->Error = std::current_exception();
+      }
+      job->CPUTime = getThreadCPUTime() - cpuTimeStart;
+      std::string().swap(job->Input);
+      lock.lock();
+
+      assert(BytesInFlight >= job->Budget);
+      BytesInFlight -= job->Budget;
+      job->Done      = true;
+      Completed.notify_all();
+   }
+}
+
+
+// ###### Compress a block ##################################################
+void CompressionPool::compress(CompressionJob& job)
+{
+   const int level = getCompressionLevel(job.Compressor, job.Level);
+   switch(job.Compressor) {
+      case CT_XZ: {
+         // The dictionary does not need to be larger than the block
+         lzma_options_lzma options;
+         if(lzma_lzma_preset(&options, (uint32_t)level)) {
+            throw std::runtime_error("Unable to configure XZ compression");
+         }
+         options.dict_size = std::max((uint32_t)LZMA_DICT_SIZE_MIN,
+                                      std::min(options.dict_size, (uint32_t)job.Input.size()));
+         lzma_filter filters[2] = {
+            { LZMA_FILTER_LZMA2, &options     },
+            { LZMA_VLI_UNKNOWN,  nullptr      }
+         };
+         job.Output.resize(lzma_stream_buffer_bound(job.Input.size()));
+         size_t outputSize = 0;
+         const lzma_ret result =
+            lzma_stream_buffer_encode(filters, LZMA_CHECK_CRC64, nullptr,
+                                      (const uint8_t*)job.Input.data(), job.Input.size(),
+                                      (uint8_t*)job.Output.data(), &outputSize, job.Output.size());
+         if(result != LZMA_OK) {
+            throw std::runtime_error("XZ compression failed with error " + std::to_string(result));
+         }
+         job.Output.resize(outputSize);
+        }
+       break;
+      case CT_ZSTD: {
+         // One context per thread, to be reused for all blocks
+         thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)>
+            context(ZSTD_createCCtx(), &ZSTD_freeCCtx);
+         if(context == nullptr) {
+            throw std::bad_alloc();
+         }
+         job.Output.resize(ZSTD_compressBound(job.Input.size()));
+         const size_t result = (job.Dictionary != nullptr) ?
+            ZSTD_compress_usingCDict(context.get(),
+                                     job.Output.data(), job.Output.size(),
+                                     job.Input.data(), job.Input.size(),
+                                     job.Dictionary->compressionDictionary(level)) :
+            ZSTD_compressCCtx(context.get(),
+                              job.Output.data(), job.Output.size(),
+                              job.Input.data(), job.Input.size(),
+                              level);
+         if(ZSTD_isError(result)) {
+            throw std::runtime_error(std::string("ZSTD compression failed: ") +
+                                     ZSTD_getErrorName(result));
+         }
+         job.Output.resize(result);
+        }
+       break;
+      case CT_BZip2: {
+         unsigned int outputSize = job.Input.size() + (job.Input.size() / 100) + 600;
+         job.Output.resize(outputSize);
+         const int result =
+            BZ2_bzBuffToBuffCompress(job.Output.data(), &outputSize,
+                                     job.Input.data(), job.Input.size(),
+                                     level, 0, 0);
+         if(result != BZ_OK) {
+            throw std::runtime_error("BZip2 compression failed with error " + std::to_string(result));
+         }
+         job.Output.resize(outputSize);
+        }
+       break;
+      case CT_GZip: {
+         // ------ Raw deflate ----------------------------------------------
+         z_stream stream;
+         memset(&stream, 0, sizeof(stream));
+         if(deflateInit2(&stream, level, Z_DEFLATED,
+                         -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("Unable to configure GZip compression");
+         }
+         const size_t headerSize = 20;
+         job.Output.resize(headerSize + deflateBound(&stream, job.Input.size()) + 8);
+         stream.next_in   = (Bytef*)job.Input.data();
+         stream.avail_in  = job.Input.size();
+         stream.next_out  = (Bytef*)job.Output.data() + headerSize;
+         stream.avail_out = job.Output.size() - headerSize - 8;
+         const int result = deflate(&stream, Z_FINISH);
+         const size_t deflatedSize = stream.total_out;
+         deflateEnd(&stream);
+         if(result != Z_STREAM_END) {
+            throw std::runtime_error("GZip compression failed with error " + std::to_string(result));
+         }
+
+         // ------ GZip member with size in extra field "HP" ----------------
+         const uint32_t memberSize = headerSize + deflatedSize + 8;
+         const uint32_t crc        = crc32(0, (const Bytef*)job.Input.data(), job.Input.size());
+         const uint32_t inputSize  = job.Input.size();
+         uint8_t* header = (uint8_t*)job.Output.data();
+         const uint8_t fixedHeader[16] = {
+            0x1f, 0x8b, 0x08, 0x04,   // ID1, ID2, CM = deflate, FLG = FEXTRA
+            0x00, 0x00, 0x00, 0x00,   // MTIME = none
+            0x00, 0x03,               // XFL, OS = Unix
+            0x08, 0x00,               // XLEN = 8
+            'H',  'P',  0x04, 0x00    // SI1, SI2, LEN = 4
+         };
+         memcpy(header, fixedHeader, sizeof(fixedHeader));
+         uint8_t* trailer = header + headerSize + deflatedSize;
+         for(unsigned int i = 0; i < 4; i++) {
+            header[16 + i]  = (memberSize >> (8 * i)) & 0xff;
+            trailer[i]      = (crc        >> (8 * i)) & 0xff;
+            trailer[4 + i]  = (inputSize  >> (8 * i)) & 0xff;
+         }
+         job.Output.resize(memberSize);
+        }
+       break;
+      default:
+         throw std::runtime_error("Unsupported compressor for compression pool");
+       break;
+   }
+}
+
+
+// ###### Decompress a unit #################################################
+void CompressionPool::decompress(CompressionJob& job)
+{
+   StreamDecoder decoder(job.Compressor);
+   decoder.decode(job.Input.data(), job.Input.size(), job.Output);
+   decoder.finish();
+}
+
+
+
+// ###### Constructor #######################################################
+PooledCompressor::PooledCompressor(const CompressorType                   compressor,
+                                   const ZSTDDictionary*                  dictionary,
+                                   const int                              level,
+                                   std::shared_ptr<CompressionStatistics> statistics,
+                                   const size_t                           blockSize)
+   : State(std::make_shared<CompressorState>(compressor, dictionary, level,
+                                             statistics, blockSize))
+{
+}
+
+
+// ###### Constructor #######################################################
+PooledCompressor::CompressorState::CompressorState(const CompressorType                   compressor,
+                                                   const ZSTDDictionary*                  dictionary,
+                                                   const int                              level,
+                                                   std::shared_ptr<CompressionStatistics> statistics,
+                                                   const size_t                           blockSize)
+   : Compressor(compressor),
+     Dictionary(dictionary),
+     Level(level),
+     Statistics(statistics),
+     BlockSize(std::max((size_t)4096, blockSize))
+{
+   Submitted = false;
+}
+
+
+// ###### Submit the current block to the compression pool ##################
+void PooledCompressor::CompressorState::submitBlock()
+{
+   std::shared_ptr<CompressionJob> job = std::make_shared<CompressionJob>();
+   job->Compressor = Compressor;
+   job->Decompress = false;
+   job->Level      = Level;
+   job->Dictionary = Dictionary;
+   job->Input.swap(Block);
+   Block.reserve(BlockSize);
+
+   CompressionPool::getCompressionPool().submit(job);
+   Pending.push_back(job);
+   Submitted = true;
+}
+
+
+
+// ###### Constructor #######################################################
+ParallelDecompressor::ParallelDecompressor(const CompressorType compressor)
+   : State(std::make_shared<DecompressorState>(compressor))
+{
+}
+
+
+// ###### Constructor #######################################################
+ParallelDecompressor::DecompressorState::DecompressorState(const CompressorType compressor)
+   : Compressor(compressor),
+     MaxPending(2 * CompressionPool::getCompressionPool().threads()),
+     ReadBuffer(1024 * 1024)
+{
+   if( (Compressor != CT_ZSTD) && (Compressor != CT_GZip) && (Compressor != CT_BZip2) ) {
+      throw std::runtime_error("Unsupported compressor for parallel decompression");
+   }
+   InputOffset           = 0;
+   InputPosition         = 0;
+   EndOfInput            = false;
+   OutputPosition        = 0;
+   SkipOutput            = 0;
+   BZip2HeaderChecked    = false;
+   BZip2StreamStart      = 0;
+   BZip2BitPosition      = 0;
+   BZip2BlockStart       = 0;
+   BZip2CombinedCRC      = 0;
+   DeliveredStream       = UINT64_MAX;
+   DeliveredStreamOutput = 0;
+}
+
+
+// ###### Destructor ########################################################
+ParallelDecompressor::DecompressorState::~DecompressorState()
+{
+}
+
+
+// ###### Add input data ####################################################
+void ParallelDecompressor::DecompressorState::addInput(const char*  data,
+                                                       const size_t size,
+                                                       const bool   endOfInput)
+{
+   // ====== Remove input that is not needed any more =======================
+   size_t unused = InputPosition;
+   if( (Compressor == CT_BZip2) && (!Sequential) ) {
+      // The input of all streams with pending blocks is kept, for a
+      // fallback to sequential decoding (see fallBackToSequential()).
+      const uint64_t keep = (Pending.empty()) ? bzip2StreamStart() : PendingStreamStart.front();
+      unused = (size_t)(keep - InputOffset);
+      if(BZip2HeaderChecked) {
+         BZip2BlockStart  -= 8 * (uint64_t)unused;
+         BZip2BitPosition -= 8 * (uint64_t)unused;
+      }
+   }
+   if(unused > 0) {
+      Input.erase(0, unused);
+      InputOffset  += unused;
+      InputPosition = (InputPosition > unused) ? (InputPosition - unused) : 0;
+   }
+
+   Input.append(data, size);
+   EndOfInput = endOfInput;
+}
+
+
+// ###### Obtain next decoded data ##########################################
+ParallelDecompressor::DecoderStep ParallelDecompressor::DecompressorState::step()
+{
+   CompressionPool& pool = CompressionPool::getCompressionPool();
+
+   // ====== Submit further units ===========================================
+   bool needInput = false;
+   while( (!Sequential) && (Pending.size() < MaxPending) ) {
+      const UnitResult result = findUnit();
+      if(result == UR_NeedInput) {
+         needInput = true;
+         break;
+      }
+      else if( (result == UR_Sequential) && (!Sequential) ) {
+         Sequential = std::unique_ptr<StreamDecoder>(new StreamDecoder(Compressor));
+      }
+   }
+
+   // ====== Deliver the oldest unit ========================================
+   if(!Pending.empty()) {
+      std::shared_ptr<CompressionJob> job = Pending.front();
+      if( (needInput) && (!EndOfInput) && (!pool.isDone(job)) ) {
+         // Read further input while the pool is busy.
+         return DS_NeedInput;
+      }
+      pool.waitFor(job);
+      if(job->Error) {
+         if(Compressor == CT_BZip2) {
+            // Probably a block magic within compressed data, i.e. not
+            // a block boundary. A real decoding error is reported by the
+            // sequential decoder.
+            fallBackToSequential();
+            return DS_Output;
+         }
+         std::rethrow_exception(job->Error);
+      }
+      if(PendingStreamStart.front() != DeliveredStream) {
+         DeliveredStream       = PendingStreamStart.front();
+         DeliveredStreamOutput = 0;
+      }
+      DeliveredStreamOutput += job->Output.size();
+      Pending.pop_front();
+      PendingStreamStart.pop_front();
+      Output.swap(job->Output);
+      OutputPosition = 0;
+      return DS_Output;
+   }
+
+   // ====== Sequential decoding of the remaining input =====================
+   if(Sequential) {
+      if(InputPosition < Input.size()) {
+         Output.clear();
+         OutputPosition = 0;
+         Sequential->decode(Input.data() + InputPosition,
+                            Input.size() - InputPosition, Output);
+         InputPosition = Input.size();
+         if(SkipOutput > 0) {
+            // Output that has already been delivered by decoded blocks
+            OutputPosition = std::min(SkipOutput, Output.size());
+            SkipOutput    -= OutputPosition;
+         }
+         return DS_Output;
+      }
+      if(!EndOfInput) {
+         return DS_NeedInput;
+      }
+      Sequential->finish();
+      return DS_End;
+   }
+
+   if(!EndOfInput) {
+      return DS_NeedInput;
+   }
+   checkEndOfInput();
+   return DS_End;
+}
+
+
+// ###### Find next independently decodable unit ############################
+ParallelDecompressor::UnitResult ParallelDecompressor::DecompressorState::findUnit()
+{
+   switch(Compressor) {
+      case CT_ZSTD:
+         return findZSTDUnit();
+      case CT_GZip:
+         return findGZipUnit();
+      case CT_BZip2:
+         return findBZip2Unit();
+      default:
+       break;
+   }
+   return UR_Sequential;
+}
+
+
+// ###### Find next ZSTD frame ##############################################
+ParallelDecompressor::UnitResult ParallelDecompressor::DecompressorState::findZSTDUnit()
+{
+   const size_t available = Input.size() - InputPosition;
+   if(available == 0) {
+      return UR_NeedInput;
+   }
+
+   const size_t frameSize = ZSTD_findFrameCompressedSize(Input.data() + InputPosition, available);
+   if(ZSTD_isError(frameSize)) {
+      // The frame is incomplete (or invalid). Larger frames, e.g. from
+      // streaming compression, are decoded sequentially.
+      if( (!EndOfInput) && (available < MaxUnitSize) ) {
+         return UR_NeedInput;
+      }
+      return UR_Sequential;
+   }
+   submitUnit(Input.substr(InputPosition, frameSize));
+   InputPosition += frameSize;
+   return UR_Submitted;
+}
+
+
+// ###### Find next GZip member with size field #############################
+ParallelDecompressor::UnitResult ParallelDecompressor::DecompressorState::findGZipUnit()
+{
+   const size_t available = Input.size() - InputPosition;
+   if(available == 0) {
+      return UR_NeedInput;
+   }
+   const uint8_t* header = (const uint8_t*)Input.data() + InputPosition;
+
+   // ====== Fixed header and extra field length ============================
+   if(available < 12) {
+      return (EndOfInput) ? UR_Sequential : UR_NeedInput;
+   }
+   if( (header[0] != 0x1f) || (header[1] != 0x8b) || (header[2] != 0x08) ||
+       ((header[3] & 0x04) == 0) ) {
+      return UR_Sequential;   // Not a member with extra field
+   }
+   const size_t extraLength = header[10] | ((size_t)header[11] << 8);
+   if(available < 12 + extraLength) {
+      return (EndOfInput) ? UR_Sequential : UR_NeedInput;
+   }
+
+   // ====== Look for a member size subfield ================================
+   // "HP": 32-bit member size, written by PooledCompressor.
+   // "BC": 16-bit member size - 1, written by BGZF (bgzip).
+   size_t memberSize = 0;
+   size_t position   = 12;
+   while(position + 4 <= 12 + extraLength) {
+      const size_t fieldLength = header[position + 2] | ((size_t)header[position + 3] << 8);
+      if(position + 4 + fieldLength > 12 + extraLength) {
+         break;
+      }
+      const uint8_t* field = &header[position + 4];
+      if( (header[position] == 'H') && (header[position + 1] == 'P') && (fieldLength == 4) ) {
+         memberSize = field[0] | ((size_t)field[1] << 8) |
+                      ((size_t)field[2] << 16) | ((size_t)field[3] << 24);
+         break;
+      }
+      else if( (header[position] == 'B') && (header[position + 1] == 'C') && (fieldLength == 2) ) {
+         memberSize = (field[0] | ((size_t)field[1] << 8)) + 1;
+         break;
+      }
+      position += 4 + fieldLength;
+   }
+   if( (memberSize < 12 + extraLength + 8) || (memberSize > MaxUnitSize) ) {
+      return UR_Sequential;
+   }
+
+   // ====== Submit the member ==============================================
+   if(available < memberSize) {
+      return (EndOfInput) ? UR_Sequential : UR_NeedInput;
+   }
+   submitUnit(Input.substr(InputPosition, memberSize));
+   InputPosition += memberSize;
+   return UR_Submitted;
+}
+
+
+// ###### Find next BZip2 block #############################################
+// Blocks are not byte-aligned. They are found by their 48-bit block magic.
+// The end of a stream is marked by the 48-bit end-of-stream magic, followed
+// by the 32-bit combined CRC and padding to a full byte. A random match of
+// a magic within compressed data is unlikely, but possible. It results in
+// a decoding error of the affected block, or a combined CRC mismatch. Then,
+// the stream is decoded sequentially. For this fallback, the input of the
+// stream has to be kept. A stream larger than MaxBZip2StreamInput is
+// therefore decoded sequentially, from the start of its input on.
+ParallelDecompressor::UnitResult ParallelDecompressor::DecompressorState::findBZip2Unit()
+{
+   // ====== Check stream header ============================================
+   if(!BZip2HeaderChecked) {
+      const size_t available = Input.size() - InputPosition;
+      if(available == 0) {
+         return UR_NeedInput;
+      }
+      if(available < 14) {
+         // Enough for header + magic + CRC of an empty stream:
+         return (EndOfInput) ? UR_Sequential : UR_NeedInput;
+      }
+      const char* header = Input.data() + InputPosition;
+      if( (header[0] != 'B') || (header[1] != 'Z') || (header[2] != 'h') ||
+          (header[3] < '1') || (header[3] > '9') ) {
+         return UR_Sequential;
+      }
+      const uint64_t magicStart = 8 * (uint64_t)(InputPosition + 4);
+      const uint64_t magic      = readBits(magicStart, 48);
+      if(magic == BZip2EndOfStreamMagic) {
+         // Empty stream
+         if(readBits(magicStart + 48, 32) != 0) {
+            throw std::runtime_error("BZip2 stream CRC error");
+         }
+         InputPosition += 14;
+         return findBZip2Unit();
+      }
+      else if(magic != BZip2BlockMagic) {
+         return UR_Sequential;
+      }
+      BZip2HeaderChecked = true;
+      BZip2StreamStart   = InputOffset + InputPosition;
+      BZip2BlockStart    = magicStart;
+      BZip2BitPosition   = magicStart + 48;
+      BZip2CombinedCRC   = 0;
+   }
+
+   // ====== Limit the input kept for a fallback ============================
+   const uint64_t keep = (Pending.empty()) ? bzip2StreamStart() : PendingStreamStart.front();
+   if(InputOffset + Input.size() - keep > MaxBZip2StreamInput) {
+      fallBackToSequential();
+      return UR_Sequential;
+   }
+
+   // ====== Look for the next magic ========================================
+   // Candidate positions are checked in a 64-bit window over 8 input bytes.
+   const uint8_t* input  = (const uint8_t*)Input.data();
+   const uint64_t endBit = 8 * (uint64_t)Input.size();
+   uint64_t       window = 0;
+   size_t         loaded = SIZE_MAX;   // First byte in window
+   while(BZip2BitPosition + 48 <= endBit) {
+      const size_t byte = BZip2BitPosition / 8;
+      uint64_t     magic;
+      if(byte + 8 <= Input.size()) {
+         if(byte != loaded) {
+            if( (loaded != SIZE_MAX) && (byte == loaded + 1) ) {
+               window = (window << 8) | input[byte + 7];
+            }
+            else {
+               window = 0;
+               for(size_t i = byte; i < byte + 8; i++) {
+                  window = (window << 8) | input[i];
+               }
+            }
+            loaded = byte;
+         }
+         magic = (window >> (16 - (BZip2BitPosition % 8))) & 0xffffffffffffULL;
+      }
+      else {
+         magic = readBits(BZip2BitPosition, 48);
+      }
+
+      if(magic == BZip2BlockMagic) {
+         submitBZip2Unit(BZip2BlockStart, BZip2BitPosition);
+         BZip2BlockStart   = BZip2BitPosition;
+         BZip2BitPosition += 48;
+         return UR_Submitted;
+      }
+      else if(magic == BZip2EndOfStreamMagic) {
+         const size_t streamEnd = (BZip2BitPosition + 48 + 32 + 7) / 8;
+         if(streamEnd > Input.size()) {
+            return UR_NeedInput;
+         }
+         submitBZip2Unit(BZip2BlockStart, BZip2BitPosition);
+         if(readBits(BZip2BitPosition + 48, 32) != BZip2CombinedCRC) {
+            fallBackToSequential();
+            return UR_Sequential;
+         }
+         BZip2HeaderChecked = false;
+         InputPosition      = streamEnd;
+         return UR_Submitted;
+      }
+      BZip2BitPosition++;
+   }
+   return UR_NeedInput;
+}
+
+
+// ###### Read bits (MSB first) from the input ##############################
+uint64_t ParallelDecompressor::DecompressorState::readBits(const uint64_t     position,
+                                                           const unsigned int bits) const
+{
+   uint64_t value = 0;
+   for(uint64_t i = position; i < position + bits; i++) {
+      value = (value << 1) | ((Input[i >> 3] >> (7 - (i & 7))) & 1);
+   }
+   return value;
+}
+
+
+// ###### Submit unit to the compression pool ###############################
+void ParallelDecompressor::DecompressorState::submitUnit(std::string&& unit)
+{
+   std::shared_ptr<CompressionJob> job = std::make_shared<CompressionJob>();
+   job->Compressor = Compressor;
+   job->Decompress = true;
+   job->Level      = 0;
+   job->Dictionary = nullptr;
+   job->Input      = std::move(unit);
+
+   CompressionPool::getCompressionPool().submit(job);
+   Pending.push_back(job);
+   PendingStreamStart.push_back(bzip2StreamStart());
+}
+
+
+// ###### Submit BZip2 block as stream of its own ###########################
+// The block bits are wrapped into a single-block stream: header, block,
+// end-of-stream magic and the combined CRC, which is the block's CRC.
+void ParallelDecompressor::DecompressorState::submitBZip2Unit(const uint64_t startBit,
+                                                              const uint64_t endBit)
+{
+   const uint64_t     bits      = endBit - startBit;
+   const size_t       fullBytes = bits / 8;
+   const size_t       first     = startBit / 8;
+   const unsigned int offset    = startBit % 8;
+   const uint8_t*     input     = (const uint8_t*)Input.data();
+   const uint32_t     blockCRC  = readBits(startBit + 48, 32);
+   BZip2CombinedCRC = ((BZip2CombinedCRC << 1) | (BZip2CombinedCRC >> 31)) ^ blockCRC;
+
+   std::string unit;
+   unit.reserve(4 + fullBytes + 12);
+   unit.append("BZh9", 4);
+   if(offset == 0) {
+      unit.append(Input.data() + first, fullBytes);
+   }
+   else {
+      for(size_t i = 0; i < fullBytes; i++) {
+         unit.push_back((char)((input[first + i] << offset) |
+                               (input[first + i + 1] >> (8 - offset))));
+      }
+   }
+
+   // ====== Remaining bits, end-of-stream magic and CRC ====================
+   const unsigned int remaining = bits % 8;
+   unsigned int       used      = 0;
+   auto putBits = [&unit, &used](const uint64_t value, const unsigned int count) {
+      for(int i = (int)count - 1; i >= 0; i--) {
+         if(used == 0) {
+            unit.push_back(0);
+         }
+         unit.back() |= (char)(((value >> i) & 1) << (7 - used));
+         used = (used + 1) % 8;
+      }
+   };
+   putBits(readBits(startBit + 8 * fullBytes, remaining), remaining);
+   putBits(BZip2EndOfStreamMagic, 48);
+   putBits(blockCRC, 32);
+
+   submitUnit(std::move(unit));
+}
+
+
+// ###### Get offset of the current BZip2 stream's header ###################
+uint64_t ParallelDecompressor::DecompressorState::bzip2StreamStart() const
+{
+   return (BZip2HeaderChecked) ? BZip2StreamStart : (InputOffset + InputPosition);
+}
+
+
+// ###### Decode BZip2 input sequentially, from the oldest pending stream ###
+// Pending blocks are dropped. Output of the stream that has already been
+// delivered is skipped.
+void ParallelDecompressor::DecompressorState::fallBackToSequential()
+{
+   const uint64_t streamStart = (Pending.empty()) ? bzip2StreamStart() : PendingStreamStart.front();
+   SkipOutput = (streamStart == DeliveredStream) ? DeliveredStreamOutput : 0;
+   Pending.clear();
+   PendingStreamStart.clear();
+   Output.clear();
+   OutputPosition     = 0;
+   InputPosition      = (size_t)(streamStart - InputOffset);
+   BZip2HeaderChecked = false;
+   Sequential = std::unique_ptr<StreamDecoder>(new StreamDecoder(Compressor));
+}
+
+
+// ###### Check for incomplete input at the end #############################
+void ParallelDecompressor::DecompressorState::checkEndOfInput()
+{
+   if( ((Compressor == CT_BZip2) && (BZip2HeaderChecked)) ||
+       (InputPosition < Input.size()) ) {
+      throw std::runtime_error("Truncated input");
+   }
+}
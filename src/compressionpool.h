@@ -0,0 +1,343 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#ifndef COMPRESSIONPOOL_H
+#define COMPRESSIONPOOL_H
+
+#include "compressortype.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/iostreams/concepts.hpp>
+#include <boost/iostreams/operations.hpp>
+
+
+class StreamDecoder;
+class ZSTDDictionary;
+
+
+// ==========================================================================
+// Process-wide compression pool.
+//
+// Output streams split their data into fixed-size blocks. Each block is
+// compressed independently by one of the pool threads, as a complete .xz,
+// BZip2 or GZip stream, or ZSTD frame. The concatenation of these blocks is
+// a valid file of the respective format. GZip members carry their size in
+// an extra header field, so that a reader can find them without decoding.
+//
+// Input streams use the same threads to decode independent units in
+// parallel: ZSTD frames, GZip members with size field (also BGZF), and
+// BZip2 blocks (found by their block magic). Input that cannot be split
+// is decoded sequentially.
+//
+// The number of threads and the memory used by queued blocks are limited
+// for the whole process, regardless of the number of streams.
+// A block's budget is returned as soon as it has been processed, i.e.
+// a stream that is waiting to write or read its output does not hold any
+// budget.
+// ==========================================================================
+
+struct CompressionJob
+{
+   CompressorType           Compressor;
+   bool                     Decompress;
+   int                      Level;     // 0 = compressor's default level
+   const ZSTDDictionary*    Dictionary;
+   std::string              Input;
+   std::string              Output;
+   size_t                   InputSize;
+   size_t                   Budget;
+   std::chrono::nanoseconds CPUTime;   // CPU time of the pool thread
+   bool                     Done;
+   std::exception_ptr       Error;
+};
+
+
+// Compression statistics of a stream, e.g. to adapt the compression level
+struct CompressionStatistics
+{
+   size_t                   Blocks;
+   size_t                   InputBytes;
+   size_t                   OutputBytes;
+   std::chrono::nanoseconds CPUTime;
+};
+
+
+class CompressionPool
+{
+   public:
+   static const size_t DefaultBlockSize    = 1024 * 1024;
+   static const size_t DefaultMemoryBudget = 256 * 1024 * 1024;
+
+   static void configure(const unsigned int threads,
+                         const size_t       memoryBudget = DefaultMemoryBudget);
+   static CompressionPool& getCompressionPool();
+
+   void submit(std::shared_ptr<CompressionJob>& job);
+   bool isDone(const std::shared_ptr<CompressionJob>& job);
+   void waitFor(const std::shared_ptr<CompressionJob>& job);
+
+   inline unsigned int threads() const {
+      return Threads.size();
+   }
+   inline size_t memoryBudget() const {
+      return MemoryBudget;
+   }
+
+   private:
+   CompressionPool(const unsigned int threads,
+                   const size_t       memoryBudget);
+   ~CompressionPool();
+
+   void run();
+   static void compress(CompressionJob& job);
+   static void decompress(CompressionJob& job);
+
+   static unsigned int                         ConfiguredThreads;
+   static size_t                               ConfiguredMemoryBudget;
+
+   const size_t                                MemoryBudget;
+   std::mutex                                  Mutex;
+   std::condition_variable                     NewJob;
+   std::condition_variable                     Completed;
+   std::deque<std::shared_ptr<CompressionJob>> Queue;
+   std::vector<std::thread>                    Threads;
+   size_t                                      BytesInFlight;
+   bool                                        StopRequested;
+};
+
+
+// ###### Compressor using the compression pool #############################
+// NOTE: Boost IOStreams copies filters, i.e. the state has to be shared.
+class PooledCompressor : public boost::iostreams::multichar_output_filter
+{
+   public:
+   PooledCompressor(const CompressorType                   compressor,
+                    const ZSTDDictionary*                  dictionary = nullptr,
+                    const int                              level      = 0,
+                    std::shared_ptr<CompressionStatistics> statistics = nullptr,
+                    const size_t                           blockSize  = CompressionPool::DefaultBlockSize);
+
+   template<typename Sink> std::streamsize write(Sink&           sink,
+                                                 const char*     data,
+                                                 std::streamsize size) {
+      std::streamsize position = 0;
+      while(position < size) {
+         const size_t chunk = std::min((size_t)(size - position),
+                                       State->BlockSize - State->Block.size());
+         State->Block.append(data + position, chunk);
+         position += (std::streamsize)chunk;
+         if(State->Block.size() >= State->BlockSize) {
+            State->submitBlock();
+         }
+      }
+      writeCompletedBlocks(sink, false);
+      return size;
+   }
+
+   template<typename Sink> void close(Sink& sink) {
+      // An empty stream still needs one (empty) block, to be a valid file
+      if( (!State->Block.empty()) || (!State->Submitted) ) {
+         State->submitBlock();
+      }
+      writeCompletedBlocks(sink, true);
+      State->Submitted = false;
+   }
+
+   private:
+   struct CompressorState {
+      CompressorState(const CompressorType                   compressor,
+                      const ZSTDDictionary*                  dictionary,
+                      const int                              level,
+                      std::shared_ptr<CompressionStatistics> statistics,
+                      const size_t                           blockSize);
+      void submitBlock();
+
+      const CompressorType                        Compressor;
+      const ZSTDDictionary*                       Dictionary;
+      const int                                   Level;
+      std::shared_ptr<CompressionStatistics>      Statistics;
+      const size_t                                BlockSize;
+      std::string                                 Block;
+      std::deque<std::shared_ptr<CompressionJob>> Pending;
+      bool                                        Submitted;
+   };
+
+   // Blocks are written in their order, i.e. a completed block has to wait
+   // for all blocks before it.
+   template<typename Sink> void writeCompletedBlocks(Sink& sink, const bool wait) {
+      CompressionPool& pool = CompressionPool::getCompressionPool();
+      while(!State->Pending.empty()) {
+         std::shared_ptr<CompressionJob> job = State->Pending.front();
+         if(!pool.isDone(job)) {
+            if(!wait) {
+               break;
+            }
+            pool.waitFor(job);
+         }
+         State->Pending.pop_front();
+         if(job->Error) {
+            std::rethrow_exception(job->Error);
+         }
+         if(State->Statistics) {
+            State->Statistics->Blocks++;
+            State->Statistics->InputBytes  += job->InputSize;
+            State->Statistics->OutputBytes += job->Output.size();
+            State->Statistics->CPUTime     += job->CPUTime;
+         }
+         size_t written = 0;
+         while(written < job->Output.size()) {
+            const std::streamsize result =
+               boost::iostreams::write(sink, job->Output.data() + written,
+                                       (std::streamsize)(job->Output.size() - written));
+            if(result <= 0) {
+               throw std::runtime_error("Failed to write compressed output");
+            }
+            written += (size_t)result;
+         }
+      }
+   }
+
+   std::shared_ptr<CompressorState> State;
+};
+
+
+// ###### Decompressor using the compression pool ###########################
+// NOTE: Boost IOStreams copies filters, i.e. the state has to be shared.
+class ParallelDecompressor : public boost::iostreams::multichar_input_filter
+{
+   public:
+   ParallelDecompressor(const CompressorType compressor);
+
+   template<typename Source> std::streamsize read(Source&         source,
+                                                  char*           data,
+                                                  std::streamsize size) {
+      std::streamsize produced = 0;
+      while(produced < size) {
+         // ====== Deliver decoded data, in order ===========================
+         if(State->OutputPosition < State->Output.size()) {
+            const size_t chunk = std::min((size_t)(size - produced),
+                                          State->Output.size() - State->OutputPosition);
+            memcpy(data + produced, State->Output.data() + State->OutputPosition, chunk);
+            State->OutputPosition += chunk;
+            produced              += (std::streamsize)chunk;
+            continue;
+         }
+
+         // ====== Obtain next decoded data =================================
+         const DecoderStep step = State->step();
+         if(step == DS_NeedInput) {
+            const std::streamsize result =
+               boost::iostreams::read(source, State->ReadBuffer.data(),
+                                      (std::streamsize)State->ReadBuffer.size());
+            State->addInput(State->ReadBuffer.data(),
+                            (result > 0) ? (size_t)result : 0, (result < 0));
+         }
+         else if(step == DS_End) {
+            break;
+         }
+      }
+      return (produced > 0) ? produced : -1;
+   }
+
+   private:
+   static const size_t   MaxUnitSize           = 16 * 1024 * 1024;
+   static const size_t   MaxBZip2StreamInput   = 4 * MaxUnitSize;
+   static const uint64_t BZip2BlockMagic       = 0x314159265359ULL;
+   static const uint64_t BZip2EndOfStreamMagic = 0x177245385090ULL;
+
+   enum DecoderStep {
+      DS_Output    = 0,   // Next decoded data is available
+      DS_NeedInput = 1,   // More input is needed
+      DS_End       = 2    // End of input
+   };
+   enum UnitResult {
+      UR_Submitted  = 0,   // Unit has been submitted to the pool
+      UR_NeedInput  = 1,   // More input is needed to find the next unit
+      UR_Sequential = 2    // Input cannot be split -> decode sequentially
+   };
+
+   struct DecompressorState {
+      DecompressorState(const CompressorType compressor);
+      ~DecompressorState();
+
+      DecoderStep step();
+      void        addInput(const char* data, const size_t size, const bool endOfInput);
+      UnitResult  findUnit();
+      UnitResult  findZSTDUnit();
+      UnitResult  findGZipUnit();
+      UnitResult  findBZip2Unit();
+      void        submitUnit(std::string&& unit);
+      void        submitBZip2Unit(const uint64_t startBit, const uint64_t endBit);
+      uint64_t    readBits(const uint64_t position, const unsigned int bits) const;
+      uint64_t    bzip2StreamStart() const;
+      void        fallBackToSequential();
+      void        checkEndOfInput();
+
+      const CompressorType                        Compressor;
+      const size_t                                MaxPending;
+      std::vector<char>                           ReadBuffer;
+      std::string                                 Input;
+      uint64_t                                    InputOffset;     // Offset of Input[0]
+      size_t                                      InputPosition;
+      bool                                        EndOfInput;
+      std::string                                 Output;
+      size_t                                      OutputPosition;
+      std::deque<std::shared_ptr<CompressionJob>> Pending;
+      std::deque<uint64_t>                        PendingStreamStart;
+      std::unique_ptr<StreamDecoder>              Sequential;
+      size_t                                      SkipOutput;
+
+      // BZip2 block scanner:
+      bool                                        BZip2HeaderChecked;
+      uint64_t                                    BZip2StreamStart;   // Offset of header
+      uint64_t                                    DeliveredStream;
+      size_t                                      DeliveredStreamOutput;
+      uint64_t                                    BZip2BitPosition;
+      uint64_t                                    BZip2BlockStart;
+      uint32_t                                    BZip2CombinedCRC;
+   };
+
+   std::shared_ptr<DecompressorState> State;
+};
+
+#endif
@@ -27,6 +27,7 @@
 //
 // Contact: dreibh@simula.no
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 
 #include "compressortype.h"
@@ -36,19 +37,36 @@ struct CompressorTableEntry
    CompressorType     Type;
    const std::string  Name;
    const char*        Extension;
+   int                MinLevel;
+   int                DefaultLevel;
+   int                MaxLevel;
 };
 
 static const CompressorTableEntry CompressorTable[] = {
-   { CT_None,    "None",        "",     },
-   { CT_XZ,      "XZ",          ".xz"   },
-   { CT_BZip2,   "BZip2",       ".bz2"  },
-   { CT_GZip,    "GZip",        ".gz"   },
-   { CT_ZSTD,    "ZSTD",        ".zst"  },
-   { CT_ZLIB,    "ZLIB",        ".zz"   },
-   { CT_Invalid, std::string(), nullptr }
+   { CT_None,    "None",        "",      0, 0,  0 },
+   { CT_XZ,      "XZ",          ".xz",   1, 2,  9 },
+   { CT_BZip2,   "BZip2",       ".bz2",  1, 9,  9 },
+   { CT_GZip,    "GZip",        ".gz",   1, 6,  9 },
+   { CT_ZSTD,    "ZSTD",        ".zst",  1, 3, 19 },
+   { CT_ZLIB,    "ZLIB",        ".zz",   1, 6,  9 },
+   { CT_Invalid, std::string(), nullptr, 0, 0,  0 }
 };
 
 
+// ###### Find table entry for compressor ###################################
+static const CompressorTableEntry* findCompressor(const CompressorType type)
+{
+   unsigned int i = 0;
+   while(CompressorTable[i].Type != CT_Invalid) {
+      if(CompressorTable[i].Type == type) {
+         return &CompressorTable[i];
+      }
+      i++;
+   }
+   return nullptr;
+}
+
+
 // ###### Obtain compressor from file name extension ########################
 CompressorType getCompressorTypeFromName(const std::string& name)
 {
@@ -88,12 +106,42 @@ CompressorType obtainCompressorFromExtension(const std::filesystem::path& fileNa
 // ###### Get file extension for compressor #################################
 const char* getExtensionForCompressor(const CompressorType type)
 {
-   unsigned int i = 0;
-   while(CompressorTable[i].Type != CT_Invalid) {
-      if(CompressorTable[i].Type == type) {
-         return CompressorTable[i].Extension;
-      }
-      i++;
+   const CompressorTableEntry* entry = findCompressor(type);
+   return (entry != nullptr) ? entry->Extension : "";
+}
+
+
+// ###### Get minimum compression level for compressor ######################
+int getMinCompressionLevel(const CompressorType type)
+{
+   const CompressorTableEntry* entry = findCompressor(type);
+   return (entry != nullptr) ? entry->MinLevel : 0;
+}
+
+
+// ###### Get default compression level for compressor ######################
+int getDefaultCompressionLevel(const CompressorType type)
+{
+   const CompressorTableEntry* entry = findCompressor(type);
+   return (entry != nullptr) ? entry->DefaultLevel : 0;
+}
+
+
+// ###### Get maximum compression level for compressor ######################
+int getMaxCompressionLevel(const CompressorType type)
+{
+   const CompressorTableEntry* entry = findCompressor(type);
+   return (entry != nullptr) ? entry->MaxLevel : 0;
+}
+
+
+// ###### Get compression level within the compressor's range ###############
+// A level of 0 selects the compressor's default level.
+int getCompressionLevel(const CompressorType type, const int level)
+{
+   if(level == 0) {
+      return getDefaultCompressionLevel(type);
    }
-   return "";
+   return std::max(getMinCompressionLevel(type),
+                   std::min(level, getMaxCompressionLevel(type)));
 }
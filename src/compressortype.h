@@ -49,5 +49,9 @@ enum CompressorType {
 CompressorType getCompressorTypeFromName(const std::string& name);
 CompressorType obtainCompressorFromExtension(const std::filesystem::path& fileName);
 const char* getExtensionForCompressor(const CompressorType type);
+int getMinCompressionLevel(const CompressorType type);
+int getDefaultCompressionLevel(const CompressorType type);
+int getMaxCompressionLevel(const CompressorType type);
+int getCompressionLevel(const CompressorType type, const int level);
 
 #endif
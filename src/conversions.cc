@@ -30,6 +30,8 @@
 #include "conversions.h"
 #include "results-exception.h"
 
+#include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/split.hpp>
 #include <boost/format.hpp>
 
 
@@ -207,3 +209,133 @@ std::string convertOldTracerouteLine(const std::string&  line,
 
    throw ResultsReaderDataErrorException("Unexpected number of columns");
 }
+
+
+// ###### Split line into space-separated columns ###########################
+static std::vector<std::string> splitColumns(const std::string_view line)
+{
+   std::vector<std::string> columns;
+   size_t                   start = 0;
+   size_t                   end;
+   while((end = line.find(' ', start)) != std::string_view::npos) {
+      columns.emplace_back(line.substr(start, end - start));
+      start = end + 1;
+   }
+   columns.emplace_back(line.substr(start));
+   return columns;
+}
+
+
+// ###### Parse hexadecimal time stamp ######################################
+static unsigned long long parseHexTimeStamp(const std::string& value)
+{
+   size_t                   index;
+   const unsigned long long timeStamp = std::stoull(value, &index, 16);
+   if(index != value.size()) {
+      throw ResultsReaderDataErrorException("Bad time stamp");
+   }
+   return timeStamp;
+}
+
+
+// ###### Constructor #######################################################
+TracerouteExpander::TracerouteExpander()
+{
+   Current = nullptr;
+}
+
+
+// ###### Destructor ########################################################
+TracerouteExpander::~TracerouteExpander()
+{
+}
+
+
+// ###### Remember full Traceroute record ###################################
+void TracerouteExpander::learn(const std::string_view line)
+{
+   // ====== #T header line (version 2) =====================================
+   if( (line.size() > 3) && (line[0] == '#') && (line[1] == 'T') && (line[2] != ' ') ) {
+      std::vector<std::string> header = splitColumns(line);
+      if(header.size() >= 14) {
+         // Key: protocol, measurement ID, source, destination, round, traffic class
+         const std::string key = header[0] + " " + header[1] + " " + header[2] + " " +
+                                 header[3] + " " + header[5] + " " + header[7];
+         Current = &Records[key];
+         Current->Header = std::move(header);
+         Current->Hops.clear();
+         return;
+      }
+   }
+
+   // ====== TAB hop line ===================================================
+   else if( (line.size() > 1) && (line[0] == '\t') && (Current != nullptr) ) {
+      Current->Hops.push_back(splitColumns(line.substr(1)));
+      return;
+   }
+   Current = nullptr;
+}
+
+
+// ###### Expand #U record to #T header and hop lines #######################
+void TracerouteExpander::expand(const std::string_view   line,
+                                std::deque<std::string>& lines)
+{
+   // #U<p> measurementID sourceIP destinationIP timestamp round traffic_class checksum pathHash [rtt_app rtt_sw rtt_hw]*
+   Current = nullptr;
+   const std::vector<std::string> unchanged = splitColumns(line);
+   if( (unchanged.size() < 9) || (unchanged[0].size() != 3) ) {
+      throw ResultsReaderDataErrorException("Unexpected number of columns");
+   }
+
+   // ====== Find the last full record of this path =========================
+   const std::string key = "#T" + unchanged[0].substr(2) + " " +
+                           unchanged[1] + " " + unchanged[2] + " " + unchanged[3] + " " +
+                           unchanged[5] + " " + unchanged[6];
+   std::map<std::string, Record>::const_iterator found = Records.find(key);
+   if( (found == Records.end()) || (found->second.Header[13] != unchanged[8]) ) {
+      throw ResultsReaderDataErrorException("Unchanged Traceroute record without full record of path " +
+                                            unchanged[8]);
+   }
+   const Record& record = found->second;
+   const size_t  rtts   = unchanged.size() - 9;
+   if( (rtts != 0) && (rtts != 3 * record.Hops.size()) ) {
+      throw ResultsReaderDataErrorException("Unexpected number of RTT values");
+   }
+
+   // ====== Generate header line ===========================================
+   std::vector<std::string> header = record.Header;
+   const unsigned long long oldTimeStamp = parseHexTimeStamp(header[4]);
+   const unsigned long long newTimeStamp = parseHexTimeStamp(unchanged[4]);
+   header[4] = unchanged[4];   // Timestamp
+   header[9] = unchanged[7];   // Checksum
+   lines.push_back(boost::algorithm::join(header, " "));
+
+   // ====== Generate hop lines =============================================
+   // The hops are the ones of the last full record. Without RTTs, there are
+   // no measured values for the hops, i.e. time source and RTTs are set to
+   // unavailable.
+   for(size_t i = 0; i < record.Hops.size(); i++) {
+      std::vector<std::string> hop = record.Hops[i];
+      if(hop.size() < 12) {
+         throw ResultsReaderDataErrorException("Unexpected number of columns");
+      }
+      // The send time stamps keep their offsets to the header time stamp:
+      hop[0] = (boost::format("%x") % (newTimeStamp + (parseHexTimeStamp(hop[0]) - oldTimeStamp))).str();
+      hop[5] = "-1";   // Delay.AppSend
+      hop[6] = "-1";   // Delay.Queuing
+      hop[7] = "-1";   // Delay.AppReceive
+      if(rtts > 0) {
+         hop[8]  = unchanged[9 + 3 * i];       // RTT.App
+         hop[9]  = unchanged[9 + 3 * i + 1];   // RTT.SW
+         hop[10] = unchanged[9 + 3 * i + 2];   // RTT.HW
+      }
+      else {
+         hop[4]  = "00000000";                 // TimeSource
+         hop[8]  = "-1";                       // RTT.App
+         hop[9]  = "-1";                       // RTT.SW
+         hop[10] = "-1";                       // RTT.HW
+      }
+      lines.push_back("\t" + boost::algorithm::join(hop, " "));
+   }
+}
@@ -30,11 +30,41 @@
 #ifndef CONVERSIONS_H
 #define CONVERSIONS_H
 
+#include <deque>
+#include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 
 std::string convertOldPingLine(const std::string& line);
 std::string convertOldTracerouteLine(const std::string&  line,
                                      unsigned long long& timeStamp);
 
+
+// Expands the #U records of change-only Traceroute output (i.e. the path is
+// unchanged since the last full #T record in the same file) into #T header
+// and TAB hop lines. The hops are the ones of the last full record, i.e. the
+// database gets the same rows as for a full record. For a #U record without
+// RTTs, time source and RTTs of the hops are set to unavailable.
+class TracerouteExpander
+{
+   public:
+   TracerouteExpander();
+   ~TracerouteExpander();
+
+   void learn(const std::string_view line);
+   void expand(const std::string_view   line,
+               std::deque<std::string>& lines);
+
+   private:
+   struct Record {
+      std::vector<std::string>              Header;
+      std::vector<std::vector<std::string>> Hops;
+   };
+
+   std::map<std::string, Record> Records;
+   Record*                       Current;
+};
+
 #endif
@@ -0,0 +1,188 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+
+#include "database-bulkrows.h"
+
+#include <arpa/inet.h>
+#include <cstring>
+
+#include <boost/asio/ip/address.hpp>
+
+
+// ###### Constructor #######################################################
+BulkRows::BulkRows()
+{
+   NestedRows = nullptr;
+   clear();
+}
+
+
+// ###### Destructor ########################################################
+BulkRows::~BulkRows()
+{
+   delete NestedRows;
+   NestedRows = nullptr;
+}
+
+
+// ###### Define table and columns ##########################################
+void BulkRows::define(const std::string&             table,
+                      const std::vector<BulkColumn>& columns)
+{
+   delete NestedRows;
+   NestedRows = nullptr;
+   clear();
+   Table   = table;
+   Columns = columns;
+
+   // ====== Prepare nested rows ============================================
+   for(const BulkColumn& column : Columns) {
+      if(column.Type == BCT_Rows) {
+         // Only one column with nested rows is supported!
+         assert(NestedRows == nullptr);
+         assert(column.NestedColumns != nullptr);
+         NestedRows = new BulkRows;
+         assert(NestedRows != nullptr);
+         NestedRows->define(Table + "." + column.Key, *column.NestedColumns);
+      }
+   }
+}
+
+
+// ###### Get comma-separated list of column names ##########################
+std::string BulkRows::getColumnList() const
+{
+   std::string columnList;
+   for(const BulkColumn& column : Columns) {
+      if(!columnList.empty()) {
+         columnList += ',';
+      }
+      columnList += column.Name;
+   }
+   return columnList;
+}
+
+
+// ###### Add integer value #################################################
+void BulkRows::addInteger(const int64_t value)
+{
+   assert(InRow);
+   assert(Column < Columns.size());
+
+   if( (Columns[Column].Type == BCT_Address) || (Columns[Column].Type == BCT_Rows) ) {
+      throw ResultsLogicException(std::string("Column ") + Columns[Column].Name +
+                                  " is not an integer column");
+   }
+
+   BulkValue& bulkValue = Values.emplace_back();
+   bulkValue.Integer       = value;
+   bulkValue.AddressLength = 0;
+   Column++;
+}
+
+
+// ###### Add address value #################################################
+BulkRows& BulkRows::operator<<(const boost::asio::ip::address& address)
+{
+   assert(InRow);
+   assert(Column < Columns.size());
+   if(Columns[Column].Type != BCT_Address) {
+      throw ResultsLogicException(std::string("Column ") + Columns[Column].Name +
+                                  " is not an address column");
+   }
+
+   BulkValue& bulkValue = Values.emplace_back();
+   bulkValue.Integer = 0;
+   if(address.is_v4()) {
+      const boost::asio::ip::address_v4::bytes_type b = address.to_v4().to_bytes();
+      bulkValue.AddressLength = b.size();
+      memcpy(&bulkValue.Address, b.data(), b.size());
+   }
+   else {
+      const boost::asio::ip::address_v6::bytes_type b = address.to_v6().to_bytes();
+      bulkValue.AddressLength = b.size();
+      memcpy(&bulkValue.Address, b.data(), b.size());
+   }
+   Column++;
+   return *this;
+}
+
+
+// ###### Begin nested rows #################################################
+// The nested rows are added to the returned BulkRows. They belong to the
+// current row, until nested rows are begun for the next row.
+BulkRows& BulkRows::beginNestedRows()
+{
+   assert(InRow);
+   assert(Column < Columns.size());
+   if(Columns[Column].Type != BCT_Rows) {
+      throw ResultsLogicException(std::string("Column ") + Columns[Column].Name +
+                                  " is not a nested rows column");
+   }
+   assert(NestedRows != nullptr);
+
+   BulkValue& bulkValue = Values.emplace_back();
+   bulkValue.Integer       = NestedRows->getRows();   // First nested row
+   bulkValue.AddressLength = 0;
+   Column++;
+   return *NestedRows;
+}
+
+
+// ###### Get range of nested rows belonging to a row #######################
+void BulkRows::getNestedRowRange(const size_t row, const size_t column,
+                                 size_t& first, size_t& last) const
+{
+   assert(Columns[column].Type == BCT_Rows);
+   assert(NestedRows != nullptr);
+   first = getValue(row, column).Integer;
+   last  = (row + 1 < Rows) ? getValue(row + 1, column).Integer : NestedRows->getRows();
+   assert(first <= last);
+}
+
+
+// ###### Report value out of range of the column type ######################
+void BulkRows::outOfRange(const std::string& value) const
+{
+   throw ResultsDatabaseDataErrorException("Value " + value + " out of range for column " +
+                                           Columns[Column].Name + " of table " + Table);
+}
+
+
+// ###### Convert address value to string ###################################
+std::string BulkRows::addressToString(const BulkValue& value)
+{
+   char buffer[INET6_ADDRSTRLEN];
+   if(inet_ntop((value.AddressLength == 4) ? AF_INET : AF_INET6,
+                &value.Address, (char*)&buffer, sizeof(buffer)) == nullptr) {
+      throw ResultsLogicException("Invalid address value");
+   }
+   return std::string(buffer);
+}
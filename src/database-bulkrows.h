@@ -0,0 +1,177 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#ifndef DATABASE_BULKROWS_H
+#define DATABASE_BULKROWS_H
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "results-exception.h"
+
+
+// Forward declarations to avoid dependency on BOOST headers:
+namespace boost::asio::ip { class address; };
+
+
+// ==========================================================================
+// Typed rows for bulk import.
+//
+// Unlike a Statement, the rows are not encoded as text. A backend
+// supporting bulk rows (see DatabaseClientBase::supportsBulkRows()) writes
+// them in its own format, e.g. PostgreSQL via COPY or MariaDB via array
+// binding. The integer widths are the ones of the PostgreSQL schema. Range
+// checks for the actual columns are left to the database, as for INSERT
+// statements: an out-of-range value fails the import with a database error.
+// BulkRows itself only rejects unsigned values above INT64_MAX, since they
+// cannot be stored in a BulkValue.
+//
+// Document-oriented backends (e.g. MongoDB) use the Key of a column as field
+// name. A BCT_Rows column holds an array of nested rows (sub-documents).
+// Relational backends do not support BCT_Rows columns.
+// ==========================================================================
+
+enum BulkColumnType {
+   BCT_SmallInt = 1,   // 16-bit signed integer
+   BCT_Integer  = 2,   // 32-bit signed integer
+   BCT_BigInt   = 3,   // 64-bit signed integer
+   BCT_Address  = 4,   // IPv4 or IPv6 address
+   BCT_Rows     = 5    // Nested rows (only for document-oriented backends)
+};
+
+struct BulkColumn
+{
+   const char*                    Name;                      // Column name
+   const char*                    Key;                       // Field name in a document
+   BulkColumnType                 Type;                      // Column type
+   const std::vector<BulkColumn>* NestedColumns = nullptr;   // Columns of nested rows
+};
+
+struct BulkValue
+{
+   int64_t        Integer;         // Integer value
+   uint8_t        AddressLength;   // 4 (IPv4) or 16 (IPv6) for an address
+   uint8_t        Address[16];     // Address in network byte order
+};
+
+
+class BulkRows
+{
+   public:
+   BulkRows();
+   ~BulkRows();
+
+   void define(const std::string& table, const std::vector<BulkColumn>& columns);
+
+   inline const std::string& getTable() const {
+      return Table;
+   }
+   inline const std::vector<BulkColumn>& getColumns() const {
+      return Columns;
+   }
+   std::string getColumnList() const;
+
+   inline void clear() {
+      Values.clear();
+      Rows   = 0;
+      Column = 0;
+      InRow  = false;
+      if(NestedRows) {
+         NestedRows->clear();
+      }
+   }
+
+   inline bool isValid() const {
+      return (!InRow) && (Rows > 0) &&
+             ((NestedRows == nullptr) || (!NestedRows->InRow));
+   }
+
+   inline size_t getRows() const {
+      return Rows;
+   }
+
+   inline const BulkValue& getValue(const size_t row, const size_t column) const {
+      assert( (row < Rows) && (column < Columns.size()) );
+      return Values[row * Columns.size() + column];
+   }
+
+   inline void beginRow() {
+      assert(!InRow);
+      InRow  = true;
+      Column = 0;
+   }
+
+   inline void endRow() {
+      assert(InRow);
+      assert(Column == Columns.size());
+      InRow = false;
+      Rows++;
+   }
+
+   template<typename T>
+   inline typename std::enable_if<std::is_integral<T>::value, BulkRows&>::type
+      operator<<(const T value) {
+      if constexpr(std::is_unsigned<T>::value) {
+         if((unsigned long long)value > (unsigned long long)std::numeric_limits<int64_t>::max()) {
+            outOfRange(std::to_string(value));
+         }
+      }
+      addInteger((int64_t)value);
+      return *this;
+   }
+   BulkRows& operator<<(const boost::asio::ip::address& address);
+
+   BulkRows& beginNestedRows();
+   inline const BulkRows& getNestedRows() const {
+      assert(NestedRows != nullptr);
+      return *NestedRows;
+   }
+   void getNestedRowRange(const size_t row, const size_t column,
+                          size_t& first, size_t& last) const;
+
+   static std::string addressToString(const BulkValue& value);
+
+   private:
+   void addInteger(const int64_t value);
+   [[noreturn]] void outOfRange(const std::string& value) const;
+
+   std::string             Table;
+   std::vector<BulkColumn> Columns;
+   std::vector<BulkValue>  Values;
+   BulkRows*               NestedRows;
+   size_t                  Rows;
+   size_t                  Column;
+   bool                    InRow;
+};
+
+#endif
@@ -83,6 +83,7 @@ DatabaseConfiguration::DatabaseConfiguration()
       ("dbbackend",         boost::program_options::value<std::string>(&BackendName),                        "database backend")
       ("dbreconnectdelay",  boost::program_options::value<unsigned int>(&ReconnectDelay)->default_value(60), "database reconnect delay (in s)")
       ("dbconnectionflags", boost::program_options::value<std::string>(&FlagNames),                          "database connection flags")
+      ("dbwriteconcern",    boost::program_options::value<std::string>(&WriteConcern)->default_value("default"), "database write concern (NoSQL)")
    ;
    BackendName = "Invalid";
    Backend     = DatabaseBackendType::Invalid;
@@ -141,6 +142,14 @@ bool DatabaseConfiguration::readConfiguration(const std::filesystem::path& confi
    // ====== Check options ==================================================
    if(!setBackend(BackendName))       return false;
    if(!setConnectionFlags(FlagNames)) return false;
+   if( (WriteConcern != "default") && (WriteConcern != "majority") &&
+       ( (WriteConcern.empty()) ||
+         (WriteConcern.find_first_not_of("0123456789") != std::string::npos) ||
+         (WriteConcern.size() > 3) ) ) {
+      HPCT_LOG(error) << "Invalid write concern " << WriteConcern
+                      << " (expected default, majority or number of nodes)";
+      return false;
+   }
 
    CAFile      = checkFile(CAFile,      configurationDirectory, "CA certificate file (dbcafile setting)");
    CRLFile     = checkFile(CRLFile,     configurationDirectory, "CRL file (dbcrlfile setting)");
@@ -215,6 +224,7 @@ std::ostream& operator<<(std::ostream& os, const DatabaseConfiguration& configur
       << "  Key File              = " << configuration.KeyFile        << "\n"
       << "  Certificate+Key File  = " << configuration.CertKeyFile    << "\n"
       << "  Database              = " << configuration.Database       << "\n"
+      << "  Write Concern         = " << configuration.WriteConcern   << "\n"
       << "  Flags                 =";
    if(configuration.Flags & ConnectionFlags::DisableTLS) {
       os << " DisableTLS";
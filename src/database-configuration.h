@@ -81,6 +81,7 @@ class DatabaseConfiguration
    inline const std::string&           getCertKeyFile()     const { return CertKeyFile;                  }
    inline const std::string&           getDatabase()        const { return Database;                     }
    inline unsigned int                 getReconnectDelay()  const { return ReconnectDelay;               }
+   inline const std::string&           getWriteConcern()    const { return WriteConcern;                 }
 
    bool setBackend(const std::string& backendName);
    bool setConnectionFlags(const std::string& connectionFlagNames);
@@ -117,6 +118,7 @@ class DatabaseConfiguration
    std::string                                 KeyFile;
    std::string                                 CertKeyFile;
    std::string                                 Database;
+   std::string                                 WriteConcern;
 };
 
 
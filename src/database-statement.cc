@@ -29,6 +29,8 @@
 
 #include "databaseclient-base.h"
 
+#include <arpa/inet.h>
+#include <cstring>
 #include <stdexcept>
 #include <boost/asio/ip/address.hpp>
 #include <boost/beast/core/detail/base64.hpp>
@@ -50,38 +52,51 @@ Statement::~Statement()
 
 
 // ###### Encode IP address #################################################
-std::string Statement::encodeAddress(const boost::asio::ip::address& address) const
+Statement::EncodedAddress Statement::encodeAddress(const boost::asio::ip::address& address) const
 {
-   std::stringstream ss;
+   EncodedAddress encoded;
+   char*          position = (char*)&encoded.Data;
 
    if(Backend & DatabaseBackendType::SQL_Generic) {
-      if( ((Backend & DatabaseBackendType::SQL_MariaDB) == DatabaseBackendType::SQL_MariaDB ) &&
-          (address.is_v4()) ) {
-         // MySQL/MariaDB only has INET6 datatype. Make IPv4 addresses mapped.
-         ss << std::quoted(boost::asio::ip::make_address_v6(boost::asio::ip::v4_mapped, address.to_v4()).to_string(), '\'', '\\');
+      *position++ = '\'';
+      if(address.is_v4()) {
+         const boost::asio::ip::address_v4::bytes_type b = address.to_v4().to_bytes();
+         if((Backend & DatabaseBackendType::SQL_MariaDB) == DatabaseBackendType::SQL_MariaDB) {
+            // MySQL/MariaDB only has INET6 datatype. Make IPv4 addresses mapped.
+            memcpy(position, "::ffff:", 7);
+            position += 7;
+         }
+         inet_ntop(AF_INET, b.data(), position, INET_ADDRSTRLEN);
       }
       else {
-         ss << std::quoted(address.to_string(), '\'', '\\');
+         const boost::asio::ip::address_v6::bytes_type b = address.to_v6().to_bytes();
+         inet_ntop(AF_INET6, b.data(), position, INET6_ADDRSTRLEN);
       }
+      position += strlen(position);
+      *position++ = '\'';
    }
    else if(Backend & DatabaseBackendType::NoSQL_Generic) {
-      char   encoded[boost::beast::detail::base64::encoded_size(16)];
-      size_t length;
+      static const char prefix[] = "{\"$type\":\"0\",\"$binary\":\"";
+      memcpy(position, prefix, sizeof(prefix) - 1);
+      position += sizeof(prefix) - 1;
       if(address.is_v4()) {
-         const boost::asio::ip::address_v4::bytes_type& b = address.to_v4().to_bytes();
-         length = boost::beast::detail::base64::encode(&encoded, (void*)&b, 4);
+         const boost::asio::ip::address_v4::bytes_type b = address.to_v4().to_bytes();
+         position += boost::beast::detail::base64::encode(position, b.data(), b.size());
       }
       else {
-         const boost::asio::ip::address_v6::bytes_type& b = address.to_v6().to_bytes();
-         length = boost::beast::detail::base64::encode(&encoded, (void*)&b, 16);
+         const boost::asio::ip::address_v6::bytes_type b = address.to_v6().to_bytes();
+         position += boost::beast::detail::base64::encode(position, b.data(), b.size());
       }
-      ss << "{\"$type\":\"0\",\"$binary\":\"" << std::string(encoded, length) << "\"}";
+      *position++ = '"';
+      *position++ = '}';
    }
    else {
       abort();
    }
 
-   return ss.str();
+   encoded.Length = position - (const char*)&encoded.Data;
+   assert(encoded.Length <= sizeof(encoded.Data));
+   return encoded;
 }
 
 
@@ -30,7 +30,12 @@
 #ifndef DATABASE_STATEMENT_H
 #define DATABASE_STATEMENT_H
 
-#include <sstream>
+#include <cassert>
+#include <charconv>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+#include <type_traits>
 
 #include "database-statement.h"
 
@@ -39,9 +44,29 @@
 namespace boost::asio::ip { class address; };
 
 
-class Statement : public std::stringstream
+// ==========================================================================
+// Statement text, built by the << operators into a std::string buffer.
+//
+// Unlike a std::stringstream, the numbers are written by std::to_chars(),
+// without locale handling, and clear() keeps the buffer's capacity. That is,
+// a Statement reused for each transaction quickly reaches its working size.
+// ==========================================================================
+
+class Statement
 {
    public:
+   // Encoded address, as returned by encodeAddress(). It fits on the stack,
+   // i.e. encoding an address does not need a memory allocation.
+   struct EncodedAddress
+   {
+      char   Data[64];
+      size_t Length;
+
+      inline operator std::string() const {
+         return std::string(Data, Length);
+      }
+   };
+
    Statement(const DatabaseBackendType backend);
    ~Statement();
 
@@ -50,17 +75,21 @@ class Statement : public std::stringstream
    }
 
    inline void clear() {
-      str(std::string());
+      Buffer.clear();   // NOTE: This keeps the capacity!
       Rows    = 0;
       InTuple = false;
    }
 
+   inline const std::string& str() const {
+      return Buffer;
+   }
+
    inline bool isEmpty() const {
-      return str().size() == 0;
+      return Buffer.empty();
    }
 
    inline bool isValid() const {
-      return (!InTuple) && ((Rows > 0) || (!str().empty()));
+      return (!InTuple) && ((Rows > 0) || (!Buffer.empty()));
    }
 
    inline size_t getRows() const {
@@ -119,19 +148,63 @@ class Statement : public std::stringstream
       }
    }
 
+   inline Statement& operator<<(const std::string& string) {
+      Buffer.append(string);
+      return *this;
+   }
+
+   inline Statement& operator<<(const char* string) {
+      Buffer.append(string);
+      return *this;
+   }
+
+   inline Statement& operator<<(const EncodedAddress& address) {
+      Buffer.append(address.Data, address.Length);
+      return *this;
+   }
+
+   template<typename T>
+   inline typename std::enable_if<std::is_integral<T>::value, Statement&>::type
+      operator<<(const T value) {
+      if constexpr(std::is_same<T, bool>::value) {
+         Buffer.push_back((value) ? '1' : '0');
+      }
+      else if constexpr(sizeof(T) == 1) {
+         Buffer.push_back((char)value);   // Character, like std::ostream
+      }
+      else {
+         char                       buffer[24];
+         const std::to_chars_result result =
+            std::to_chars((char*)&buffer, (char*)&buffer + sizeof(buffer), value);
+         Buffer.append((const char*)&buffer, result.ptr - (const char*)&buffer);
+      }
+      return *this;
+   }
+
    inline std::string quote(const std::string& string) const {
       assert(InTuple);
-      std::stringstream ss;
+      char delimiter;
       if(Backend & DatabaseBackendType::SQL_Generic) {
-         ss << std::quoted(string, '\'', '\\');
+         delimiter = '\'';
       }
       else if(Backend & DatabaseBackendType::NoSQL_Generic) {
-         ss << std::quoted(string, '"', '\\');
+         delimiter = '"';
       }
       else {
          abort();
       }
-      return ss.str();
+      // Same as std::quoted(string, delimiter, '\\'):
+      std::string quoted;
+      quoted.reserve(string.size() + 2);
+      quoted.push_back(delimiter);
+      for(const char c : string) {
+         if( (c == delimiter) || (c == '\\') ) {
+            quoted.push_back('\\');
+         }
+         quoted.push_back(c);
+      }
+      quoted.push_back(delimiter);
+      return quoted;
    }
 
    inline std::string quoteOrNull(const std::string& string) const {
@@ -149,13 +222,14 @@ class Statement : public std::stringstream
       return quote(string);
    }
 
-   std::string encodeAddress(const boost::asio::ip::address& address) const;
+   EncodedAddress encodeAddress(const boost::asio::ip::address& address) const;
    boost::asio::ip::address decodeAddress(const std::string& string) const;
 
    friend std::ostream& operator<<(std::ostream& os, const Statement& statement);
 
    private:
    const DatabaseBackendType Backend;
+   std::string               Buffer;
    size_t                    Rows;
    bool                      InTuple;
 };
@@ -50,6 +50,10 @@ DatabaseClientBase::~DatabaseClientBase()
       StatementMap.erase(iterator);
       iterator = StatementMap.begin();
    }
+   for(auto& bulkRows : BulkRowsMap) {
+      delete bulkRows.second;
+   }
+   BulkRowsMap.clear();
 }
 
 
@@ -85,6 +89,44 @@ Statement& DatabaseClientBase::getStatement(const std::string& name,
 }
 
 
+// ###### Get or create new bulk rows #######################################
+BulkRows& DatabaseClientBase::getBulkRows(const std::string& name,
+                                          const bool         mustExist,
+                                          const bool         clearRows)
+{
+   BulkRows* bulkRows;
+   std::map<std::string, BulkRows*>::iterator found = BulkRowsMap.find(name);
+   if(found == BulkRowsMap.end()) {
+      assert(mustExist == false);
+      bulkRows = new BulkRows;
+      assert(bulkRows != nullptr);
+      BulkRowsMap.insert(std::pair<std::string, BulkRows*>(name, bulkRows));
+   }
+   else {
+      bulkRows = found->second;
+      if(clearRows) {
+         bulkRows->clear();
+      }
+   }
+   return *bulkRows;
+}
+
+
+// ###### Check whether bulk rows are supported #############################
+// Without support, the readers use multi-row statements instead.
+bool DatabaseClientBase::supportsBulkRows() const
+{
+   return false;
+}
+
+
+// ###### Execute bulk rows #################################################
+void DatabaseClientBase::executeBulkRows(BulkRows& bulkRows)
+{
+   abort();   // To be implemented by subclass!
+}
+
+
 // ###### Check whether column exists #######################################
 bool DatabaseClientBase::hasColumn(const char* column) const
 {
@@ -30,6 +30,7 @@
 #ifndef DATABASECLIENT_BASE_H
 #define DATABASECLIENT_BASE_H
 
+#include "database-bulkrows.h"
 #include "database-configuration.h"
 #include "database-statement.h"
 
@@ -73,6 +74,9 @@ class DatabaseClientBase
       executeQuery(s);
    }
 
+   virtual bool supportsBulkRows() const;
+   virtual void executeBulkRows(BulkRows& bulkRows);
+
    virtual bool fetchNextTuple() = 0;
    virtual bool hasColumn(const char* column) const;
    virtual int32_t getInteger(unsigned int column) const;
@@ -89,10 +93,14 @@ class DatabaseClientBase
    Statement& getStatement(const std::string& name,
                            const bool         mustExist      = true,
                            const bool         clearStatement = false);
+   BulkRows& getBulkRows(const std::string& name,
+                         const bool         mustExist = true,
+                         const bool         clearRows = false);
 
    protected:
    const DatabaseConfiguration&      Configuration;
    std::map<std::string, Statement*> StatementMap;
+   std::map<std::string, BulkRows*>  BulkRowsMap;
 };
 
 #endif
@@ -30,6 +30,9 @@
 #include "databaseclient-mariadb.h"
 #include "logger.h"
 
+#include <arpa/inet.h>
+#include <cstring>
+
 
 // NOTE: The registration was moved to database-configuration.cc, due to linking issues!
 // REGISTER_BACKEND(DatabaseBackendType::SQL_MariaDB, "MariaDB", MariaDBClient)
@@ -41,8 +44,9 @@ MariaDBClient::MariaDBClient(const DatabaseConfiguration& configuration)
    : DatabaseClientBase(configuration)
 {
    mysql_init(&Connection);
-   ResultCursor  = nullptr;
-   ResultColumns = 0;
+   ResultCursor      = nullptr;
+   ResultColumns     = 0;
+   BulkRowsSupported = false;
 }
 
 
@@ -111,6 +115,16 @@ bool MariaDBClient::open()
    }
    HPCT_LOG(debug) << "MySQL/MariaDB Server Info: " << mysql_get_server_info(&Connection);
 
+   // ====== Check support for array binding ================================
+#ifdef MARIADB_BULK_ROWS_VIA_ARRAY_BINDING
+   unsigned long extendedCapabilities = 0;
+   BulkRowsSupported =
+      (mariadb_get_infov(&Connection, MARIADB_CONNECTION_EXTENDED_SERVER_CAPABILITIES,
+                         &extendedCapabilities) == 0) &&
+      (extendedCapabilities & (MARIADB_CLIENT_STMT_BULK_OPERATIONS >> 32));
+   HPCT_LOG(debug) << "MySQL/MariaDB array binding: " << ((BulkRowsSupported) ? "yes" : "no");
+#endif
+
    return true;
 }
 
@@ -122,6 +136,11 @@ void MariaDBClient::close()
       mysql_free_result(ResultCursor);
       ResultCursor = nullptr;
    }
+   for(auto& preparedStatement : PreparedStatementMap) {
+      mysql_stmt_close(preparedStatement.second);
+   }
+   PreparedStatementMap.clear();
+   BulkRowsSupported = false;
    mysql_close(&Connection);
    mysql_init(&Connection);
 }
@@ -129,16 +148,21 @@ void MariaDBClient::close()
 
 // ###### Handle database error #############################################
 void MariaDBClient::handleDatabaseError(const std::string& where,
-                                        const std::string& statement)
+                                        const std::string& statement,
+                                        MYSQL_STMT*        preparedStatement)
 {
-   const unsigned int errorCode = mysql_errno(&Connection);
-   const std::string  sqlState  = mysql_sqlstate(&Connection);
+   const unsigned int errorCode    = (preparedStatement != nullptr) ?
+                                        mysql_stmt_errno(preparedStatement) : mysql_errno(&Connection);
+   const std::string  sqlState     = (preparedStatement != nullptr) ?
+                                        mysql_stmt_sqlstate(preparedStatement) : mysql_sqlstate(&Connection);
+   const std::string  errorMessage = (preparedStatement != nullptr) ?
+                                        mysql_stmt_error(preparedStatement) : mysql_error(&Connection);
 
    // ====== Log error ======================================================
    const std::string what = where + " error " +
                                sqlState + "/E" +
                                std::to_string(errorCode) + ": " +
-                               mysql_error(&Connection);
+                               errorMessage;
    HPCT_LOG(error) << what;
    if(statement.size() > 0) {
       HPCT_LOG(debug) << statement;
@@ -146,7 +170,15 @@ void MariaDBClient::handleDatabaseError(const std::string& where,
 
    // ====== Throw exception ================================================
    const std::string e = sqlState.substr(0, 2);
-   if( (e == "42") || (e == "23") || (e == "22") || (e == "XA") || (e == "99") ) {
+   if( (e == "40") || (errorCode == 1205) ) {
+      // Deadlock or lock wait timeout: just retry the transaction.
+      throw ResultsDatabaseTransientErrorException(what);
+   }
+   else if(errorCode == 1062) {
+      // Duplicate entry: the data is already in the database.
+      throw ResultsDatabaseDuplicateKeyException(what);
+   }
+   else if( (e == "42") || (e == "23") || (e == "22") || (e == "XA") || (e == "99") ) {
       //  Based on mysql/connector/errors.py:
       // For this type, the input file should be moved to the bad directory.
       throw ResultsDatabaseDataErrorException(what);
@@ -204,6 +236,128 @@ void MariaDBClient::executeUpdate(Statement& statement)
 }
 
 
+// ###### Get or create prepared statement #################################
+// Prepared statements are cached for the connection, i.e. each INSERT
+// statement is only parsed once by the server.
+MYSQL_STMT* MariaDBClient::getPreparedStatement(const std::string& statement)
+{
+   std::map<std::string, MYSQL_STMT*>::iterator found = PreparedStatementMap.find(statement);
+   if(found != PreparedStatementMap.end()) {
+      return found->second;
+   }
+
+   MYSQL_STMT* preparedStatement = mysql_stmt_init(&Connection);
+   if(preparedStatement == nullptr) {
+      handleDatabaseError("Prepare", statement);
+   }
+   if(mysql_stmt_prepare(preparedStatement, statement.c_str(), statement.size())) {
+      try {
+         handleDatabaseError("Prepare", statement, preparedStatement);
+      }
+      catch(...) {
+         mysql_stmt_close(preparedStatement);
+         throw;
+      }
+   }
+   PreparedStatementMap.insert(std::pair<std::string, MYSQL_STMT*>(statement, preparedStatement));
+   return preparedStatement;
+}
+
+
+// ###### Check whether bulk rows are supported #############################
+bool MariaDBClient::supportsBulkRows() const
+{
+   return BulkRowsSupported;
+}
+
+
+// ###### Execute bulk rows #################################################
+// The rows are sent by a prepared INSERT statement, with an array of binary
+// values per column ("column-wise binding"). Addresses are sent as text,
+// with IPv4 addresses mapped to IPv6, since MySQL/MariaDB only has INET6.
+void MariaDBClient::executeBulkRows(BulkRows& bulkRows)
+{
+#ifdef MARIADB_BULK_ROWS_VIA_ARRAY_BINDING
+   assert(bulkRows.isValid());
+   if(ResultCursor) {
+      mysql_free_result(ResultCursor);
+      ResultCursor = nullptr;
+   }
+
+   const std::vector<BulkColumn>& columns = bulkRows.getColumns();
+   const size_t                   rows    = bulkRows.getRows();
+
+   // ====== Get prepared statement =========================================
+   std::string statement = "INSERT INTO " + bulkRows.getTable() +
+                              " (" + bulkRows.getColumnList() + ") VALUES (";
+   for(size_t column = 0; column < columns.size(); column++) {
+      statement += (column > 0) ? ",?" : "?";
+   }
+   statement += ")";
+   MYSQL_STMT* preparedStatement = getPreparedStatement(statement);
+
+   // ====== Bind the values column-wise ====================================
+   size_t addressColumns = 0;
+   for(const BulkColumn& column : columns) {
+      if(column.Type == BCT_Address) {
+         addressColumns++;
+      }
+   }
+   std::vector<MYSQL_BIND>    binds(columns.size());
+   std::vector<long long>     integers(rows * (columns.size() - addressColumns));
+   std::vector<char>          addresses(rows * addressColumns * INET6_ADDRSTRLEN);
+   std::vector<char*>         addressPointers(rows * addressColumns);
+   std::vector<unsigned long> addressLengths(rows * addressColumns);
+   long long*                 integer        = integers.data();
+   char**                     addressPointer = addressPointers.data();
+   unsigned long*             addressLength  = addressLengths.data();
+   char*                      address        = addresses.data();
+
+   memset(binds.data(), 0, binds.size() * sizeof(MYSQL_BIND));
+   for(size_t column = 0; column < columns.size(); column++) {
+      MYSQL_BIND& bind = binds[column];
+      if(columns[column].Type == BCT_Address) {
+         bind.buffer_type = MYSQL_TYPE_STRING;
+         bind.buffer      = addressPointer;
+         bind.length      = addressLength;
+         for(size_t row = 0; row < rows; row++) {
+            const BulkValue& value = bulkRows.getValue(row, column);
+            if(value.AddressLength == 4) {
+               memcpy(address, "::ffff:", 7);
+               inet_ntop(AF_INET, &value.Address, address + 7, INET6_ADDRSTRLEN - 7);
+            }
+            else {
+               inet_ntop(AF_INET6, &value.Address, address, INET6_ADDRSTRLEN);
+            }
+            *addressPointer++ = address;
+            *addressLength++  = strlen(address);
+            address += INET6_ADDRSTRLEN;
+         }
+      }
+      else {
+         bind.buffer_type = MYSQL_TYPE_LONGLONG;
+         bind.buffer      = integer;
+         for(size_t row = 0; row < rows; row++) {
+            *integer++ = bulkRows.getValue(row, column).Integer;
+         }
+      }
+   }
+
+   // ====== Execute statement ==============================================
+   unsigned int arraySize = rows;
+   if( (mysql_stmt_attr_set(preparedStatement, STMT_ATTR_ARRAY_SIZE, &arraySize)) ||
+       (mysql_stmt_bind_param(preparedStatement, binds.data())) ||
+       (mysql_stmt_execute(preparedStatement)) ) {
+      handleDatabaseError("Execute", statement, preparedStatement);
+   }
+
+   bulkRows.clear();
+#else
+   abort();   // Not supported by this client library!
+#endif
+}
+
+
 // ###### Execute statement #################################################
 void MariaDBClient::executeQuery(Statement& statement)
 {
@@ -35,6 +35,11 @@
 // Ubuntu: libmariadb-dev
 #include <mysql.h>
 
+// Array binding (STMT_ATTR_ARRAY_SIZE) is provided by MariaDB Connector/C:
+#if defined(MARIADB_PACKAGE_VERSION_ID) && defined(MARIADB_CLIENT_STMT_BULK_OPERATIONS)
+#define MARIADB_BULK_ROWS_VIA_ARRAY_BINDING
+#endif
+
 
 class MariaDBClient : public DatabaseClientBase
 {
@@ -51,6 +56,9 @@ class MariaDBClient : public DatabaseClientBase
    virtual void executeQuery(Statement& statement);
    virtual void endTransaction(const bool commit);
 
+   virtual bool supportsBulkRows() const;
+   virtual void executeBulkRows(BulkRows& bulkRows);
+
    virtual bool fetchNextTuple();
    virtual int32_t getInteger(unsigned int column) const;
    virtual int64_t getBigInt(unsigned int column) const;
@@ -60,12 +68,16 @@ class MariaDBClient : public DatabaseClientBase
 
    private:
    void handleDatabaseError(const std::string& where,
-                            const std::string& statement = std::string());
+                            const std::string& statement         = std::string(),
+                            MYSQL_STMT*        preparedStatement = nullptr);
+   MYSQL_STMT* getPreparedStatement(const std::string& statement);
 
-   MYSQL        Connection;
-   MYSQL_RES*   ResultCursor;
-   MYSQL_ROW    ResultRow;
-   unsigned int ResultColumns;
+   MYSQL                              Connection;
+   MYSQL_RES*                         ResultCursor;
+   MYSQL_ROW                          ResultRow;
+   unsigned int                       ResultColumns;
+   bool                               BulkRowsSupported;
+   std::map<std::string, MYSQL_STMT*> PreparedStatementMap;
 };
 
 #endif
@@ -59,6 +59,7 @@ MongoDBClient::MongoDBClient(const DatabaseConfiguration& configuration)
 {
    URI                  = nullptr;
    Connection           = nullptr;
+   WriteConcern         = nullptr;
    ResultCollection     = nullptr;
    ResultCursor         = nullptr;
    ResultDoc            = nullptr;
@@ -81,6 +82,10 @@ MongoDBClient::~MongoDBClient()
       mongoc_uri_destroy(URI);
       URI = nullptr;
    }
+   if(WriteConcern) {
+      mongoc_write_concern_destroy(WriteConcern);
+      WriteConcern = nullptr;
+   }
    mongoc_cleanup();
 }
 
@@ -145,6 +150,22 @@ bool MongoDBClient::open()
       HPCT_LOG(warning) << "TLS hostname check explicitliy disabled. CONFIGURE TLS PROPERLY!!";
    }
 
+   // ====== Prepare write concern ==========================================
+   if(WriteConcern) {
+      mongoc_write_concern_destroy(WriteConcern);
+      WriteConcern = nullptr;
+   }
+   if(Configuration.getWriteConcern() != "default") {
+      WriteConcern = mongoc_write_concern_new();
+      assert(WriteConcern != nullptr);
+      if(Configuration.getWriteConcern() == "majority") {
+         mongoc_write_concern_set_w(WriteConcern, MONGOC_WRITE_CONCERN_W_MAJORITY);
+      }
+      else {
+         mongoc_write_concern_set_w(WriteConcern, std::stoi(Configuration.getWriteConcern()));
+      }
+   }
+
    // ====== Connect to database ============================================
    Connection = mongoc_client_new_from_uri(URI);
    if(Connection == nullptr) {
@@ -305,7 +326,11 @@ void MongoDBClient::executeUpdate(Statement& statement)
                                           std::to_string(error.domain) + "." +
                                           std::to_string(error.code) +
                                           ": " + error.message;
-      if(error.domain == 12) {
+      if(error.code == 11000) {
+         // Duplicate key: the data is already in the database.
+         throw ResultsDatabaseDuplicateKeyException(errorMessage);
+      }
+      else if(error.domain == 12) {
          throw ResultsDatabaseDataErrorException(errorMessage);
       }
       else {
@@ -317,6 +342,176 @@ void MongoDBClient::executeUpdate(Statement& statement)
 }
 
 
+// ###### Check whether bulk rows are supported #############################
+bool MongoDBClient::supportsBulkRows() const
+{
+   return true;
+}
+
+
+// ###### Append fields of a row to a BSON document #########################
+void MongoDBClient::appendRow(bson_t*         document,
+                              const BulkRows& bulkRows,
+                              const size_t    row)
+{
+   const std::vector<BulkColumn>& columns = bulkRows.getColumns();
+   for(size_t column = 0; column < columns.size(); column++) {
+      const BulkValue& value = bulkRows.getValue(row, column);
+      const char*      key   = columns[column].Key;
+      switch(columns[column].Type) {
+         case BCT_Address:
+            BSON_APPEND_BINARY(document, key, BSON_SUBTYPE_BINARY,
+                               (const uint8_t*)&value.Address, value.AddressLength);
+          break;
+         case BCT_Rows: {
+            size_t first;
+            size_t last;
+            bulkRows.getNestedRowRange(row, column, first, last);
+            bson_t array;
+            BSON_APPEND_ARRAY_BEGIN(document, key, &array);
+            for(size_t nestedRow = first; nestedRow < last; nestedRow++) {
+               char        indexBuffer[16];
+               const char* index;
+               const size_t indexLength =
+                  bson_uint32_to_string(nestedRow - first, &index, indexBuffer, sizeof(indexBuffer));
+               bson_t nestedDocument;
+               bson_append_document_begin(&array, index, indexLength, &nestedDocument);
+               appendRow(&nestedDocument, bulkRows.getNestedRows(), nestedRow);
+               bson_append_document_end(&array, &nestedDocument);
+            }
+            bson_append_array_end(document, &array);
+           }
+          break;
+         default:
+            // Like bson_init_from_json(): 32-bit integer, if the value fits.
+            if( (value.Integer >= INT32_MIN) && (value.Integer <= INT32_MAX) ) {
+               BSON_APPEND_INT32(document, key, (int32_t)value.Integer);
+            }
+            else {
+               BSON_APPEND_INT64(document, key, value.Integer);
+            }
+          break;
+      }
+   }
+}
+
+
+// ###### Check whether a bulk write failed by duplicate keys only ##########
+static bool hasOnlyDuplicateKeyErrors(const bson_t* reply)
+{
+   bson_iter_t iterator;
+   bson_iter_t errorIterator;
+
+   // ====== Any write concern error is a real error ========================
+   if( (bson_iter_init_find(&iterator, reply, "writeConcernErrors")) &&
+       (BSON_ITER_HOLDS_ARRAY(&iterator)) &&
+       (bson_iter_recurse(&iterator, &errorIterator)) &&
+       (bson_iter_next(&errorIterator)) ) {
+      return false;
+   }
+
+   // ====== Check codes of the write errors ================================
+   unsigned int errors = 0;
+   if( (bson_iter_init_find(&iterator, reply, "writeErrors")) &&
+       (BSON_ITER_HOLDS_ARRAY(&iterator)) &&
+       (bson_iter_recurse(&iterator, &errorIterator)) ) {
+      while(bson_iter_next(&errorIterator)) {
+         bson_iter_t codeIterator;
+         if( (!BSON_ITER_HOLDS_DOCUMENT(&errorIterator)) ||
+             (!bson_iter_recurse(&errorIterator, &codeIterator)) ||
+             (!bson_iter_find(&codeIterator, "code")) ||
+             (bson_iter_as_int64(&codeIterator) != 11000) ) {
+            return false;
+         }
+         errors++;
+      }
+   }
+   return (errors > 0);
+}
+
+
+// ###### Execute bulk rows #################################################
+// The documents are built directly as BSON, and inserted by an unordered
+// bulk operation, i.e. the server may apply the inserts in parallel.
+// Since there are no transactions, a failed bulk operation may have
+// inserted some of the documents. For duplicate keys only, all other
+// documents have been inserted, i.e. the rows are complete in the database.
+void MongoDBClient::executeBulkRows(BulkRows& bulkRows)
+{
+   assert(bulkRows.isValid());
+
+   // ====== Prepare bulk operation =========================================
+   const std::string collectionName =
+      boost::to_lower_copy<std::string>(bulkRows.getTable());
+   mongoc_collection_t* collection =
+      mongoc_client_get_collection(Connection,
+                                   Configuration.getDatabase().c_str(),
+                                   collectionName.c_str());
+   assert(collection != nullptr);
+   bson_t options;
+   bson_init(&options);
+   BSON_APPEND_BOOL(&options, "ordered", false);
+   if(WriteConcern) {
+      mongoc_write_concern_append(WriteConcern, &options);
+   }
+   mongoc_bulk_operation_t* bulk =
+      mongoc_collection_create_bulk_operation_with_opts(collection, &options);
+   assert(bulk != nullptr);
+   bson_destroy(&options);
+
+   // ====== Add documents ==================================================
+   bson_error_t error;
+   bson_t       document;
+   bool         success = true;
+   bson_init(&document);
+   for(size_t row = 0; row < bulkRows.getRows(); row++) {
+      appendRow(&document, bulkRows, row);
+      if(!mongoc_bulk_operation_insert_with_opts(bulk, &document, nullptr, &error)) {
+         success = false;
+         break;
+      }
+      bson_reinit(&document);
+   }
+   bson_destroy(&document);
+
+   // ====== Insert documents ===============================================
+   if(success) {
+      bson_t reply;
+      success = (mongoc_bulk_operation_execute(bulk, &reply, &error) != 0);
+      if( (!success) && (error.code == 11000) &&
+          (hasOnlyDuplicateKeyErrors(&reply)) ) {
+         // Duplicate keys only, e.g. after an interrupted run of the
+         // importer: the other documents have been inserted.
+         HPCT_LOG(warning) << "Ignoring duplicate keys in " << collectionName
+                           << ": " << error.message;
+         success = true;
+      }
+      bson_destroy(&reply);
+   }
+   mongoc_bulk_operation_destroy(bulk);
+   mongoc_collection_destroy(collection);
+
+   if(!success) {
+      const std::string errorMessage = std::string("Insert error ") +
+                                          std::to_string(error.domain) + "." +
+                                          std::to_string(error.code) +
+                                          ": " + error.message;
+      if(error.code == 11000) {
+         // Duplicate key: the data is already in the database.
+         throw ResultsDatabaseDuplicateKeyException(errorMessage);
+      }
+      else if(error.domain == 12) {
+         throw ResultsDatabaseDataErrorException(errorMessage);
+      }
+      else {
+         throw ResultsDatabaseException(errorMessage);
+      }
+   }
+
+   bulkRows.clear();
+}
+
+
 // ###### Execute statement #################################################
 void MongoDBClient::freeResults()
 {
@@ -52,6 +52,9 @@ class MongoDBClient : public DatabaseClientBase
    virtual void executeQuery(Statement& statement);
    virtual void endTransaction(const bool commit);
 
+   virtual bool supportsBulkRows() const;
+   virtual void executeBulkRows(BulkRows& bulkRows);
+
    virtual bool fetchNextTuple();
    virtual bool hasColumn(const char* column) const;
    virtual int32_t getInteger(const char* column) const;
@@ -66,16 +69,20 @@ class MongoDBClient : public DatabaseClientBase
 
    private:
    void freeResults();
+   static void appendRow(bson_t*         document,
+                         const BulkRows& bulkRows,
+                         const size_t    row);
 
-   mongoc_uri_t*        URI;
-   mongoc_client_t*     Connection;
-   mongoc_collection_t* ResultCollection;
-   mongoc_cursor_t*     ResultCursor;
-   const bson_t*        ResultDoc;
+   mongoc_uri_t*           URI;
+   mongoc_client_t*        Connection;
+   mongoc_write_concern_t* WriteConcern;
+   mongoc_collection_t*    ResultCollection;
+   mongoc_cursor_t*        ResultCursor;
+   const bson_t*           ResultDoc;
 
-   bson_iter_t          ResultArrayIterator;
-   bson_t               ResultArrayDoc;
-   const bson_t*        ResultArrayParentDoc;
+   bson_iter_t             ResultArrayIterator;
+   bson_t                  ResultArrayDoc;
+   const bson_t*           ResultArrayParentDoc;
 };
 
 #endif
@@ -30,6 +30,8 @@
 #include "databaseclient-postgresql.h"
 #include "logger.h"
 
+#include <charconv>
+
 
 // NOTE: The registration was moved to database-configuration.cc, due to linking issues!
 // REGISTER_BACKEND(DatabaseBackendType::SQL_PostgreSQL, "PostgreSQL", PostgreSQLClient)
@@ -143,6 +145,15 @@ void PostgreSQLClient::handleDatabaseException(const pqxx::failure& exception,
    // ====== Throw exception ================================================
    // Query error
    if( (Connection != nullptr) && (Connection->is_open()) && (sqlError != nullptr) ) {
+      const std::string& sqlState = sqlError->sqlstate();
+      // Serialisation failure or deadlock: just retry the transaction.
+      if( (sqlState == "40001") || (sqlState == "40P01") ) {
+         throw ResultsDatabaseTransientErrorException(what);
+      }
+      // Unique violation: the data is already in the database.
+      else if(sqlState == "23505") {
+         throw ResultsDatabaseDuplicateKeyException(what);
+      }
       // For this type, the input file should be moved to the bad directory.
       throw ResultsDatabaseDataErrorException(what);
    }
@@ -223,6 +234,66 @@ void PostgreSQLClient::executeUpdate(Statement& statement)
 }
 
 
+// ###### Check whether bulk rows are supported #############################
+bool PostgreSQLClient::supportsBulkRows() const
+{
+#ifdef POSTGRESQL_BULK_ROWS_VIA_COPY
+   return true;
+#else
+   return false;
+#endif
+}
+
+
+// ###### Execute bulk rows #################################################
+// The rows are sent by COPY, in text format. Unlike a multi-row INSERT,
+// there is no statement to be parsed and planned by the server. Like for
+// INSERT, any error fails the whole COPY.
+void PostgreSQLClient::executeBulkRows(BulkRows& bulkRows)
+{
+#ifdef POSTGRESQL_BULK_ROWS_VIA_COPY
+   assert(bulkRows.isValid());
+   assert(Transaction != nullptr);
+
+   const std::vector<BulkColumn>& columns = bulkRows.getColumns();
+   try {
+      pqxx::stream_to stream =
+         pqxx::stream_to::raw_table(*Transaction, bulkRows.getTable(),
+                                    bulkRows.getColumnList());
+      std::string line;
+      char        buffer[24];
+      for(size_t row = 0; row < bulkRows.getRows(); row++) {
+         line.clear();
+         for(size_t column = 0; column < columns.size(); column++) {
+            if(column > 0) {
+               line += '\t';
+            }
+            const BulkValue& value = bulkRows.getValue(row, column);
+            if(columns[column].Type == BCT_Address) {
+               line += BulkRows::addressToString(value);
+            }
+            else {
+               const std::to_chars_result result =
+                  std::to_chars((char*)&buffer, (char*)&buffer + sizeof(buffer), value.Integer);
+               line.append((const char*)&buffer, result.ptr - (const char*)&buffer);
+            }
+         }
+         stream.write_raw_line(line);
+      }
+      stream.complete();
+   }
+   catch(const pqxx::failure& exception) {
+      handleDatabaseException(exception, "Copy",
+                              "COPY " + bulkRows.getTable() +
+                                 " (" + bulkRows.getColumnList() + ") FROM STDIN");
+   }
+   bulkRows.clear();
+#else
+   abort();   // Not supported by this libpqxx version!
+#endif
+}
+
+
 // ###### Execute statement #################################################
 void PostgreSQLClient::executeQuery(Statement& statement)
 {
@@ -34,6 +34,10 @@
 
 #include <pqxx/pqxx>
 
+// COPY is written by pqxx::stream_to::raw_table(), i.e. libpqxx >= 7.6:
+#if (PQXX_VERSION_MAJOR > 7) || ((PQXX_VERSION_MAJOR == 7) && (PQXX_VERSION_MINOR >= 6))
+#define POSTGRESQL_BULK_ROWS_VIA_COPY
+#endif
 
 class PostgreSQLClient : public DatabaseClientBase
 {
@@ -50,6 +54,9 @@ class PostgreSQLClient : public DatabaseClientBase
    virtual void executeQuery(Statement& statement);
    virtual void endTransaction(const bool commit);
 
+   virtual bool supportsBulkRows() const;
+   virtual void executeBulkRows(BulkRows& bulkRows);
+
    virtual bool fetchNextTuple();
    virtual int32_t getInteger(unsigned int column) const;
    virtual int64_t getBigInt(unsigned int column) const;
@@ -0,0 +1,152 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#include "ddsketch.h"
+#include "assure.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+// ###### Constructor #######################################################
+DDSketch::DDSketch(const double       relativeAccuracy,
+                   const unsigned int maxBuckets)
+   : Gamma((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy)),
+     LogGamma(std::log(Gamma)),
+     MaxBuckets(std::max(1U, maxBuckets))
+{
+   assure((relativeAccuracy > 0.0) && (relativeAccuracy < 1.0));
+   clear();
+}
+
+
+// ###### Destructor ########################################################
+DDSketch::~DDSketch()
+{
+}
+
+
+// ###### Get bucket index of value #########################################
+int DDSketch::index(const double value) const
+{
+   return (int)std::ceil(std::log(value) / LogGamma);
+}
+
+
+// ###### Get representative value of bucket ################################
+double DDSketch::lowerBound(const int index) const
+{
+   // Bucket i covers (γ^(i-1), γ^i]. The representative value
+   // 2γ^i / (γ + 1) has a relative error of at most α to all of them.
+   return 2.0 * std::pow(Gamma, index) / (Gamma + 1.0);
+}
+
+
+// ###### Remove all values #################################################
+void DDSketch::clear()
+{
+   Buckets.clear();
+   Offset    = 0;
+   ZeroCount = 0;
+   Count     = 0;
+   Minimum   = 0.0;
+   Maximum   = 0.0;
+   Sum       = 0.0;
+}
+
+
+// ###### Add value #########################################################
+void DDSketch::add(const double value)
+{
+   // ====== Update statistics ==============================================
+   if(Count == 0) {
+      Minimum = value;
+      Maximum = value;
+   }
+   else {
+      Minimum = std::min(Minimum, value);
+      Maximum = std::max(Maximum, value);
+   }
+   Sum += value;
+   Count++;
+
+   if(value <= 0.0) {
+      ZeroCount++;
+      return;
+   }
+
+   // ====== Find bucket ====================================================
+   const int i = index(value);
+   if(Buckets.empty()) {
+      Offset = i;
+      Buckets.push_back(0);
+   }
+   else if(i < Offset) {
+      Buckets.insert(Buckets.begin(), Offset - i, 0);
+      Offset = i;
+   }
+   else if(i >= Offset + (int)Buckets.size()) {
+      Buckets.resize(i - Offset + 1, 0);
+   }
+   Buckets[std::max(0, i - Offset)]++;
+
+   // ====== Collapse lowest buckets, if there are too many =================
+   if(Buckets.size() > MaxBuckets) {
+      const size_t excess = Buckets.size() - MaxBuckets;
+      unsigned int collapsed = 0;
+      for(size_t j = 0; j <= excess; j++) {
+         collapsed += Buckets[j];
+      }
+      Buckets.erase(Buckets.begin(), Buckets.begin() + excess);
+      Buckets[0] = collapsed;
+      Offset += excess;
+   }
+}
+
+
+// ###### Get quantile (q in [0, 1]) ########################################
+double DDSketch::quantile(const double q) const
+{
+   if(Count == 0) {
+      return 0.0;
+   }
+
+   const double rank = std::max(0.0, std::min(1.0, q)) * (Count - 1);
+   unsigned long long cumulative = ZeroCount;
+   if((double)cumulative > rank) {
+      return Minimum;
+   }
+   for(size_t j = 0; j < Buckets.size(); j++) {
+      cumulative += Buckets[j];
+      if((double)cumulative > rank) {
+         return std::max(Minimum, std::min(Maximum, lowerBound(Offset + (int)j)));
+      }
+   }
+   return Maximum;
+}
@@ -0,0 +1,92 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#ifndef DDSKETCH_H
+#define DDSKETCH_H
+
+#include <stdint.h>
+
+#include <vector>
+
+
+// ==========================================================================
+// DDSketch: streaming quantile sketch with relative-error guarantee.
+// See: C. Masson, J. E. Rim, H. K. Lee: "DDSketch: A Fast and Fully-Mergeable
+// Quantile Sketch with Relative-Error Guarantees", VLDB 2019.
+//
+// Positive values x are counted in logarithmic buckets i = ceil(log_γ(x)),
+// with γ = (1 + α) / (1 - α). Any quantile is then returned with a relative
+// error of at most α. If the number of buckets exceeds the limit, the lowest
+// buckets are collapsed (i.e. only the low quantiles lose accuracy).
+// ==========================================================================
+
+class DDSketch
+{
+   public:
+   DDSketch(const double       relativeAccuracy = 0.01,
+            const unsigned int maxBuckets       = 2048);
+   ~DDSketch();
+
+   inline unsigned long long count() const {
+      return Count;
+   }
+   inline double minimum() const {
+      return Minimum;
+   }
+   inline double maximum() const {
+      return Maximum;
+   }
+   inline double sum() const {
+      return Sum;
+   }
+   inline double mean() const {
+      return (Count > 0) ? (Sum / Count) : 0.0;
+   }
+
+   void   add(const double value);
+   double quantile(const double q) const;
+   void   clear();
+
+   private:
+   int    index(const double value) const;
+   double lowerBound(const int index) const;
+
+   const double                  Gamma;
+   const double                  LogGamma;
+   const unsigned int            MaxBuckets;
+   std::vector<unsigned int>     Buckets;
+   int                           Offset;        // Bucket index of Buckets[0]
+   unsigned long long            ZeroCount;     // Values <= 0
+   unsigned long long            Count;
+   double                        Minimum;
+   double                        Maximum;
+   double                        Sum;
+};
+
+#endif
@@ -34,6 +34,7 @@
 #include <boost/program_options.hpp>
 
 #include "check.h"
+#include "compressionpool.h"
 // #include "jitter.h"
 #include "compressortype.h"
 #include "logger.h"
@@ -208,10 +209,15 @@ int main(int argc, char** argv)
    TracerouteParameters               tracerouteParameters;
    uint16_t                           tracerouteUDPSourcePort;
    uint16_t                           tracerouteUDPDestinationPort;
+   uint16_t                           tracerouteTCPSourcePort;
+   uint16_t                           tracerouteTCPDestinationPort;
+   std::string                        tracerouteChangeOnlyString;
 
    TracerouteParameters               pingParameters;
    uint16_t                           pingUDPSourcePort;
    uint16_t                           pingUDPDestinationPort;
+   uint16_t                           pingTCPSourcePort;
+   uint16_t                           pingTCPDestinationPort;
 
 #if 0
    TracerouteParameters               jitterParameters;
@@ -223,8 +229,17 @@ int main(int argc, char** argv)
    unsigned int                       resultsTransactionLength;
    std::filesystem::path              resultsDirectory;
    std::string                        resultsCompressionString;
+   unsigned int                       resultsCompressionThreads;
+   unsigned int                       resultsCompressionMemory;
+   int                                resultsCompressionLevel;
+   double                             resultsCompressionCPUBudget;
+   bool                               resultsIndex;
+   unsigned int                       resultsBufferSize;
+   unsigned int                       resultsWritebackSize;
    unsigned int                       resultsFormatVersion;
    unsigned int                       resultsTimestampDepth;
+   unsigned int                       resultsSharing;
+   std::filesystem::path              resultsDictionaryFile;
 
    boost::program_options::options_description commandLineOptions;
    commandLineOptions.add_options()
@@ -297,9 +312,18 @@ int main(int argc, char** argv)
       ( "tracerouteduration",
            boost::program_options::value<unsigned int>(&tracerouteParameters.Expiration)->default_value(3000),
            "Traceroute duration in ms" )
+      ( "tracerouteadaptivetimeout",
+           boost::program_options::value<bool>(&tracerouteParameters.AdaptiveTimeout)->default_value(false)->implicit_value(true),
+           "Traceroute adaptive timeout based on RTT estimate" )
+      ( "tracerouteminimumtimeout",
+           boost::program_options::value<unsigned int>(&tracerouteParameters.MinimumTimeout)->default_value(250),
+           "Traceroute minimum adaptive timeout in ms" )
       ( "tracerouterounds",
            boost::program_options::value<unsigned int>(&tracerouteParameters.Rounds)->default_value(1),
            "Traceroute rounds" )
+      ( "traceroutemdaconfidence",
+           boost::program_options::value<float>(&tracerouteParameters.MDAConfidence)->default_value(0.0),
+           "Traceroute MDA confidence (0 to turn off MDA)" )
       ( "tracerouteinitialmaxttl",
            boost::program_options::value<unsigned int>(&tracerouteParameters.InitialMaxTTL)->default_value(6),
            "Traceroute initial maximum TTL value" )
@@ -318,6 +342,27 @@ int main(int argc, char** argv)
       ( "tracerouteudpdestinationport",
            boost::program_options::value<uint16_t>(&tracerouteUDPDestinationPort)->default_value(7),
            "Traceroute UDP destination port" )
+      ( "traceroutetcpsourceport",
+           boost::program_options::value<uint16_t>(&tracerouteTCPSourcePort)->default_value(0),
+           "Traceroute TCP source port" )
+      ( "traceroutetcpdestinationport",
+           boost::program_options::value<uint16_t>(&tracerouteTCPDestinationPort)->default_value(80),
+           "Traceroute TCP destination port" )
+      ( "traceroutechangeonly",
+           boost::program_options::value<std::string>(&tracerouteChangeOnlyString)->default_value(std::string("off")),
+           "Traceroute change-only output (off, rtts or hash)" )
+      ( "traceroutettlcachedirectory",
+           boost::program_options::value<std::filesystem::path>(&tracerouteParameters.TTLCacheDirectory)->default_value(std::filesystem::path()),
+           "Traceroute TTL cache snapshot directory" )
+      ( "traceroutettlcachesize",
+           boost::program_options::value<unsigned int>(&tracerouteParameters.TTLCacheSize)->default_value(65536),
+           "Traceroute TTL cache size in entries" )
+      ( "traceroutettlcachemaxage",
+           boost::program_options::value<unsigned int>(&tracerouteParameters.TTLCacheMaxAge)->default_value(86400),
+           "Traceroute TTL cache maximum entry age in s" )
+      ( "traceroutettlcachesnapshotinterval",
+           boost::program_options::value<unsigned int>(&tracerouteParameters.TTLCacheSnapshotInterval)->default_value(300),
+           "Traceroute TTL cache snapshot interval in s" )
 
       ( "pinginterval",
            boost::program_options::value<unsigned long long>(&pingParameters.Interval)->default_value(1000),
@@ -343,6 +388,15 @@ int main(int argc, char** argv)
       ( "pingudpdestinationport",
            boost::program_options::value<uint16_t>(&pingUDPDestinationPort)->default_value(7),
            "Ping UDP destination port" )
+      ( "pingtcpsourceport",
+           boost::program_options::value<uint16_t>(&pingTCPSourcePort)->default_value(0),
+           "Ping TCP source port" )
+      ( "pingtcpdestinationport",
+           boost::program_options::value<uint16_t>(&pingTCPDestinationPort)->default_value(80),
+           "Ping TCP destination port" )
+      ( "pingsummaryinterval",
+           boost::program_options::value<unsigned int>(&pingParameters.SummaryInterval)->default_value(0),
+           "Ping summary interval in s (0 for raw results)" )
 
 #if 0
       ( "jitterinterval",
@@ -383,12 +437,39 @@ int main(int argc, char** argv)
       ( "resultscompression,C",
            boost::program_options::value<std::string>(&resultsCompressionString)->default_value(std::string("XZ")),
            "Results compression" )
+      ( "resultscompressionthreads",
+           boost::program_options::value<unsigned int>(&resultsCompressionThreads)->default_value(0),
+           "Results compression threads (0 = number of CPU cores)" )
+      ( "resultscompressionmemory",
+           boost::program_options::value<unsigned int>(&resultsCompressionMemory)->default_value(256),
+           "Results compression memory budget in MiB" )
+      ( "resultscompressionlevel",
+           boost::program_options::value<int>(&resultsCompressionLevel)->default_value(0),
+           "Results compression level (0 = default of the compressor)" )
+      ( "resultscompressioncpubudget",
+           boost::program_options::value<double>(&resultsCompressionCPUBudget)->default_value(0.0),
+           "Results compression CPU budget per results file in % of a CPU core (0 = fixed level)" )
       ( "resultsformat,F",
            boost::program_options::value<unsigned int>(&resultsFormatVersion)->default_value(OutputFormatVersionType::OFT_HiPerConTracer_Version2),
            "Results format version" )
       ( "resultstimestampdepth,z",
            boost::program_options::value<unsigned int>(&resultsTimestampDepth)->default_value(0),
            "Results timestamp depth" )
+      ( "resultssharing",
+           boost::program_options::value<unsigned int>(&resultsSharing)->default_value(1),
+           "Number of services sharing a results file (1 = per service, 0 = all)" )
+      ( "resultszstddictionary",
+           boost::program_options::value<std::filesystem::path>(&resultsDictionaryFile)->default_value(std::filesystem::path()),
+           "Results ZSTD dictionary file" )
+      ( "resultsindex",
+           boost::program_options::value<bool>(&resultsIndex)->default_value(false)->implicit_value(true),
+           "Write an index file for each results file" )
+      ( "resultsbuffersize",
+           boost::program_options::value<unsigned int>(&resultsBufferSize)->default_value(OutputStream::DefaultBufferSize / 1024),
+           "Results file output buffer size in KiB" )
+      ( "resultswritebacksize",
+           boost::program_options::value<unsigned int>(&resultsWritebackSize)->default_value(OutputStream::DefaultWritebackSize / 1024),
+           "Start writeback of results files every given amount of KiB (0 = off)" )
     ;
 
    // ====== Handle command-line arguments ==================================
@@ -475,6 +556,11 @@ int main(int argc, char** argv)
       std::cerr << "ERROR: Invalid Traceroute interval deviation setting: "
                 << tracerouteParameters.Deviation << "\n";
    }
+   if( (tracerouteParameters.MDAConfidence < 0.0) || (tracerouteParameters.MDAConfidence >= 1.0) ) {
+      std::cerr << "ERROR: Invalid Traceroute MDA confidence setting: "
+                << tracerouteParameters.MDAConfidence << "\n";
+      return 1;
+   }
    if(tracerouteParameters.InitialMaxTTL > tracerouteParameters.FinalMaxTTL) {
       std::cerr << "NOTE: Setting TracerouteInitialMaxTTL to TracerouteFinalMaxTTL=" << tracerouteParameters.FinalMaxTTL << "!\n";
       tracerouteParameters.InitialMaxTTL = tracerouteParameters.FinalMaxTTL;
@@ -496,12 +582,30 @@ int main(int argc, char** argv)
       return 1;
    }
 #endif
+   tracerouteParameters.ChangeOnly =
+      getTracerouteChangeOnlyModeFromName(tracerouteChangeOnlyString);
+   if(tracerouteParameters.ChangeOnly == TCOM_Invalid) {
+      std::cerr << "ERROR: Invalid Traceroute change-only mode: " << tracerouteChangeOnlyString << "\n";
+      return 1;
+   }
    const CompressorType resultsCompression =
       getCompressorTypeFromName(resultsCompressionString);
    if(resultsCompression == CT_Invalid) {
       std::cerr << "ERROR: Invalid results compression: " << resultsCompressionString << "\n";
       return 1;
    }
+   if( (!resultsDictionaryFile.empty()) && (resultsCompression != CT_ZSTD) ) {
+      std::cerr << "ERROR: A results ZSTD dictionary needs ZSTD results compression!\n";
+      return 1;
+   }
+   if( (resultsCompressionCPUBudget < 0.0) || (resultsCompressionCPUBudget > 100.0) ) {
+      std::cerr << "ERROR: Invalid results compression CPU budget: " << resultsCompressionCPUBudget << "\n";
+      return 1;
+   }
+   CompressionPool::configure(resultsCompressionThreads,
+                              (size_t)std::max(1U, resultsCompressionMemory) * 1024 * 1024);
+   OutputStream::configure((size_t)resultsBufferSize * 1024,
+                           (size_t)resultsWritebackSize * 1024);
 
 
    // ====== Initialize =====================================================
@@ -512,6 +616,16 @@ int main(int argc, char** argv)
       HPCT_LOG(fatal) << "Cannot find user \"" << user << "\"!";
       return 1;
    }
+   const ZSTDDictionary* resultsDictionary = nullptr;
+   if(!resultsDictionaryFile.empty()) {
+      try {
+         resultsDictionary = ZSTDDictionary::loadDictionary(resultsDictionaryFile);
+      }
+      catch(std::exception& e) {
+         HPCT_LOG(fatal) << "Cannot load results ZSTD dictionary: " << e.what();
+         return 1;
+      }
+   }
    unsigned int sourcesIPv4;
    unsigned int sourcesIPv6;
    unsigned int destinationsIPv4;
@@ -546,6 +660,14 @@ int main(int argc, char** argv)
    pingParameters.IncrementMaxTTL       = 1;
    pingParameters.Rounds                = std::min(std::max(1U, pingParameters.Rounds),                1024U);
    pingParameters.PacketSize            = std::min(65535U, pingParameters.PacketSize);
+   pingParameters.MDAConfidence         = 0.0;
+   pingParameters.AdaptiveTimeout       = false;
+   pingParameters.MinimumTimeout        = 0;
+   pingParameters.TTLCacheSize          = 0;
+   pingParameters.TTLCacheMaxAge        = 0;
+   pingParameters.TTLCacheSnapshotInterval = 0;
+   pingParameters.SummaryInterval       = std::min(pingParameters.SummaryInterval,                     86400U);
+   pingParameters.ChangeOnly            = TCOM_Off;
    tracerouteParameters.Interval        = std::min(std::max(1000ULL, tracerouteParameters.Interval),   3600U*60000ULL);
    tracerouteParameters.Expiration      = std::min(std::max(1000U, tracerouteParameters.Expiration),   60000U);
    tracerouteParameters.InitialMaxTTL   = std::min(std::max(1U, tracerouteParameters.InitialMaxTTL),   255U);
@@ -553,12 +675,30 @@ int main(int argc, char** argv)
    tracerouteParameters.IncrementMaxTTL = std::min(std::max(1U, tracerouteParameters.IncrementMaxTTL), 255U);
    tracerouteParameters.PacketSize      = std::min(65535U, tracerouteParameters.PacketSize);
    tracerouteParameters.Rounds          = std::min(std::max(1U, tracerouteParameters.Rounds),          64U);
+   tracerouteParameters.MinimumTimeout  = std::min(std::max(10U, tracerouteParameters.MinimumTimeout), tracerouteParameters.Expiration);
+   tracerouteParameters.TTLCacheSize    = std::min(std::max(16U, tracerouteParameters.TTLCacheSize),   16777216U);
+   tracerouteParameters.TTLCacheSnapshotInterval = std::min(std::max(10U, tracerouteParameters.TTLCacheSnapshotInterval), 86400U);
+   tracerouteParameters.SummaryInterval = 0;
 
    if(!resultsDirectory.empty()) {
       HPCT_LOG(info) << "Results Output:" << "\n"
                      << "* MeasurementID      = " << measurementID            << "\n"
                      << "* Results Directory  = " << resultsDirectory         << "\n"
-                     << "* Transaction Length = " << resultsTransactionLength << " s";
+                     << "* Transaction Length = " << resultsTransactionLength << " s\n"
+                     << "* Shared Writers     = " << ((resultsSharing == 1) ? "off" :
+                                                        ((resultsSharing == 0) ? "all services" :
+                                                          std::to_string(resultsSharing) + " services")) << "\n"
+                     << "* Compression        = " << resultsCompressionString << " ("
+                        << ((resultsCompressionThreads > 0) ? resultsCompressionThreads : std::thread::hardware_concurrency())
+                        << " threads, " << resultsCompressionMemory << " MiB)\n"
+                     << "* Compression Level  = " << getCompressionLevel(resultsCompression, resultsCompressionLevel)
+                        << ((resultsCompressionCPUBudget > 0.0) ? " (adaptive)" : " (fixed)") << "\n"
+                     << "* Compression Budget = " << resultsCompressionCPUBudget << "% of a CPU core\n"
+                     << "* ZSTD Dictionary    = " << ((resultsDictionary != nullptr) ?
+                                                        std::to_string(resultsDictionary->id()) : std::string("none")) << "\n"
+                     << "* Index Files        = " << ((resultsIndex) ? "on" : "off") << "\n"
+                     << "* Output Buffer      = " << resultsBufferSize << " KiB, writeback every "
+                        << resultsWritebackSize << " KiB";
    }
    else {
       HPCT_LOG(info) << "Results Output:" << "\n"
@@ -587,20 +727,43 @@ int main(int argc, char** argv)
                      << "* TTL                = " << pingParameters.InitialMaxTTL         << "\n"
                      << "* Packet Size        = " << pingParameters.PacketSize            << " B\n"
                      << "* Ports              = (none for ICMP) / UDP: "
-                        << pingUDPSourcePort << " -> " << pingUDPDestinationPort << "\n";
+                        << pingUDPSourcePort << " -> " << pingUDPDestinationPort << " / TCP: "
+                        << pingTCPSourcePort << " -> " << pingTCPDestinationPort << "\n"
+                     << "* Summary            = "
+                        << ((pingParameters.SummaryInterval > 0) ?
+                               "every " + std::to_string(pingParameters.SummaryInterval) + " s" :
+                               std::string("off (raw results)")) << "\n";
    }
    if(serviceTraceroute) {
       HPCT_LOG(info) << "Traceroute Service:" << std:: endl
                      << "* Interval           = " << tracerouteParameters.Interval        << " ms ± "
                         << 100.0 * tracerouteParameters.Deviation << "%\n"
                      << "* Expiration         = " << tracerouteParameters.Expiration      << " ms" << "\n"
+                     << "* Adaptive Timeout   = "
+                        << ((tracerouteParameters.AdaptiveTimeout) ?
+                               "on, minimum " + std::to_string(tracerouteParameters.MinimumTimeout) + " ms" :
+                               std::string("off")) << "\n"
                      << "* Rounds             = " << tracerouteParameters.Rounds          << "\n"
+                     << "* MDA                = "
+                        << ((tracerouteParameters.MDAConfidence > 0.0) ?
+                               "confidence " + std::to_string(100.0 * tracerouteParameters.MDAConfidence) + "%, max. " +
+                                  std::to_string(tracerouteParameters.Rounds) + " flows per hop" :
+                               std::string("off")) << "\n"
                      << "* Initial MaxTTL     = " << tracerouteParameters.InitialMaxTTL   << "\n"
                      << "* Final MaxTTL       = " << tracerouteParameters.FinalMaxTTL     << "\n"
                      << "* Increment MaxTTL   = " << tracerouteParameters.IncrementMaxTTL << "\n"
                      << "* Packet Size        = " << tracerouteParameters.PacketSize      << " B\n"
                      << "* Ports              = (none for ICMP) / UDP: "
-                        << tracerouteUDPSourcePort << " -> " << tracerouteUDPDestinationPort << "\n";
+                        << tracerouteUDPSourcePort << " -> " << tracerouteUDPDestinationPort << " / TCP: "
+                        << tracerouteTCPSourcePort << " -> " << tracerouteTCPDestinationPort << "\n"
+                     << "* Change-Only Output = " << getTracerouteChangeOnlyModeName(tracerouteParameters.ChangeOnly) << "\n"
+                     << "* TTL Cache          = " << tracerouteParameters.TTLCacheSize    << " entries, max. age "
+                        << tracerouteParameters.TTLCacheMaxAge << " s\n"
+                     << "* TTL Cache Snapshot = "
+                        << ((!tracerouteParameters.TTLCacheDirectory.empty()) ?
+                               tracerouteParameters.TTLCacheDirectory.string() + " every " +
+                                  std::to_string(tracerouteParameters.TTLCacheSnapshotInterval) + " s" :
+                               std::string("-- turned off --")) << "\n";
    }
 
 
@@ -639,7 +802,10 @@ int main(int argc, char** argv)
                                      sourceAddress, "Jitter-" + ioModule,
                                      resultsDirectory, resultsTransactionLength, resultsTimestampDepth,
                                      (pw != nullptr) ? pw->pw_uid : 0, (pw != nullptr) ? pw->pw_gid : 0,
-                                     resultsCompression);
+                                     resultsCompression, resultsSharing,
+                                     resultsDictionary, resultsCompressionLevel,
+                                     resultsCompressionCPUBudget / 100.0,
+                                     resultsIndex);
                   assert(resultsWriter != nullptr);
                }
                if(ioModule == "UDP") {
@@ -670,22 +836,32 @@ int main(int argc, char** argv)
                if(!resultsDirectory.empty()) {
                   resultsWriter = ResultsWriter::makeResultsWriter(
                                      ResultsWriterSet, ProgramID, measurementID,
-                                     sourceAddress, "Ping-" + ioModule,
+                                     sourceAddress,
+                                     ((pingParameters.SummaryInterval > 0) ? "PingSummary-" : "Ping-") + ioModule,
                                      resultsDirectory, resultsTransactionLength, resultsTimestampDepth,
                                      (pw != nullptr) ? pw->pw_uid : 0, (pw != nullptr) ? pw->pw_gid : 0,
-                                     resultsCompression);
+                                     resultsCompression, resultsSharing,
+                                     resultsDictionary, resultsCompressionLevel,
+                                     resultsCompressionCPUBudget / 100.0,
+                                     resultsIndex);
                   assert(resultsWriter != nullptr);
                }
                if(ioModule == "UDP") {
                   pingParameters.SourcePort      = pingUDPSourcePort;
                   pingParameters.DestinationPort = pingUDPDestinationPort;
                }
+               else if(ioModule == "TCP") {
+                  pingParameters.SourcePort      = pingTCPSourcePort;
+                  pingParameters.DestinationPort = pingTCPDestinationPort;
+               }
                else {
                   pingParameters.SourcePort      = 0;
                   pingParameters.DestinationPort = 0;
                }
                Service* service = new Ping(ioModule,
-                                           resultsWriter, "Ping", (OutputFormatVersionType)resultsFormatVersion,
+                                           resultsWriter,
+                                           (pingParameters.SummaryInterval > 0) ? "PingSummary" : "Ping",
+                                           (OutputFormatVersionType)resultsFormatVersion,
                                            iterations, false,
                                            sourceAddress, destinationsForSource,
                                            pingParameters);
@@ -705,13 +881,20 @@ int main(int argc, char** argv)
                                      sourceAddress, "Traceroute-" + ioModule,
                                      resultsDirectory, resultsTransactionLength, resultsTimestampDepth,
                                      (pw != nullptr) ? pw->pw_uid : 0, (pw != nullptr) ? pw->pw_gid : 0,
-                                     resultsCompression);
+                                     resultsCompression, resultsSharing,
+                                     resultsDictionary, resultsCompressionLevel,
+                                     resultsCompressionCPUBudget / 100.0,
+                                     resultsIndex);
                   assert(resultsWriter != nullptr);
                }
                if(ioModule == "UDP") {
                   tracerouteParameters.SourcePort      = tracerouteUDPSourcePort;
                   tracerouteParameters.DestinationPort = tracerouteUDPDestinationPort;
                }
+               else if(ioModule == "TCP") {
+                  tracerouteParameters.SourcePort      = tracerouteTCPSourcePort;
+                  tracerouteParameters.DestinationPort = tracerouteTCPDestinationPort;
+               }
                else {
                   tracerouteParameters.SourcePort      = 0;
                   tracerouteParameters.DestinationPort = 0;
@@ -32,11 +32,15 @@
 #include "package-version.h"
 // #include "reader-jitter.h"
 #include "reader-ping.h"
+#include "reader-pingsummary.h"
 #include "reader-traceroute.h"
+#include "compressionpool.h"
 #include "universal-importer.h"
+#include "zstddictionary.h"
 
 #include <filesystem>
 #include <iostream>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
@@ -59,11 +63,15 @@ int main(int argc, char** argv)
    std::string           importFilePathFilter;
    bool                  quitWhenIdle;
    unsigned int          pingWorkers;
+   unsigned int          pingSummaryWorkers;
    unsigned int          tracerouteWorkers;
    // unsigned int          jitterWorkers;
    unsigned int          pingTransactionSize;
+   unsigned int          pingSummaryTransactionSize;
    unsigned int          tracerouteTransactionSize;
    // unsigned int          jitterTransactionSize;
+   std::vector<std::filesystem::path> zstdDictionaryFiles;
+   unsigned int          decompressionThreads;
 
    boost::program_options::options_description commandLineOptions;
    commandLineOptions.add_options()
@@ -100,6 +108,12 @@ int main(int argc, char** argv)
       ("quit-when-idle,Q",
           boost::program_options::value<bool>(&quitWhenIdle)->implicit_value(true)->default_value(false),
           "Quit importer when idle")
+      ("zstd-dictionary",
+          boost::program_options::value<std::vector<std::filesystem::path>>(&zstdDictionaryFiles),
+          "ZSTD dictionary file for results files")
+      ("decompression-threads",
+          boost::program_options::value<unsigned int>(&decompressionThreads)->default_value(0),
+          "Decompression threads, shared by all workers (0 = number of CPU cores)")
 
       ( "ping-workers",
            boost::program_options::value<unsigned int>(&pingWorkers)->default_value(1),
@@ -107,6 +121,12 @@ int main(int argc, char** argv)
       ( "ping-files",
            boost::program_options::value<unsigned int>(&pingTransactionSize)->default_value(1),
            "Number of Ping files per transaction" )
+      ( "pingsummary-workers",
+           boost::program_options::value<unsigned int>(&pingSummaryWorkers)->default_value(0),
+           "Number of Ping summary import worker threads (0 = disabled)" )
+      ( "pingsummary-files",
+           boost::program_options::value<unsigned int>(&pingSummaryTransactionSize)->default_value(1),
+           "Number of Ping summary files per transaction" )
       ( "traceroute-workers",
            boost::program_options::value<unsigned int>(&tracerouteWorkers)->default_value(1),
            "Number of Traceroute import worker threads" )
@@ -157,7 +177,7 @@ int main(int argc, char** argv)
       std::cerr << "ERROR: No database configuration file provided!\n";
       return 1;
    }
-   if(pingWorkers + tracerouteWorkers < 1) {
+   if(pingWorkers + pingSummaryWorkers + tracerouteWorkers < 1) {
       std::cerr << "ERROR: At least one worker is needed!\n";
       return 1;
    }
@@ -204,6 +224,19 @@ int main(int argc, char** argv)
    HPCT_LOG(info) << "Startup:\n" << importerConfiguration << databaseConfiguration;
    initialiseLogger(logLevel, logColor,
                     (!logFile.empty()) ? logFile.string().c_str() : nullptr);
+   for(const std::filesystem::path& zstdDictionaryFile : zstdDictionaryFiles) {
+      try {
+         const ZSTDDictionary* dictionary = ZSTDDictionary::loadDictionary(zstdDictionaryFile);
+         HPCT_LOG(info) << "Loaded ZSTD dictionary " << zstdDictionaryFile
+                        << " with ID " << dictionary->id();
+      }
+      catch(std::exception& e) {
+         HPCT_LOG(fatal) << "Cannot load ZSTD dictionary: " << e.what();
+         exit(1);
+      }
+   }
+
+   CompressionPool::configure(decompressionThreads);
 
    boost::asio::io_context ioContext;
    UniversalImporter importer(ioContext, importerConfiguration, databaseConfiguration);
@@ -230,6 +263,26 @@ int main(int argc, char** argv)
                          (DatabaseClientBase**)&pingDatabaseClients, pingWorkers);
    }
 
+   // ------ HiPerConTracer Ping Summary ------------------
+   DatabaseClientBase* pingSummaryDatabaseClients[pingSummaryWorkers];
+   PingSummaryReader*  pingSummaryReader = nullptr;
+   if(pingSummaryWorkers > 0) {
+      for(unsigned int i = 0; i < pingSummaryWorkers; i++) {
+         pingSummaryDatabaseClients[i] = databaseConfiguration.createClient();
+         assert(pingSummaryDatabaseClients[i] != nullptr);
+         if(!pingSummaryDatabaseClients[i]->open()) {
+            exit(1);
+         }
+      }
+      pingSummaryReader = new PingSummaryReader(importerConfiguration,
+                                                pingSummaryWorkers, pingSummaryTransactionSize,
+                                                importerConfiguration.getTableName(PingSummaryReader::Identification,
+                                                                                   PingSummaryReader::Identification));
+      assert(pingSummaryReader != nullptr);
+      importer.addReader(*pingSummaryReader,
+                         (DatabaseClientBase**)&pingSummaryDatabaseClients, pingSummaryWorkers);
+   }
+
    // ------ HiPerConTracer Traceroute --------------------
    DatabaseClientBase* tracerouteDatabaseClients[tracerouteWorkers];
    TracerouteReader*   tracerouteReader = nullptr;
@@ -303,6 +356,14 @@ int main(int argc, char** argv)
          tracerouteDatabaseClients[i] = nullptr;
       }
    }
+   if(pingSummaryWorkers > 0) {
+      delete pingSummaryReader;
+      pingSummaryReader = nullptr;
+      for(unsigned int i = 0; i < pingSummaryWorkers; i++) {
+         delete pingSummaryDatabaseClients[i];
+         pingSummaryDatabaseClients[i] = nullptr;
+      }
+   }
    if(pingWorkers > 0) {
       delete pingReader;
       pingReader = nullptr;
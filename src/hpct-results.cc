@@ -28,17 +28,23 @@
 // Contact: dreibh@simula.no
 
 #include "logger.h"
+#include "compressionpool.h"
 #include "conversions.h"
 #include "inputstream.h"
 #include "outputstream.h"
 #include "package-version.h"
+#include "resultsarchive.h"
+#include "resultsindex.h"
 #include "tools.h"
+#include "zstddictionary.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <mutex>
 #include <set>
@@ -111,6 +117,14 @@ struct InputFormat
    std::string String;
 };
 
+struct InputFilter
+{
+   unsigned long long       FromTimeStamp;   // 0 = no lower limit
+   unsigned long long       ToTimeStamp;     // 0 = no upper limit
+   std::string              Destination;     // Empty = all destinations
+   boost::asio::ip::address DestinationIP;
+};
+
 
 // ###### < operator for sorting ############################################
 // NOTE: find() will assume equality for: !(a < b) && !(b < a)
@@ -465,6 +479,7 @@ static bool dumpResultsFile(std::atomic<unsigned int>*
                             unsigned int&                                          columns,
                             const char                                             separator,
                             bool*                                                  foundFormat,
+                            const InputFilter*                                     filter,
                             const bool                                             checkOnly = false)
 {
    // ====== Open input stream ==============================================
@@ -489,14 +504,43 @@ static bool dumpResultsFile(std::atomic<unsigned int>*
    unsigned long long lineNumber = 0;
    OutputEntry*       newEntry   = nullptr;
    unsigned long long oldTimeStamp;   // Just used for version 1 conversion!
-   while(std::getline(inputStream, line, '\n')) {
-      lineNumber++;
+   TracerouteExpander      expander;     // Used for change-only Traceroute output
+   std::deque<std::string> expandedLines;
+   bool                    skipHops = false;   // Traceroute header has been filtered
+   while( (!expandedLines.empty()) || (std::getline(inputStream, line, '\n')) ) {
+      if(!expandedLines.empty()) {
+         line = std::move(expandedLines.front());
+         expandedLines.pop_front();
+      }
+      else {
+         lineNumber++;
+      }
 
       // ====== #<line> =====================================================
       if(line.size() < 2) {
          continue;
       }
-      else if(line[0] == '#') {
+
+      // ====== Expand unchanged Traceroute path to full record =============
+      if( (format.Type == InputType::IT_Traceroute) && (version >= 2) ) {
+         if( (line[0] == '#') && (line[1] == 'U') ) {
+            try {
+               expander.expand(line, expandedLines);
+            }
+            catch(const std::exception& e) {
+               HPCT_LOG(fatal) << "Unexpected input"
+                              << " in input file " << fileName << ", line " << lineNumber
+                              << ": " << e.what();
+               (*errorCounter)++;
+               return false;
+            }
+            continue;
+         }
+         expander.learn(line);
+      }
+
+      // ====== #<line> =====================================================
+      if(line[0] == '#') {
          if(version == 0) {
             if(!checkFormat(outputStream, outputMutex, fileName, format, version, columns, line, separator, foundFormat)) {
                (*errorCounter)++;
@@ -527,25 +571,28 @@ static bool dumpResultsFile(std::atomic<unsigned int>*
             const char*        value[maxColumns];
             size_t             length[maxColumns];
 
+            // NOTE: value[] and length[] only have space for maxColumns
+            //       entries. Further columns are not needed here.
             unsigned int i = 0;
             unsigned int c = 0;
             unsigned int l = 0;
             value[c] = linestr;
-            while(linestr[i] != 0x00) {
+            while( (linestr[i] != 0x00) && (c < maxColumns) ) {
                if(linestr[i] == ' ') {
                   length[c] = l;
                   c++;
-                  if(c >= maxColumns) {
-                     break;
+                  if(c < maxColumns) {
+                     value[c] = &linestr[i + 1];
                   }
-                  value[c] = &linestr[i + 1];
                   l = 0; i++;
                   continue;
                }
                l++; i++;
             }
-            length[c] = l;
-            c++;
+            if(c < maxColumns) {   // Length of the last column
+               length[c] = l;
+               c++;
+            }
 
             // ------ Create output entry --------------------------------
             if(c < maxColumns) {
@@ -580,7 +627,17 @@ static bool dumpResultsFile(std::atomic<unsigned int>*
 
             if(newEntry != nullptr) {
                delete newEntry;
+               newEntry = nullptr;
             }
+
+            // ====== Apply time and destination filter =====================
+            if( ( (filter->FromTimeStamp != 0) && (timeStamp <  filter->FromTimeStamp) ) ||
+                ( (filter->ToTimeStamp   != 0) && (timeStamp >= filter->ToTimeStamp) )   ||
+                ( (!filter->Destination.empty()) && (destinationIP != filter->DestinationIP) ) ) {
+               skipHops = true;
+               continue;
+            }
+            skipHops = false;
             newEntry = new OutputEntry(measurementID, sourceIP, destinationIP, timeStamp,
                                        roundNumber, line);
 
@@ -626,6 +683,10 @@ static bool dumpResultsFile(std::atomic<unsigned int>*
       else if(line[0] == '\t') {
 
          if(format.Type == InputType::IT_Traceroute) {
+            if(skipHops) {
+               continue;   // Hop of a filtered Traceroute
+            }
+
             // ------ Conversion from old versions -----------------------------
             try {
                if(version < 2) {
@@ -698,6 +759,69 @@ static bool dumpResultsFile(std::atomic<unsigned int>*
 
 
 
+// ###### Train ZSTD dictionary from results files #########################
+// Each results file is one sample, since the dictionary is meant to improve
+// the compression of small files from the start.
+static bool trainZSTDDictionary(const std::vector<std::filesystem::path>& inputFileNameList,
+                                const std::filesystem::path&              dictionaryFileName,
+                                const unsigned int                        maxDictionarySize)
+{
+   std::vector<std::string> samples;
+   samples.reserve(inputFileNameList.size());
+   for(const std::filesystem::path& inputFileName : inputFileNameList) {
+      try {
+         InputStream inputStream;
+         inputStream.openStream(inputFileName);
+         const std::string sample((std::istreambuf_iterator<char>(inputStream)),
+                                  std::istreambuf_iterator<char>());
+         if(inputStream.bad()) {
+            throw std::runtime_error("Read error");
+         }
+         samples.push_back(sample);
+      }
+      catch(std::exception& e) {
+         HPCT_LOG(fatal) << "Failed to read input file " << inputFileName << ": " << e.what();
+         return false;
+      }
+   }
+
+   HPCT_LOG(info) << "Training ZSTD dictionary from " << samples.size() << " files ...";
+   try {
+      const unsigned int id = ZSTDDictionary::trainDictionary(samples, dictionaryFileName,
+                                                              maxDictionarySize);
+      HPCT_LOG(info) << "Wrote ZSTD dictionary " << dictionaryFileName << " with ID " << id;
+   }
+   catch(std::exception& e) {
+      HPCT_LOG(fatal) << e.what();
+      return false;
+   }
+   return true;
+}
+
+
+// ###### List the members of results archives ##############################
+static bool listArchiveMembers(const std::vector<std::filesystem::path>& inputFileNameList,
+                               const char                                separator)
+{
+   bool success = true;
+   for(const std::filesystem::path& inputFileName : inputFileNameList) {
+      std::vector<ResultsArchiveMember> members;
+      if(!ResultsArchive::readMembers(inputFileName, members)) {
+         HPCT_LOG(error) << inputFileName << " is not a results archive with member index";
+         success = false;
+         continue;
+      }
+      for(const ResultsArchiveMember& member : members) {
+         std::cout << inputFileName.string() << separator
+                   << member.Offset          << separator
+                   << member.Size            << separator
+                   << member.Name            << "\n";
+      }
+   }
+   return success;
+}
+
+
 // ###### Main program ######################################################
 int main(int argc, char** argv)
 {
@@ -712,6 +836,15 @@ int main(int argc, char** argv)
    char                               separator;
    bool                               sorted;
    unsigned int                       maxThreads;
+   unsigned int                       decompressionThreads;
+   std::vector<std::filesystem::path> zstdDictionaryFiles;
+   std::filesystem::path              trainZSTDDictionaryFile;
+   unsigned int                       trainZSTDDictionarySize;
+   std::string                        fromTimeString;
+   std::string                        toTimeString;
+   std::string                        destinationString;
+   bool                               listMembers;
+   InputFilter                        filter { 0, 0 };
 
    // ====== Initialize =====================================================
    boost::program_options::options_description commandLineOptions;
@@ -740,6 +873,9 @@ int main(int argc, char** argv)
       ( "maxthreads,T",
            boost::program_options::value<unsigned int>(&maxThreads)->default_value(std::thread::hardware_concurrency()),
            "Maximum number of threads" )
+      ( "decompression-threads",
+           boost::program_options::value<unsigned int>(&decompressionThreads)->default_value(0),
+           "Decompression threads, shared by all input files (0 = number of CPU cores)" )
 
       ( "input-results-from-stdin,R",
            boost::program_options::value<bool>(&inputResultsFromStdin)->implicit_value(true)->default_value(false),
@@ -764,6 +900,29 @@ int main(int argc, char** argv)
       ( "unsorted,U",
            boost::program_options::value<bool>(&sorted)->implicit_value(false),
            "Unsorted results" )
+
+      ( "from-time",
+           boost::program_options::value<std::string>(&fromTimeString)->default_value(std::string()),
+           "Only results from the given time on (format: YYYY-MM-DD HH:MM:SS.NNNNNNNNN)" )
+      ( "to-time",
+           boost::program_options::value<std::string>(&toTimeString)->default_value(std::string()),
+           "Only results before the given time (format: YYYY-MM-DD HH:MM:SS.NNNNNNNNN)" )
+      ( "destination",
+           boost::program_options::value<std::string>(&destinationString)->default_value(std::string()),
+           "Only results for the given destination address" )
+      ( "list-archive-members",
+           boost::program_options::value<bool>(&listMembers)->implicit_value(true)->default_value(false),
+           "List the members of results archives" )
+
+      ( "zstd-dictionary",
+           boost::program_options::value<std::vector<std::filesystem::path>>(&zstdDictionaryFiles),
+           "ZSTD dictionary file for input files" )
+      ( "train-zstd-dictionary",
+           boost::program_options::value<std::filesystem::path>(&trainZSTDDictionaryFile)->default_value(std::filesystem::path()),
+           "Train ZSTD dictionary from input files, and write it to file" )
+      ( "train-zstd-dictionary-size",
+           boost::program_options::value<unsigned int>(&trainZSTDDictionarySize)->default_value(112640),
+           "Maximum size of the trained ZSTD dictionary in B" )
    ;
    boost::program_options::options_description hiddenOptions;
    hiddenOptions.add_options()
@@ -813,6 +972,32 @@ int main(int argc, char** argv)
    if(maxThreads < 1) {
       maxThreads = std::thread::hardware_concurrency();
    }
+   if(!fromTimeString.empty()) {
+      std::chrono::system_clock::time_point timePoint;
+      if(!(stringToTimePoint<std::chrono::system_clock::time_point>(fromTimeString, timePoint))) {
+         std::cerr << "ERROR: Bad from time stamp!\n";
+         return 1;
+      }
+      filter.FromTimeStamp = timePointToNanoseconds<std::chrono::system_clock::time_point>(timePoint);
+   }
+   if(!toTimeString.empty()) {
+      std::chrono::system_clock::time_point timePoint;
+      if(!(stringToTimePoint<std::chrono::system_clock::time_point>(toTimeString, timePoint))) {
+         std::cerr << "ERROR: Bad to time stamp!\n";
+         return 1;
+      }
+      filter.ToTimeStamp = timePointToNanoseconds<std::chrono::system_clock::time_point>(timePoint);
+   }
+   if(!destinationString.empty()) {
+      boost::system::error_code errorCode;
+      filter.DestinationIP = boost::asio::ip::make_address(destinationString, errorCode);
+      if(errorCode) {
+         std::cerr << "ERROR: Bad destination address " << destinationString << "!\n";
+         return 1;
+      }
+      // The index contains the addresses in their canonical form:
+      filter.Destination = filter.DestinationIP.to_string();
+   }
 
    if(inputResultsFromStdin) {
       inputFileNameList.clear();
@@ -844,6 +1029,10 @@ int main(int argc, char** argv)
          } while(!is.eof());
       }
    }
+   // Index files may be matched by wildcards for the results files:
+   inputFileNameList.erase(std::remove_if(inputFileNameList.begin(), inputFileNameList.end(),
+                                          ResultsIndex::isIndexFileName),
+                           inputFileNameList.end());
    if(inputFileNameList.size() == 0) {
       std::cerr << "No input files.\n";
       return 0;
@@ -852,6 +1041,60 @@ int main(int argc, char** argv)
    // ====== Initialize =====================================================
    initialiseLogger(logLevel, logColor,
                     (!logFile.empty()) ? logFile.string().c_str() : nullptr);
+   CompressionPool::configure(decompressionThreads);
+   for(const std::filesystem::path& zstdDictionaryFile : zstdDictionaryFiles) {
+      try {
+         ZSTDDictionary::loadDictionary(zstdDictionaryFile);
+      }
+      catch(std::exception& e) {
+         HPCT_LOG(fatal) << "Cannot load ZSTD dictionary: " << e.what();
+         exit(1);
+      }
+   }
+
+   // ====== Train ZSTD dictionary ==========================================
+   if(!trainZSTDDictionaryFile.empty()) {
+      return trainZSTDDictionary(inputFileNameList, trainZSTDDictionaryFile,
+                                 trainZSTDDictionarySize) ? 0 : 1;
+   }
+
+   // ====== List archive members ===========================================
+   if(listMembers) {
+      return listArchiveMembers(inputFileNameList, separator) ? 0 : 1;
+   }
+
+   // ====== Use index files to skip input files ============================
+   if(!inputResultsFromStdin) {
+      std::vector<std::filesystem::path> selectedInputFileNameList;
+      unsigned long long                 indexedFiles   = 0;
+      unsigned long long                 indexedRecords = 0;
+      selectedInputFileNameList.reserve(inputFileNameList.size());
+      for(const std::filesystem::path& inputFileName : inputFileNameList) {
+         ResultsIndex index;
+         if(index.readIndex(ResultsIndex::getIndexFileName(inputFileName))) {
+            indexedFiles++;
+            if( (!index.overlaps(filter.FromTimeStamp, filter.ToTimeStamp)) ||
+                ( (!filter.Destination.empty()) &&
+                  (!index.mayContainDestination(filter.Destination)) ) ) {
+               HPCT_LOG(debug) << "Skipping " << inputFileName << " according to its index";
+               continue;
+            }
+            indexedRecords += index.records();
+         }
+         selectedInputFileNameList.push_back(inputFileName);
+      }
+      if(indexedFiles > 0) {
+         HPCT_LOG(info) << "Index files: " << indexedFiles << " of "
+                        << inputFileNameList.size() << " input files, skipping "
+                        << (inputFileNameList.size() - selectedInputFileNameList.size())
+                        << " files, " << indexedRecords << " records in the remaining indexed files";
+      }
+      inputFileNameList.swap(selectedInputFileNameList);
+      if(inputFileNameList.size() == 0) {
+         HPCT_LOG(info) << "No input files with matching results.";
+         return 0;
+      }
+   }
 
    // ====== Open output stream =============================================
    OutputStream outputStream;
@@ -883,7 +1126,7 @@ int main(int argc, char** argv)
    bool foundFormat = false;
    if(!dumpResultsFile(&errorCounter, &lastTimeStamp,
                        (sorted == true) ? &outputSet : nullptr, &outputStream, &outputMutex,
-                       firstInputFileName, format, columns, separator, &foundFormat,
+                       firstInputFileName, format, columns, separator, &foundFormat, &filter,
                        inputResultsFromStdin ? false : true)) {
       exit(1);
    }
@@ -899,7 +1142,7 @@ int main(int argc, char** argv)
                         std::bind(dumpResultsFile,
                                   &errorCounter, &lastTimeStamp,
                                   (sorted == true) ? &outputSet : nullptr, &outputStream, &outputMutex,
-                                  inputFileName, format, columns, separator, &foundFormat,
+                                  inputFileName, format, columns, separator, &foundFormat, &filter,
                                   false));
    }
    threadPool.join();
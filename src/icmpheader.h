@@ -111,4 +111,31 @@ class ICMPHeader
    uint8_t Data[8];
 };
 
+
+
+// Read-only view on an ICMP header within a receive buffer, without copying.
+// valid() is only true if the buffer holds the complete header.
+class ICMPHeaderView
+{
+   public:
+   ICMPHeaderView(const uint8_t* data, const size_t length)
+      : Data((length >= 8) ? data : nullptr) { }
+
+   inline bool     valid()      const { return Data != nullptr; }
+   inline size_t   size()       const { return 8;               }
+
+   inline uint8_t  type()       const { return Data[0];      }
+   inline uint8_t  code()       const { return Data[1];      }
+   inline uint16_t checksum()   const { return decode(2, 3); }
+   inline uint16_t identifier() const { return decode(4, 5); }
+   inline uint16_t seqNumber()  const { return decode(6, 7); }
+
+   private:
+   inline uint16_t decode(const unsigned int a, const unsigned int b) const {
+      return ((uint16_t)Data[a] << 8) + Data[b];
+   }
+
+   const uint8_t* Data;
+};
+
 #endif
@@ -44,7 +44,9 @@ ImporterConfiguration::ImporterConfiguration()
       ("import_path_filter",   boost::program_options::value<std::string>(&ImportPathFilter)->default_value(std::string()), "import path filter")
       ("move_directory_depth", boost::program_options::value<unsigned int>(&MoveDirectoryDepth)->default_value(1),          "move directory depth")
       ("move_timestamp_depth", boost::program_options::value<unsigned int>(&MoveTimestampDepth)->default_value(3),          "move timestamp depth")
+      ("archive_bucket",       boost::program_options::value<unsigned int>(&ArchiveBucketLength)->default_value(86400),     "archive time bucket length (s)")
       ("import_file_path",     boost::program_options::value<std::filesystem::path>(&ImportFilePath),                       "path for input data")
+      ("import_journal_file",  boost::program_options::value<std::filesystem::path>(&ImportJournalFile),                    "journal of the import directory")
       ("bad_file_path",        boost::program_options::value<std::filesystem::path>(&BadFilePath),                          "path for bad files")
       ("good_file_path",       boost::program_options::value<std::filesystem::path>(&GoodFilePath),                         "path for good files")
       ("status_interval",      boost::program_options::value<unsigned int>(&StatusInterval)->default_value(60),             "status interval (s)")
@@ -96,12 +98,14 @@ bool ImporterConfiguration::readConfiguration(const std::filesystem::path& confi
    }
 
    // ====== Check options ==================================================
-   if(!setImportMode(ImportModeName))         return false;
-   if(!setImportMaxDepth(ImportMaxDepth))     return false;
-   if(!setImportPathFilter(ImportPathFilter)) return false;
-   if(!setImportFilePath(ImportFilePath))     return false;
-   if(!setGoodFilePath(GoodFilePath))         return false;
-   if(!setBadFilePath(BadFilePath))           return false;
+   if(!setImportMode(ImportModeName))               return false;
+   if(!setImportMaxDepth(ImportMaxDepth))           return false;
+   if(!setImportPathFilter(ImportPathFilter))       return false;
+   if(!setImportFilePath(ImportFilePath))           return false;
+   if(!setImportJournalFile(ImportJournalFile))     return false;
+   if(!setGoodFilePath(GoodFilePath))               return false;
+   if(!setBadFilePath(BadFilePath))                 return false;
+   if(!setArchiveBucketLength(ArchiveBucketLength)) return false;
    StatusInterval            = std::max(5U,  StatusInterval);
    GarbageCollectionInterval = std::max(10U, GarbageCollectionInterval);
    GarbageCollectionMaxAge   = std::max(60U, GarbageCollectionMaxAge);
@@ -135,6 +139,9 @@ bool ImporterConfiguration::setImportMode(const std::string& importModeName)
    else if(ImportModeName == "DeleteImportedFiles") {
       ImportMode = ImportModeType::DeleteImportedFiles;
    }
+   else if(ImportModeName == "CompactImportedFiles") {
+      ImportMode = ImportModeType::CompactImportedFiles;
+   }
    else {
       HPCT_LOG(error) << "Invalid import mode name " << ImportModeName;
       return false;
@@ -188,6 +195,26 @@ bool ImporterConfiguration::setImportFilePath(const std::filesystem::path& impor
 }
 
 
+// ###### Set import journal file ###########################################
+bool ImporterConfiguration::setImportJournalFile(const std::filesystem::path& importJournalFile)
+{
+   // An empty path disables the journal.
+   if(importJournalFile.empty()) {
+      ImportJournalFile.clear();
+      return true;
+   }
+   try {
+      ImportJournalFile = std::filesystem::absolute(importJournalFile);
+      if(std::filesystem::is_directory(ImportJournalFile.parent_path())) {
+         return true;
+      }
+   }
+   catch(std::filesystem::filesystem_error& e) { }
+   HPCT_LOG(error) << "Invalid or inaccessible import journal file " << ImportJournalFile;
+   return false;
+}
+
+
 // ###### Set good file path ################################################
 bool ImporterConfiguration::setGoodFilePath(const std::filesystem::path& goodFilePath)
 {
@@ -234,6 +261,18 @@ bool ImporterConfiguration::setMoveTimestampDepth(const unsigned int moveTimesta
 }
 
 
+// ###### Set archive time bucket length ###################################
+bool ImporterConfiguration::setArchiveBucketLength(const unsigned int archiveBucketLength)
+{
+   ArchiveBucketLength = archiveBucketLength;
+   if( (ArchiveBucketLength < 60) || (86400 % ArchiveBucketLength != 0) ) {
+      HPCT_LOG(error) << "Archive bucket length must be at least 60 s and divide a day!";
+      return false;
+   }
+   return true;
+}
+
+
 // ###### << operator #######################################################
 std::ostream& operator<<(std::ostream& os, const ImporterConfiguration& configuration)
 {
@@ -249,6 +288,9 @@ std::ostream& operator<<(std::ostream& os, const ImporterConfiguration& configur
       case DeleteImportedFiles:
          os << "DeleteImportedFiles";
        break;
+      case CompactImportedFiles:
+         os << "CompactImportedFiles";
+       break;
       default:
          abort();
        break;
@@ -256,10 +298,12 @@ std::ostream& operator<<(std::ostream& os, const ImporterConfiguration& configur
    os << "\n"
       << "  Import Filter         = " << configuration.ImportPathFilter          << "\n"
       << "  Import File Path      = " << configuration.ImportFilePath            << " (max depth: " << configuration.ImportMaxDepth << ")" << "\n"
+      << "  Import Journal File   = " << configuration.ImportJournalFile         << "\n"
       << "  Good File Path        = " << configuration.GoodFilePath              << "\n"
       << "  Bad File Path         = " << configuration.BadFilePath               << "\n"
       << "  Move Directory Depth  = " << configuration.MoveDirectoryDepth        << "\n"
       << "  Move Timestamp Depth  = " << configuration.MoveTimestampDepth        << "\n"
+      << "  Archive Bucket        = " << configuration.ArchiveBucketLength       << " s\n"
       << "  Status Interval       = " << configuration.StatusInterval            << " s\n"
       << "  Directory GC Interval = " << configuration.GarbageCollectionInterval << " s\n"
       << "  Directory GC Max Age  = " << configuration.GarbageCollectionMaxAge   << " s\n"
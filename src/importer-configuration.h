@@ -39,9 +39,10 @@
 
 
 enum ImportModeType {
-   KeepImportedFiles   = 0,   // Keep the files where they are
-   MoveImportedFiles   = 1,   // Move into "good file" directory
-   DeleteImportedFiles = 2    // Delete
+   KeepImportedFiles    = 0,   // Keep the files where they are
+   MoveImportedFiles    = 1,   // Move into "good file" directory
+   DeleteImportedFiles  = 2,   // Delete
+   CompactImportedFiles = 3    // Append to archive in "good file" directory
 };
 
 class ImporterConfiguration
@@ -54,10 +55,12 @@ class ImporterConfiguration
    inline unsigned int                 getImportMaxDepth()            const { return ImportMaxDepth;            }
    inline const std::string&           getImportPathFilter()          const { return ImportPathFilter;          }
    inline const std::filesystem::path& getImportFilePath()            const { return ImportFilePath;            }
+   inline const std::filesystem::path& getImportJournalFile()         const { return ImportJournalFile;         }
    inline const std::filesystem::path& getGoodFilePath()              const { return GoodFilePath;              }
    inline const std::filesystem::path& getBadFilePath()               const { return BadFilePath;               }
    inline unsigned int                 getMoveDirectoryDepth()        const { return MoveDirectoryDepth;        }
    inline unsigned int                 getMoveTimestampDepth()        const { return MoveTimestampDepth;        }
+   inline unsigned int                 getArchiveBucketLength()       const { return ArchiveBucketLength;       }
    inline unsigned int                 getGarbageCollectionInterval() const { return GarbageCollectionInterval; }
    inline unsigned int                 getGarbageCollectionMaxAge()   const { return GarbageCollectionMaxAge;   }
    inline unsigned int                 getStatusInterval()            const { return StatusInterval;            }
@@ -68,10 +71,12 @@ class ImporterConfiguration
    bool setImportMaxDepth(const unsigned int importMaxDepth);
    bool setImportPathFilter(const std::string& importPathFilter);
    bool setImportFilePath(const std::filesystem::path& importFilePath);
+   bool setImportJournalFile(const std::filesystem::path& importJournalFile);
    bool setGoodFilePath(const std::filesystem::path& goodFilePath);
    bool setBadFilePath(const std::filesystem::path& badFilePath);
    bool setMoveDirectoryDepth(const unsigned int moveDirectoryDepth);
    bool setMoveTimestampDepth(const unsigned int moveTimestampDepth);
+   bool setArchiveBucketLength(const unsigned int archiveBucketLength);
 
    bool readConfiguration(const std::filesystem::path& configurationFile);
 
@@ -86,7 +91,9 @@ class ImporterConfiguration
    std::string                                 ImportPathFilter;
    unsigned int                                MoveDirectoryDepth;
    unsigned int                                MoveTimestampDepth;
+   unsigned int                                ArchiveBucketLength;
    std::filesystem::path                       ImportFilePath;
+   std::filesystem::path                       ImportJournalFile;
    std::filesystem::path                       BadFilePath;
    std::filesystem::path                       GoodFilePath;
    std::vector<std::string>                    Tables;
@@ -28,18 +28,15 @@
 // Contact: dreibh@simula.no
 
 #include "inputstream.h"
+#include "compressionpool.h"
 
 #include <fcntl.h>
 
-#include <thread>
 #include <boost/iostreams/device/file_descriptor.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
-#include <boost/iostreams/filter/bzip2.hpp>
-#include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filter/lzma.hpp>
 #include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filter/zstd.hpp>
 
 
 // ###### Constructor #######################################################
@@ -93,21 +90,18 @@ bool InputStream::openStream(const std::filesystem::path& fileName,
          Compressor = obtainCompressorFromExtension(FileName);
       }
       switch(Compressor) {
-         case CT_XZ: {
-            const boost::iostreams::lzma_params params(
-               boost::iostreams::lzma::default_compression,
-               std::thread::hardware_concurrency());
-            push(boost::iostreams::lzma_decompressor(params));
-           }
+         case CT_XZ:
+            // No decoder threads per stream: concurrent streams would
+            // oversubscribe the machine.
+            push(boost::iostreams::lzma_decompressor());
           break;
          case CT_BZip2:
-            push(boost::iostreams::bzip2_decompressor());
-          break;
          case CT_GZip:
-            push(boost::iostreams::gzip_decompressor());
-          break;
          case CT_ZSTD:
-            push(boost::iostreams::zstd_decompressor());
+            // Independent blocks/members/frames are decoded in parallel by
+            // the process-wide compression pool. A ZSTD dictionary is
+            // selected by the ID in the frame, if there is one.
+            push(ParallelDecompressor(Compressor));
           break;
          case CT_ZLIB:
             push(boost::iostreams::zlib_decompressor());
@@ -49,9 +49,11 @@
 
 #include "iomodule-icmp.h"
 #include "iomodule-udp.h"
+#include "iomodule-tcp.h"
 
 REGISTER_IOMODULE(ProtocolType::PT_ICMP, "ICMP", ICMPModule);
 REGISTER_IOMODULE(ProtocolType::PT_UDP,  "UDP",   UDPModule);
+REGISTER_IOMODULE(ProtocolType::PT_TCP,  "TCP",   TCPModule);
 
 //  #########################################################################
 
@@ -36,8 +36,6 @@
 #include "ipv6header.h"
 #include "traceserviceheader.h"
 
-#include <boost/interprocess/streams/bufferstream.hpp>
-
 #ifdef __linux__
 #include <linux/errqueue.h>
 #endif
@@ -627,24 +625,23 @@ void ICMPModule::updateSendTimeInResultEntry(const sock_extended_err* socketErro
 void ICMPModule::handlePayloadResponse(const int     socketDescriptor,
                                        ReceivedData& receivedData)
 {
-   // ====== Handle ICMP header =============================================
-   boost::interprocess::bufferstream is(receivedData.MessageBuffer,
-                                        receivedData.MessageLength);
+   // NOTE: The headers are not copied out of the message buffer. Instead,
+   //       the views read the fields directly, after a bounds check.
+   const uint8_t* data   = (const uint8_t*)receivedData.MessageBuffer;
+   const size_t   length = receivedData.MessageLength;
 
    // ------ IPv6 -----------------------------------------------------------
-   ICMPHeader icmpHeader;
    if(SourceAddress.is_v6()) {
-      is >> icmpHeader;
-      if(is) {
+      const ICMPHeaderView icmpHeader(data, length);
+      if(icmpHeader.valid()) {
 
          // ------ IPv6 -> ICMPv6[Echo Reply] -------------------------------
-         if( (icmpHeader.type() == ICMP6_ECHO_REPLY) &&
-             (icmpHeader.identifier() == Identifier) ) {
-            // ------ TraceServiceHeader ------------------------------------
-            TraceServiceHeader tsHeader;
-            is >> tsHeader;
-            if(is) {
-               if(tsHeader.magicNumber() == MagicNumber) {
+         if(icmpHeader.type() == ICMP6_ECHO_REPLY) {
+            if(icmpHeader.identifier() == Identifier) {
+               // ------ TraceServiceHeader ---------------------------------
+               const TraceServiceHeaderView tsHeader(data + icmpHeader.size(),
+                                                     length - icmpHeader.size());
+               if( (tsHeader.valid()) && (tsHeader.magicNumber() == MagicNumber) ) {
                   // This is ICMP payload checked by the kernel =>
                   // not setting receivedData.Source and receivedData.Destination here!
                   recordResult(receivedData,
@@ -658,20 +655,25 @@ void ICMPModule::handlePayloadResponse(const int     socketDescriptor,
          // ------ IPv6 -> ICMPv6[Error] ------------------------------------
          else if( (icmpHeader.type() == ICMP6_TIME_EXCEEDED) ||
                   (icmpHeader.type() == ICMP6_DST_UNREACH) ) {
-            IPv6Header innerIPv6Header;
-            ICMPHeader innerICMPHeader;
-            TraceServiceHeader tsHeader;
-            is >> innerIPv6Header >> innerICMPHeader >> tsHeader;
-            if( (is) &&
-                (innerIPv6Header.nextHeader() == IPPROTO_ICMPV6) &&
-                (innerICMPHeader.identifier() == Identifier) &&
-                (tsHeader.magicNumber() == MagicNumber) ) {
-               receivedData.Source      = boost::asio::ip::udp::endpoint(innerIPv6Header.sourceAddress(), 0);
-               receivedData.Destination = boost::asio::ip::udp::endpoint(innerIPv6Header.destinationAddress(), 0);
-               recordResult(receivedData,
-                            icmpHeader.type(), icmpHeader.code(),
-                            innerICMPHeader.seqNumber(),
-                            40 + receivedData.MessageLength);
+            const size_t innerOffset = icmpHeader.size();
+            const IPv6HeaderView innerIPv6Header(data + innerOffset, length - innerOffset);
+            if( (innerIPv6Header.valid()) &&
+                (innerIPv6Header.nextHeader() == IPPROTO_ICMPV6) ) {
+               const size_t innerICMPOffset = innerOffset + innerIPv6Header.size();
+               const ICMPHeaderView innerICMPHeader(data + innerICMPOffset, length - innerICMPOffset);
+               if( (innerICMPHeader.valid()) &&
+                   (innerICMPHeader.identifier() == Identifier) ) {
+                  const size_t tsOffset = innerICMPOffset + innerICMPHeader.size();
+                  const TraceServiceHeaderView tsHeader(data + tsOffset, length - tsOffset);
+                  if( (tsHeader.valid()) && (tsHeader.magicNumber() == MagicNumber) ) {
+                     receivedData.Source      = boost::asio::ip::udp::endpoint(innerIPv6Header.sourceAddress(), 0);
+                     receivedData.Destination = boost::asio::ip::udp::endpoint(innerIPv6Header.destinationAddress(), 0);
+                     recordResult(receivedData,
+                                  icmpHeader.type(), icmpHeader.code(),
+                                  innerICMPHeader.seqNumber(),
+                                  40 + receivedData.MessageLength);
+                  }
+               }
             }
          }
 
@@ -681,48 +683,52 @@ void ICMPModule::handlePayloadResponse(const int     socketDescriptor,
    // ------ IPv4 -----------------------------------------------------------
    else {
       // NOTE: For IPv4, also the IPv4 header of the message is included!
-      IPv4Header ipv4Header;
-      is >> ipv4Header;
-      if( (is) && (ipv4Header.protocol() == IPPROTO_ICMP) ) {
-         is >> icmpHeader;
-         if(is) {
+      const IPv4HeaderView ipv4Header(data, length);
+      if( (ipv4Header.valid()) && (ipv4Header.protocol() == IPPROTO_ICMP) ) {
+         const size_t icmpOffset = ipv4Header.size();
+         const ICMPHeaderView icmpHeader(data + icmpOffset, length - icmpOffset);
+         if(icmpHeader.valid()) {
 
             // ------ IPv4 -> ICMP[Echo Reply] ------------------------------
-            if( (icmpHeader.type() == ICMP_ECHOREPLY) &&
-                (icmpHeader.identifier() == Identifier) ) {
-               // ------ TraceServiceHeader ---------------------------------
-               TraceServiceHeader tsHeader;
-               is >> tsHeader;
-               if( (is) && (tsHeader.magicNumber() == MagicNumber) ) {
-                  // NOTE: This is the reponse
-                  //       -> source and destination are swapped!
-                  receivedData.Source      = boost::asio::ip::udp::endpoint(ipv4Header.destinationAddress(), 0);
-                  receivedData.Destination = boost::asio::ip::udp::endpoint(ipv4Header.sourceAddress(), 0);
-                  recordResult(receivedData,
-                               icmpHeader.type(), icmpHeader.code(),
-                               icmpHeader.seqNumber(),
-                               receivedData.MessageLength);
+            if(icmpHeader.type() == ICMP_ECHOREPLY) {
+               if(icmpHeader.identifier() == Identifier) {
+                  // ------ TraceServiceHeader ------------------------------
+                  const size_t tsOffset = icmpOffset + icmpHeader.size();
+                  const TraceServiceHeaderView tsHeader(data + tsOffset, length - tsOffset);
+                  if( (tsHeader.valid()) && (tsHeader.magicNumber() == MagicNumber) ) {
+                     // NOTE: This is the reponse
+                     //       -> source and destination are swapped!
+                     receivedData.Source      = boost::asio::ip::udp::endpoint(ipv4Header.destinationAddress(), 0);
+                     receivedData.Destination = boost::asio::ip::udp::endpoint(ipv4Header.sourceAddress(), 0);
+                     recordResult(receivedData,
+                                  icmpHeader.type(), icmpHeader.code(),
+                                  icmpHeader.seqNumber(),
+                                  receivedData.MessageLength);
+                  }
                }
             }
 
             // ------ IPv4 -> ICMP[Error] -----------------------------------
             else if( (icmpHeader.type() == ICMP_TIMXCEED) ||
                      (icmpHeader.type() == ICMP_UNREACH) ) {
-               IPv4Header innerIPv4Header;
-               ICMPHeader innerICMPHeader;
-               is >> innerIPv4Header >> innerICMPHeader;
-               if( (is) &&
-                   (innerIPv4Header.protocol() == IPPROTO_ICMP) &&
-                   (innerICMPHeader.identifier() == Identifier) ) {
-                  // Unfortunately, ICMPv4 does not return the full
-                  // TraceServiceHeader here! So, the sequence number
-                  // has to be used to identify the outgoing request!
-                  receivedData.Source      = boost::asio::ip::udp::endpoint(innerIPv4Header.sourceAddress(), 0);
-                  receivedData.Destination = boost::asio::ip::udp::endpoint(innerIPv4Header.destinationAddress(), 0);
-                  recordResult(receivedData,
-                               icmpHeader.type(), icmpHeader.code(),
-                               innerICMPHeader.seqNumber(),
-                               receivedData.MessageLength);
+               const size_t innerOffset = icmpOffset + icmpHeader.size();
+               const IPv4HeaderView innerIPv4Header(data + innerOffset, length - innerOffset);
+               if( (innerIPv4Header.valid()) &&
+                   (innerIPv4Header.protocol() == IPPROTO_ICMP) ) {
+                  const size_t innerICMPOffset = innerOffset + innerIPv4Header.size();
+                  const ICMPHeaderView innerICMPHeader(data + innerICMPOffset, length - innerICMPOffset);
+                  if( (innerICMPHeader.valid()) &&
+                      (innerICMPHeader.identifier() == Identifier) ) {
+                     // Unfortunately, ICMPv4 does not return the full
+                     // TraceServiceHeader here! So, the sequence number
+                     // has to be used to identify the outgoing request!
+                     receivedData.Source      = boost::asio::ip::udp::endpoint(innerIPv4Header.sourceAddress(), 0);
+                     receivedData.Destination = boost::asio::ip::udp::endpoint(innerIPv4Header.destinationAddress(), 0);
+                     recordResult(receivedData,
+                                  icmpHeader.type(), icmpHeader.code(),
+                                  innerICMPHeader.seqNumber(),
+                                  receivedData.MessageLength);
+                  }
                }
             }
 
@@ -0,0 +1,538 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#include "iomodule-tcp.h"
+#include "assure.h"
+#include "tools.h"
+#include "logger.h"
+#include "icmpheader.h"
+#include "ipv4header.h"
+#include "ipv6header.h"
+#include "internet16.h"
+#include "tcpheader.h"
+
+#ifdef __linux__
+#include <linux/errqueue.h>
+#endif
+
+
+// NOTE: The registration was moved to iomodule-base.cc, due to linking issues!
+// REGISTER_IOMODULE(ProtocolType::PT_TCP, "TCP", TCPModule);
+
+
+// ###### Constructor #######################################################
+TCPModule::TCPModule(boost::asio::io_context&                 ioContext,
+                     std::map<unsigned short, ResultEntry*>&  resultsMap,
+                     const boost::asio::ip::address&          sourceAddress,
+                     const uint16_t                           sourcePort,
+                     const uint16_t                           destinationPort,
+                     std::function<void (const ResultEntry*)> newResultCallback,
+                     const unsigned int                       packetSize)
+   : ICMPModule(ioContext, resultsMap, sourceAddress, sourcePort, destinationPort,
+                newResultCallback,
+                packetSize),
+     RawTCPSocket(IOContext, (sourceAddress.is_v6() == true) ? raw_tcp::v6() :
+                                                               raw_tcp::v4() ),
+     TCPSocket(IOContext, (sourceAddress.is_v6() == true) ? boost::asio::ip::tcp::v6() :
+                                                            boost::asio::ip::tcp::v4() )
+{
+   // Overhead: IPv4 Header (20)/IPv6 Header (40) + TCP Header (20)
+   // NOTE: The SYN probes do not carry any payload, i.e. the packet size
+   //       setting is ignored here!
+   PayloadSize      = 0;
+   ActualPacketSize = ((SourceAddress.is_v6() == true) ? 40 : 20) + 20;
+}
+
+
+// ###### Destructor ########################################################
+TCPModule::~TCPModule()
+{
+}
+
+
+// ###### Prepare TCP socket ################################################
+bool TCPModule::prepareSocket()
+{
+   // ====== Prepare ICMP socket ============================================
+   if(!ICMPModule::prepareSocket()) {
+      return false;
+   }
+
+   // ====== Bind TCP socket to given source address ========================
+   boost::system::error_code      errorCode;
+   boost::asio::ip::tcp::endpoint tcpSourceEndpoint(SourceAddress, SourcePort);
+   TCPSocket.bind(tcpSourceEndpoint, errorCode);
+   if(errorCode != boost::system::errc::success) {
+      HPCT_LOG(error) << getName() << ": Unable to bind TCP socket to source address "
+                      << tcpSourceEndpoint << "!";
+      return false;
+   }
+   TCPSocketEndpoint = TCPSocket.local_endpoint();
+   FlowPorts.assign(1, TCPSocketEndpoint.port());
+
+   // ====== Bind TCP raw socket to given source address ====================
+   raw_tcp::endpoint tcpRawSourceEndpoint(SourceAddress, 0);
+   RawTCPSocket.bind(tcpRawSourceEndpoint, errorCode);
+   if(errorCode != boost::system::errc::success) {
+      HPCT_LOG(error) << getName() << ": Unable to bind raw TCP socket to source address "
+                      << tcpRawSourceEndpoint << "!";
+      return false;
+   }
+
+   // ====== Configure sockets (timestamping, etc.) =========================
+   if(!configureSocket(RawTCPSocket.native_handle(), SourceAddress)) {
+      return false;
+   }
+   int on = 1;
+   if(SourceAddress.is_v6() == true) {
+#if defined(IPV6_HDRINCL)
+      if(setsockopt(RawTCPSocket.native_handle(), IPPROTO_IPV6, IPV6_HDRINCL, &on, sizeof(on)) < 0) {
+         HPCT_LOG(error) << "Unable to enable IPV6_HDRINCL option on socket: "
+                         << strerror(errno);
+         return false;
+      }
+#endif
+   }
+   else {
+#if defined(IP_HDRINCL)
+      if(setsockopt(RawTCPSocket.native_handle(), IPPROTO_IP, IP_HDRINCL, &on, sizeof(on)) < 0) {
+         HPCT_LOG(error) << "Unable to enable IP_HDRINCL option on socket: "
+                         << strerror(errno);
+         return false;
+      }
+#endif
+   }
+
+   // ====== Await incoming message or error ================================
+   expectNextReply(RawTCPSocket.native_handle(), true);
+   expectNextReply(RawTCPSocket.native_handle(), false);
+
+   return true;
+}
+
+
+// // ###### Expect next message ############################################
+void TCPModule::expectNextReply(const int  socketDescriptor,
+                                const bool readFromErrorQueue)
+{
+   if(socketDescriptor == RawTCPSocket.native_handle()) {
+      RawTCPSocket.async_wait(
+         (readFromErrorQueue == true) ?
+            boost::asio::ip::tcp::socket::wait_error :
+            boost::asio::ip::tcp::socket::wait_read,
+         std::bind(&ICMPModule::handleResponse, this,
+                   std::placeholders::_1,
+                   RawTCPSocket.native_handle(), readFromErrorQueue)
+      );
+   }
+   else {
+      ICMPModule::expectNextReply(socketDescriptor, readFromErrorQueue);
+   }
+}
+
+
+// ###### Cancel socket operations ##########################################
+void TCPModule::cancelSocket()
+{
+   RawTCPSocket.cancel();
+   ICMPModule::cancelSocket();
+}
+
+
+// ###### Get source port of a flow #########################################
+uint16_t TCPModule::getFlowPort(const unsigned int flow)
+{
+   // ====== Reserve source ports of further flows ==========================
+   // With a given source port p, flow f uses port p + f. Otherwise, the
+   // ports are allocated automatically.
+   while(FlowPorts.size() <= flow) {
+      const uint16_t port = (SourcePort != 0) ? (uint16_t)(SourcePort + FlowPorts.size()) : 0;
+      std::unique_ptr<boost::asio::ip::tcp::socket> socket(
+         new boost::asio::ip::tcp::socket(IOContext, (SourceAddress.is_v6() == true) ?
+                                                        boost::asio::ip::tcp::v6() :
+                                                        boost::asio::ip::tcp::v4()));
+      boost::system::error_code      errorCode;
+      boost::asio::ip::tcp::endpoint tcpSourceEndpoint(SourceAddress, port);
+      socket->bind(tcpSourceEndpoint, errorCode);
+      if(errorCode != boost::system::errc::success) {
+         HPCT_LOG(warning) << getName() << ": Unable to bind TCP socket to source address "
+                           << tcpSourceEndpoint << " -> using " << FlowPorts.size()
+                           << " flows only!";
+         break;
+      }
+      FlowPorts.push_back(socket->local_endpoint().port());
+      FlowSockets.push_back(std::move(socket));
+   }
+   return FlowPorts[flow % FlowPorts.size()];
+}
+
+
+// ###### Send TCP SYN requests to given destination ########################
+unsigned int TCPModule::sendRequest(const DestinationInfo& destination,
+                                    const unsigned int     fromTTL,
+                                    const unsigned int     toTTL,
+                                    const unsigned int     fromRound,
+                                    const unsigned int     toRound,
+                                    uint16_t&              seqNumber,
+                                    uint32_t*              targetChecksumArray)
+{
+   // NOTE:
+   // - RawTCPSocket is used for sending the raw TCP SYN segments, as well as
+   //   for receiving the SYN+ACK or RST responses.
+   // - TCPSocket just reserves the source port. It is bound to the source
+   //   address and source port, but never connected or listening.
+   // - Traceroute asks for a new flow in each round, by a target checksum
+   //   of ~0U (see ICMPModule::sendRequest()). Then, each round uses the
+   //   source port of its flow. Otherwise (e.g. Ping), all rounds use
+   //   the same flow.
+   // - If SourceAddress is the ANY address: find the actual source address
+   const raw_tcp::endpoint remoteEndpoint(destination.address(),
+                                          SourceAddress.is_v6() ? 0 : DestinationPort);
+   const raw_tcp::endpoint localEndpoint((TCPSocketEndpoint.address().is_unspecified() ?
+                                            findSourceForDestination(destination.address()) :
+                                            TCPSocketEndpoint.address()),
+                                         TCPSocketEndpoint.port());
+
+   // ====== Get source ports of the flows ==================================
+   uint16_t flowPortArray[1 + (toRound - fromRound)];
+   for(unsigned int round = fromRound; round <= toRound; round++) {
+      flowPortArray[round - fromRound] =
+         (targetChecksumArray[round] == ~0U) ? getFlowPort(round % MaxFlows) :
+                                               localEndpoint.port();
+   }
+
+   // ====== Prepare TCP header =============================================
+   TCPHeader tcpHeader;
+   tcpHeader.destinationPort(DestinationPort);
+   tcpHeader.ackNumber(0);
+   tcpHeader.dataOffset(20);
+   tcpHeader.flags(TCPFlag_SYN);
+   tcpHeader.window(65535);
+   tcpHeader.urgentPointer(0);
+
+   // ====== Prepare IP header ==============================================
+   IPv6Header       ipv6Header;
+   IPv4Header       ipv4Header;
+   IPv6PseudoHeader ipv6PseudoHeader;
+   IPv4PseudoHeader ipv4PseudoHeader;
+   if(SourceAddress.is_v6()) {
+      ipv6Header.version(6);
+      ipv6Header.trafficClass(destination.trafficClass());
+      ipv6Header.flowLabel(0);
+      ipv6Header.payloadLength(tcpHeader.size());
+      ipv6Header.nextHeader(IPPROTO_TCP);
+      ipv6Header.sourceAddress(localEndpoint.address().to_v6());
+      ipv6Header.destinationAddress(destination.address().to_v6());
+
+      ipv6PseudoHeader = IPv6PseudoHeader(ipv6Header, tcpHeader.size());
+   }
+   else {
+      ipv4Header.version(4);
+      ipv4Header.typeOfService(destination.trafficClass());
+      ipv4Header.headerLength(20);
+      ipv4Header.totalLength(ActualPacketSize);
+      ipv4Header.fragmentOffset(0);
+      ipv4Header.protocol(IPPROTO_TCP);
+      ipv4Header.sourceAddress(localEndpoint.address().to_v4());
+      ipv4Header.destinationAddress(destination.address().to_v4());
+
+      ipv4PseudoHeader = IPv4PseudoHeader(ipv4Header, tcpHeader.size());
+   }
+
+   // ====== Message scatter/gather array ===================================
+#if defined(IP_HDRINCL) && defined(IPV6_HDRINCL)
+   const std::array<boost::asio::const_buffer, 2> buffer {
+      SourceAddress.is_v6() ? boost::asio::buffer(ipv6Header.data(), ipv6Header.size()) :
+                              boost::asio::buffer(ipv4Header.data(), ipv4Header.size()),
+      boost::asio::buffer(tcpHeader.data(), tcpHeader.size())
+   };
+#else
+   // NOTE:
+   // IP_HDRINCL and/or IPV6_HDRINCL is not available: This means that it is
+   // not possible to explicitly set the source IP address in the header here.
+   // This includes the TCP Pseudo Header for the checksum computation!
+   // Therefore, the TCPSocketEndpoint must be bound to a fixed IP address.
+   // (by option: --source <address>)
+   std::vector<boost::asio::const_buffer> buffer;
+   if(SourceAddress.is_v6()) {
+      buffer = {
+#if defined(IPV6_HDRINCL)
+         boost::asio::buffer(ipv6Header.data(), ipv6Header.size()),
+#endif
+         boost::asio::buffer(tcpHeader.data(),  tcpHeader.size())
+      };
+#if !defined(IPV6_HDRINCL)
+      if(localEndpoint.address() != TCPSocketEndpoint.address()) {
+         HPCT_LOG(error) << "Cannot set source IPv6 address without IPV6_HDRINCL! Explicitly set source address!\n"
+                         << "localEndpoint="     << localEndpoint.address()     << "\n"
+                         << "TCPSocketEndpoint=" << TCPSocketEndpoint.address() << "\n";
+         return 0;
+      }
+#endif
+   }
+   else {
+      buffer = {
+#if defined(IP_HDRINCL)
+         boost::asio::buffer(ipv4Header.data(), ipv4Header.size()),
+#endif
+         boost::asio::buffer(tcpHeader.data(),  tcpHeader.size())
+      };
+#if !defined(IP_HDRINCL)
+      if(localEndpoint.address() != TCPSocketEndpoint.address()) {
+         HPCT_LOG(error) << "Cannot set source IPv4 address without IP_HDRINCL! Explicitly set source address!\n"
+                         << "localEndpoint="     << localEndpoint.address()     << "\n"
+                         << "TCPSocketEndpoint=" << TCPSocketEndpoint.address() << "\n";
+         return 0;
+      }
+#endif
+   }
+#endif
+
+   // ====== Prepare ResultEntry array ======================================
+   const unsigned int        entries      = (1 + (toRound -fromRound)) * (1 + (fromTTL -toTTL));
+   unsigned int              currentEntry = 0;
+   ResultEntry*              resultEntryArray[entries];
+   boost::system::error_code errorCodeArray[entries];
+   std::size_t               sentArray[entries];
+   for(unsigned int i = 0; i < entries; i++) {
+      resultEntryArray[i] = new ResultEntry;
+   }
+
+   // ====== Sender loop ====================================================
+   assure(fromRound <= toRound);
+   assure(fromTTL >= toTTL);
+   unsigned int messagesSent = 0;
+   // ------ BEGIN OF TIMING-CRITICAL PART ----------------------------------
+   for(unsigned int round = fromRound; round <= toRound; round++) {
+      for(int ttl = (int)fromTTL; ttl >= (int)toTTL; ttl--) {
+         assure(currentEntry < entries);
+         seqNumber++;   // New sequence number!
+
+         // ====== Update IP header =========================================
+         if(SourceAddress.is_v6()) {
+            ipv6Header.hopLimit(ttl);
+         }
+         else {
+            ipv4Header.timeToLive(ttl);
+            ipv4Header.identification(seqNumber);
+            ipv4Header.headerChecksum(0);
+         }
+
+         // ====== Update TCP header ========================================
+         // NOTE: Using the TCP sequence number for sequence number, round
+         //       and TTL. It is quoted by ICMP errors and acknowledged by
+         //       SYN+ACK or RST responses.
+         tcpHeader.sourcePort(flowPortArray[round - fromRound]);
+         tcpHeader.seqNumber(makeTCPSeqNumber(seqNumber, round, ttl));
+         tcpHeader.checksum(0);
+
+         // ====== Compute checksums ========================================
+         uint32_t tcpChecksum = 0;
+         tcpHeader.computeInternet16(tcpChecksum);
+         if(SourceAddress.is_v6()) {
+            ipv6PseudoHeader.computeInternet16(tcpChecksum);
+         }
+         else {
+            ipv4PseudoHeader.computeInternet16(tcpChecksum);
+
+            uint32_t ipv4HeaderChecksum = 0;
+            ipv4Header.computeInternet16(ipv4HeaderChecksum);
+            ipv4Header.headerChecksum(finishInternet16(ipv4HeaderChecksum));
+         }
+         tcpHeader.checksum(finishInternet16(tcpChecksum));
+
+         // ====== Send the request =========================================
+         const ResultTimePoint sendTime = nowInUTC<ResultTimePoint>();
+         sentArray[currentEntry] =
+            RawTCPSocket.send_to(buffer, remoteEndpoint, 0, errorCodeArray[currentEntry]);
+
+         // ====== Store message information ================================
+         resultEntryArray[currentEntry]->initialise(
+            TimeStampSeqID,
+            round, seqNumber, ttl, ActualPacketSize,
+            0, flowPortArray[round - fromRound], DestinationPort,
+            sendTime,
+            localEndpoint.address(), destination, Unknown
+         );
+         if( (!errorCodeArray[currentEntry]) && (sentArray[currentEntry] > 0) ) {
+            TimeStampSeqID++;
+            messagesSent++;
+         }
+
+         currentEntry++;
+      }
+   }
+   // ------ END OF TIMING-CRITICAL PART ------------------------------------
+   assure(currentEntry == entries);
+
+   // ====== Check results ==================================================
+   for(unsigned int i = 0; i < entries; i++) {
+      std::pair<std::map<unsigned short, ResultEntry*>::iterator, bool> result =
+         ResultsMap.insert(std::pair<unsigned short, ResultEntry*>(
+                              resultEntryArray[i]->seqNumber(),
+                              resultEntryArray[i]));
+      assure(result.second == true);
+      if( (errorCodeArray[i]) || (sentArray[i] <= 0) ) {
+         resultEntryArray[i]->failedToSend(errorCodeArray[i]);
+         HPCT_LOG(debug) << getName() << ": sendRequest() - send_to("
+                         << localEndpoint.address() << "->" << destination << ") failed: "
+                         << errorCodeArray[i].message();
+      }
+   }
+
+   return messagesSent;
+}
+
+
+// ###### Handle payload response (i.e. not from error queue) ###############
+void TCPModule::handlePayloadResponse(const int     socketDescriptor,
+                                      ReceivedData& receivedData)
+{
+   const uint8_t* data   = (const uint8_t*)receivedData.MessageBuffer;
+   const size_t   length = receivedData.MessageLength;
+
+   // ====== TCP response ===================================================
+   if(socketDescriptor == RawTCPSocket.native_handle()) {
+      // NOTE: For IPv4, also the IPv4 header of the message is included!
+      const IPv4HeaderView ipv4Header(data, length);
+      size_t tcpOffset = 0;
+      if(!SourceAddress.is_v6()) {
+         if( (!ipv4Header.valid()) || (ipv4Header.protocol() != IPPROTO_TCP) ) {
+            return;
+         }
+         tcpOffset = ipv4Header.size();
+      }
+
+      // ------ TCP SYN+ACK or RST ------------------------------------------
+      const TCPHeaderView tcpHeader(data + tcpOffset, length - tcpOffset);
+      if( (tcpHeader.valid()) &&
+          (tcpHeader.sourcePort()      == DestinationPort) &&
+          (isFlowPort(tcpHeader.destinationPort())) &&
+          (tcpHeader.flags() & TCPFlag_ACK) &&
+          (tcpHeader.flags() & (TCPFlag_SYN|TCPFlag_RST)) ) {
+         if(!SourceAddress.is_v6()) {
+            receivedData.Source      = boost::asio::ip::udp::endpoint(ipv4Header.destinationAddress(), tcpHeader.destinationPort());
+            receivedData.Destination = boost::asio::ip::udp::endpoint(ipv4Header.sourceAddress(),      tcpHeader.sourcePort());
+         }
+         else {
+            // NOTE: For IPv6, the IPv6 header is not included. The local
+            // address is the bound source address (:: if unspecified, which
+            // recordResult() does not check).
+            receivedData.Source      = boost::asio::ip::udp::endpoint(SourceAddress,                          tcpHeader.destinationPort());
+            receivedData.Destination = boost::asio::ip::udp::endpoint(receivedData.ReplyEndpoint.address(), tcpHeader.sourcePort());
+         }
+         recordResult(receivedData, 0, 0,
+                      getSeqNumberFromTCPSeqNumber(tcpHeader.ackNumber() - 1),
+                      ((SourceAddress.is_v6()) ? 40 : 0) + receivedData.MessageLength);
+      }
+   }
+
+   // ====== ICMP error response ============================================
+   else if(socketDescriptor == ICMPSocket.native_handle()) {
+
+      // ------ IPv6 --------------------------------------------------------
+      if(SourceAddress.is_v6()) {
+         const ICMPHeaderView icmpHeader(data, length);
+         if(icmpHeader.valid()) {
+
+            // ------ IPv6 -> ICMPv6[Error] ---------------------------------
+            if( (icmpHeader.type() == ICMP6_TIME_EXCEEDED) ||
+                (icmpHeader.type() == ICMP6_DST_UNREACH) ) {
+               // ------ IPv6 -> ICMPv6[Error] -> IPv6 ----------------------
+               const size_t innerOffset = icmpHeader.size();
+               const IPv6HeaderView innerIPv6Header(data + innerOffset, length - innerOffset);
+               if( (innerIPv6Header.valid()) && (innerIPv6Header.nextHeader() == IPPROTO_TCP) ) {
+                  // NOTE: Addresses will be checked by recordResult()!
+                  // ------ IPv6 -> ICMPv6[Error] -> IPv6 -> TCP ------------
+                  const size_t tcpOffset = innerOffset + innerIPv6Header.size();
+                  const TCPHeaderView tcpHeader(data + tcpOffset, length - tcpOffset, true);
+                  if( (tcpHeader.valid()) &&
+                      (isFlowPort(tcpHeader.sourcePort())) &&
+                      (tcpHeader.destinationPort() == DestinationPort) ) {
+                     receivedData.Source      = boost::asio::ip::udp::endpoint(innerIPv6Header.sourceAddress(),      tcpHeader.sourcePort());
+                     receivedData.Destination = boost::asio::ip::udp::endpoint(innerIPv6Header.destinationAddress(), tcpHeader.destinationPort());
+                     recordResult(receivedData,
+                                  icmpHeader.type(), icmpHeader.code(),
+                                  getSeqNumberFromTCPSeqNumber(tcpHeader.seqNumber()),
+                                  receivedData.MessageLength);
+                  }
+               }
+            }
+
+         }
+      }
+
+      // ------ IPv4 --------------------------------------------------------
+      else {
+         // NOTE: For IPv4, also the IPv4 header of the message is included!
+         const IPv4HeaderView ipv4Header(data, length);
+         if( (ipv4Header.valid()) && (ipv4Header.protocol() == IPPROTO_ICMP) ) {
+            const size_t icmpOffset = ipv4Header.size();
+            const ICMPHeaderView icmpHeader(data + icmpOffset, length - icmpOffset);
+            if(icmpHeader.valid()) {
+
+               // ------ IPv4 -> ICMP[Error] --------------------------------
+               if( (icmpHeader.type() == ICMP_TIMXCEED) ||
+                   (icmpHeader.type() == ICMP_UNREACH) ) {
+                  // ------ IPv4 -> ICMP[Error] -> IPv4 ---------------------
+                  const size_t innerOffset = icmpOffset + icmpHeader.size();
+                  const IPv4HeaderView innerIPv4Header(data + innerOffset, length - innerOffset);
+                  if( (innerIPv4Header.valid()) && (innerIPv4Header.protocol() == IPPROTO_TCP) ) {
+                     // NOTE: Addresses will be checked by recordResult()!
+                     // ------ IPv4 -> ICMP[Error] -> IPv4 -> TCP ------------
+                     const size_t tcpOffset = innerOffset + innerIPv4Header.size();
+                     const TCPHeaderView tcpHeader(data + tcpOffset, length - tcpOffset, true);
+                     if( (tcpHeader.valid()) &&
+                         (isFlowPort(tcpHeader.sourcePort())) &&
+                         (tcpHeader.destinationPort() == DestinationPort) ) {
+                        receivedData.Source      = boost::asio::ip::udp::endpoint(innerIPv4Header.sourceAddress(),      tcpHeader.sourcePort());
+                        receivedData.Destination = boost::asio::ip::udp::endpoint(innerIPv4Header.destinationAddress(), tcpHeader.destinationPort());
+                        recordResult(receivedData,
+                                     icmpHeader.type(), icmpHeader.code(),
+                                     getSeqNumberFromTCPSeqNumber(tcpHeader.seqNumber()),
+                                     receivedData.MessageLength);
+                     }
+                  }
+               }
+
+            }
+         }
+      }
+
+   }
+}
+
+
+// ###### Handle error response (i.e. from error queue) #####################
+void TCPModule::handleErrorResponse(const int          socketDescriptor,
+                                    ReceivedData&      receivedData,
+                                    sock_extended_err* socketError)
+{
+   // Nothing to do here!
+}
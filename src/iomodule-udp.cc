@@ -38,8 +38,6 @@
 #include "udpheader.h"
 #include "traceserviceheader.h"
 
-#include <boost/interprocess/streams/bufferstream.hpp>
-
 #ifdef __linux__
 #include <linux/errqueue.h>
 #endif
@@ -386,15 +384,14 @@ unsigned int UDPModule::sendRequest(const DestinationInfo& destination,
 void UDPModule::handlePayloadResponse(const int     socketDescriptor,
                                       ReceivedData& receivedData)
 {
-   boost::interprocess::bufferstream is(receivedData.MessageBuffer,
-                                        receivedData.MessageLength);
+   const uint8_t* data   = (const uint8_t*)receivedData.MessageBuffer;
+   const size_t   length = receivedData.MessageLength;
 
    // ====== UDP response ===================================================
    if(socketDescriptor == UDPSocket.native_handle()) {
       // ------ TraceServiceHeader ------------------------------------------
-      TraceServiceHeader tsHeader;
-      is >> tsHeader;
-      if( (is) && (tsHeader.magicNumber() == MagicNumber) ) {
+      const TraceServiceHeaderView tsHeader(data, length);
+      if( (tsHeader.valid()) && (tsHeader.magicNumber() == MagicNumber) ) {
          recordResult(receivedData, 0, 0, tsHeader.seqNumber(),
                       ((SourceAddress.is_v6()) ? 40 + 8 : 20 + 8 ) + receivedData.MessageLength);
       }
@@ -404,31 +401,30 @@ void UDPModule::handlePayloadResponse(const int     socketDescriptor,
    else if(socketDescriptor == ICMPSocket.native_handle()) {
 
       // ------ IPv6 --------------------------------------------------------
-      ICMPHeader icmpHeader;
       if(SourceAddress.is_v6()) {
-         is >> icmpHeader;
-         if(is) {
+         const ICMPHeaderView icmpHeader(data, length);
+         if(icmpHeader.valid()) {
 
             // ------ IPv6 -> ICMPv6[Error] ---------------------------------
             if( (icmpHeader.type() == ICMP6_TIME_EXCEEDED) ||
                 (icmpHeader.type() == ICMP6_DST_UNREACH) ) {
                // ------ IPv6 -> ICMPv6[Error] -> IPv6 ----------------------
-               IPv6Header innerIPv6Header;
-               is >> innerIPv6Header;
-               if( (is) && (innerIPv6Header.nextHeader() == IPPROTO_UDP) ) {
+               const size_t innerOffset = icmpHeader.size();
+               const IPv6HeaderView innerIPv6Header(data + innerOffset, length - innerOffset);
+               if( (innerIPv6Header.valid()) && (innerIPv6Header.nextHeader() == IPPROTO_UDP) ) {
                   // NOTE: Addresses will be checked by recordResult()!
                   // ------ IPv6 -> ICMPv6[Error] -> IPv6 -> UDP ------------
-                  UDPHeader udpHeader;
-                  is >> udpHeader;
-                  if( (is) &&
+                  const size_t udpOffset = innerOffset + innerIPv6Header.size();
+                  const UDPHeaderView udpHeader(data + udpOffset, length - udpOffset);
+                  if( (udpHeader.valid()) &&
                      (udpHeader.sourcePort()      == UDPSocketEndpoint.port()) &&
                      (udpHeader.destinationPort() == DestinationPort) ) {
-                     receivedData.Source      = boost::asio::ip::udp::endpoint(innerIPv6Header.sourceAddress(),      udpHeader.sourcePort());
-                     receivedData.Destination = boost::asio::ip::udp::endpoint(innerIPv6Header.destinationAddress(), udpHeader.destinationPort());
                      // ------ TraceServiceHeader ---------------------------
-                     TraceServiceHeader tsHeader;
-                     is >> tsHeader;
-                     if( (is) && (tsHeader.magicNumber() == MagicNumber) ) {
+                     const size_t tsOffset = udpOffset + udpHeader.size();
+                     const TraceServiceHeaderView tsHeader(data + tsOffset, length - tsOffset);
+                     if( (tsHeader.valid()) && (tsHeader.magicNumber() == MagicNumber) ) {
+                        receivedData.Source      = boost::asio::ip::udp::endpoint(innerIPv6Header.sourceAddress(),      udpHeader.sourcePort());
+                        receivedData.Destination = boost::asio::ip::udp::endpoint(innerIPv6Header.destinationAddress(), udpHeader.destinationPort());
                         recordResult(receivedData,
                                      icmpHeader.type(), icmpHeader.code(),
                                      tsHeader.seqNumber(),
@@ -444,24 +440,24 @@ void UDPModule::handlePayloadResponse(const int     socketDescriptor,
       // ------ IPv4 --------------------------------------------------------
       else {
          // NOTE: For IPv4, also the IPv4 header of the message is included!
-         IPv4Header ipv4Header;
-         is >> ipv4Header;
-         if( (is) && (ipv4Header.protocol() == IPPROTO_ICMP) ) {
-            is >> icmpHeader;
-            if(is) {
+         const IPv4HeaderView ipv4Header(data, length);
+         if( (ipv4Header.valid()) && (ipv4Header.protocol() == IPPROTO_ICMP) ) {
+            const size_t icmpOffset = ipv4Header.size();
+            const ICMPHeaderView icmpHeader(data + icmpOffset, length - icmpOffset);
+            if(icmpHeader.valid()) {
 
                // ------ IPv4 -> ICMP[Error] --------------------------------
                if( (icmpHeader.type() == ICMP_TIMXCEED) ||
                    (icmpHeader.type() == ICMP_UNREACH) ) {
                   // ------ IPv4 -> ICMP[Error] -> IPv4 ---------------------
-                  IPv4Header innerIPv4Header;
-                  is >> innerIPv4Header;
-                  if( (is) && (innerIPv4Header.protocol() == IPPROTO_UDP) ) {
+                  const size_t innerOffset = icmpOffset + icmpHeader.size();
+                  const IPv4HeaderView innerIPv4Header(data + innerOffset, length - innerOffset);
+                  if( (innerIPv4Header.valid()) && (innerIPv4Header.protocol() == IPPROTO_UDP) ) {
                      // NOTE: Addresses will be checked by recordResult()!
                      // ------ IPv4 -> ICMP[Error] -> IPv4 -> UDP ------------
-                     UDPHeader udpHeader;
-                     is >> udpHeader;
-                     if( (is) &&
+                     const size_t udpOffset = innerOffset + innerIPv4Header.size();
+                     const UDPHeaderView udpHeader(data + udpOffset, length - udpOffset);
+                     if( (udpHeader.valid()) &&
                          (udpHeader.sourcePort()      == UDPSocketEndpoint.port()) &&
                          (udpHeader.destinationPort() == DestinationPort) ) {
                         receivedData.Source      = boost::asio::ip::udp::endpoint(innerIPv4Header.sourceAddress(),      udpHeader.sourcePort());
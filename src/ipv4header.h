@@ -160,6 +160,48 @@ class IPv4Header
 };
 
 
+// Read-only view on an IPv4 header within a receive buffer, without copying.
+// valid() is only true if the buffer holds the complete header.
+class IPv4HeaderView
+{
+   public:
+   IPv4HeaderView(const uint8_t* data, const size_t length)
+      : Data( ( (length >= 20) &&
+                (((data[0] >> 4) & 0x0f) == 4) &&
+                ((size_t)(data[0] & 0x0f) * 4 >= 20) &&
+                ((size_t)(data[0] & 0x0f) * 4 <= length) ) ? data : nullptr) { }
+
+   inline bool     valid()          const { return Data != nullptr;       }
+   inline size_t   size()           const { return headerLength();        }
+
+   inline uint8_t  version()        const { return (Data[0] >> 4) & 0x0f; }
+   inline uint16_t headerLength()   const { return (Data[0] & 0x0f) * 4;  }
+   inline uint8_t  typeOfService()  const { return Data[1];               }
+   inline uint16_t totalLength()    const { return decode(2, 3);          }
+   inline uint16_t identification() const { return decode(4, 5);          }
+   inline uint8_t  timeToLive()     const { return Data[8];               }
+   inline uint8_t  protocol()       const { return Data[9];               }
+
+   inline boost::asio::ip::address_v4 sourceAddress() const {
+      const boost::asio::ip::address_v4::bytes_type bytes =
+         { { Data[12], Data[13], Data[14], Data[15] } };
+      return boost::asio::ip::address_v4(bytes);
+    }
+   inline boost::asio::ip::address_v4 destinationAddress() const {
+      const boost::asio::ip::address_v4::bytes_type bytes =
+         { { Data[16], Data[17], Data[18], Data[19] } };
+      return boost::asio::ip::address_v4(bytes);
+   }
+
+   private:
+   inline uint16_t decode(const unsigned int a, const unsigned int b) const {
+      return ((uint16_t)Data[a] << 8) + Data[b];
+   }
+
+   const uint8_t* Data;
+};
+
+
 class IPv4PseudoHeader
 {
    public:
@@ -154,6 +154,44 @@ class IPv6Header
 };
 
 
+// Read-only view on an IPv6 header within a receive buffer, without copying.
+// valid() is only true if the buffer holds the complete header.
+class IPv6HeaderView
+{
+   public:
+   IPv6HeaderView(const uint8_t* data, const size_t length)
+      : Data( ( (length >= 40) &&
+                (((data[0] >> 4) & 0x0f) == 6) ) ? data : nullptr) { }
+
+   inline bool     valid()         const { return Data != nullptr;                                   }
+   inline size_t   size()          const { return 40;                                                }
+
+   inline uint8_t  version()       const { return (Data[0] >> 4) & 0x0f;                             }
+   inline uint8_t  trafficClass()  const { return ((Data[0] & 0x0f) << 4) | ((Data[1] >> 4) & 0x0f); }
+   inline uint16_t payloadLength() const { return decode(4, 5); }
+   inline uint8_t  nextHeader()    const { return Data[6];      }
+   inline uint32_t hopLimit()      const { return Data[7];      }
+
+   inline boost::asio::ip::address_v6 sourceAddress() const {
+      boost::asio::ip::address_v6::bytes_type v6address;
+      memcpy(v6address.data(), &Data[8], 16);
+      return boost::asio::ip::address_v6(v6address, 0);
+   }
+   inline boost::asio::ip::address_v6 destinationAddress() const {
+      boost::asio::ip::address_v6::bytes_type v6address;
+      memcpy(v6address.data(), &Data[24], 16);
+      return boost::asio::ip::address_v6(v6address, 0);
+   }
+
+   private:
+   inline uint16_t decode(const unsigned int a, const unsigned int b) const {
+      return ((uint16_t)Data[a] << 8) + Data[b];
+   }
+
+   const uint8_t* Data;
+};
+
+
 class IPv6PseudoHeader
 {
    public:
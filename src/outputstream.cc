@@ -28,26 +28,217 @@
 // Contact: dreibh@simula.no
 
 #include "outputstream.h"
+#include "compressionpool.h"
 
 #include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h>
 
-#include <thread>
-#include <boost/iostreams/device/file_descriptor.hpp>
+#include <cstring>
+
+#include <boost/iostreams/categories.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
-#include <boost/iostreams/filter/bzip2.hpp>
-#include <boost/iostreams/filter/gzip.hpp>
-#include <boost/iostreams/filter/lzma.hpp>
 #include <boost/iostreams/filter/zlib.hpp>
-#include <boost/iostreams/filter/zstd.hpp>
+
+
+// ==========================================================================
+// File sink with a large, aligned output buffer.
+//
+// The output is collected in a page-aligned buffer, i.e. a file is written
+// by few large write() calls instead of one call per stream buffer. On
+// Linux, the file is preallocated to the size of the previous file of the
+// stream, and the written data is handed to the writeback by
+// sync_file_range() every WritebackSize bytes. So, the dirty pages of a
+// large file do not pile up until the kernel's writeback starts.
+// ==========================================================================
+
+class OutputFileSink
+{
+   public:
+   typedef char char_type;
+   struct category : public boost::iostreams::sink_tag,
+                     public boost::iostreams::closable_tag { };
+
+   OutputFileSink(const int                handle,
+                  const size_t             bufferSize,
+                  const size_t             writebackSize,
+                  const unsigned long long preallocationSize);
+
+   std::streamsize write(const char* data, std::streamsize size);
+   void finish();
+   void close();
+
+   inline unsigned long long bytesWritten() const {
+      return State->Written + State->BufferUsed;
+   }
+
+   private:
+   struct SinkState {
+      SinkState(const int handle, const size_t bufferSize, const size_t writebackSize);
+      ~SinkState();
+
+      void writeBuffer();
+      void closeHandle();
+
+      int                Handle;
+      bool               Failed;
+      char*              Buffer;
+      const size_t       BufferSize;
+      size_t             BufferUsed;
+      const size_t       WritebackSize;
+      unsigned long long Written;
+      unsigned long long WrittenBack;
+   };
+   std::shared_ptr<SinkState> State;
+};
+
+
+// ###### Constructor #######################################################
+OutputFileSink::SinkState::SinkState(const int    handle,
+                                     const size_t bufferSize,
+                                     const size_t writebackSize)
+   : Handle(handle),
+     BufferSize(bufferSize),
+     WritebackSize(writebackSize)
+{
+   Failed      = false;
+   BufferUsed  = 0;
+   Written     = 0;
+   WrittenBack = 0;
+   void* buffer;
+   if(posix_memalign(&buffer, 4096, BufferSize) != 0) {
+      ::close(Handle);
+      throw std::bad_alloc();
+   }
+   Buffer = (char*)buffer;
+}
+
+
+// ###### Destructor ########################################################
+OutputFileSink::SinkState::~SinkState()
+{
+   closeHandle();
+   free(Buffer);
+}
+
+
+// ###### Write buffer to the file ##########################################
+void OutputFileSink::SinkState::writeBuffer()
+{
+   size_t position = 0;
+   while(position < BufferUsed) {
+      const ssize_t result = ::write(Handle, &Buffer[position], BufferUsed - position);
+      if(result < 0) {
+         if(errno == EINTR) {
+            continue;
+         }
+         throw std::ios_base::failure(std::string("Write failed: ") + strerror(errno));
+      }
+      position += (size_t)result;
+   }
+   Written   += BufferUsed;
+   BufferUsed = 0;
+
+#ifdef SYNC_FILE_RANGE_WRITE
+   // ====== Start writeback of the data written so far =====================
+   // This only initiates the writeback, i.e. it does not wait.
+   if( (WritebackSize > 0) && (Written - WrittenBack >= WritebackSize) ) {
+      sync_file_range(Handle, WrittenBack, Written - WrittenBack, SYNC_FILE_RANGE_WRITE);
+      WrittenBack = Written;
+   }
+#endif
+}
+
+
+// ###### Close file handle #################################################
+void OutputFileSink::SinkState::closeHandle()
+{
+   if(Handle >= 0) {
+      ::close(Handle);
+      Handle = -1;
+   }
+}
+
+
+// ###### Constructor #######################################################
+OutputFileSink::OutputFileSink(const int                handle,
+                               const size_t             bufferSize,
+                               const size_t             writebackSize,
+                               const unsigned long long preallocationSize)
+   : State(std::make_shared<SinkState>(handle, bufferSize, writebackSize))
+{
+#ifdef __linux__
+   // ====== Preallocate the expected file size =============================
+   // Files of the same stream usually have similar sizes. Errors are
+   // ignored, since not all file systems support fallocate().
+   // The file is truncated to the written size by finish().
+   if(preallocationSize > 0) {
+      fallocate(handle, 0, 0, (off_t)preallocationSize);
+   }
+#endif
+}
+
+
+// ###### Write data ########################################################
+std::streamsize OutputFileSink::write(const char* data, std::streamsize size)
+{
+   std::streamsize position = 0;
+   while(position < size) {
+      const size_t chunk = std::min((size_t)(size - position),
+                                    State->BufferSize - State->BufferUsed);
+      memcpy(&State->Buffer[State->BufferUsed], data + position, chunk);
+      State->BufferUsed += chunk;
+      position          += (std::streamsize)chunk;
+      if(State->BufferUsed >= State->BufferSize) {
+         State->writeBuffer();
+      }
+   }
+   return size;
+}
+
+
+// ###### Truncate to the written size ######################################
+// This is called after the stream has been closed, i.e. after all data has
+// been written.
+void OutputFileSink::finish()
+{
+   if(State->Failed) {
+      throw std::ios_base::failure("Write failed");
+   }
+
+   // ====== Remove the rest of the preallocated space ======================
+   if(ftruncate(State->Handle, (off_t)State->Written) != 0) {
+      throw std::ios_base::failure(std::string("Truncate failed: ") + strerror(errno));
+   }
+}
+
+
+// ###### Close sink ########################################################
+// The stream closes the sink after the filters have written their final
+// data. The file handle is kept open for finish().
+void OutputFileSink::close()
+{
+   try {
+      State->writeBuffer();
+   }
+   catch(std::exception& e) {
+      State->Failed = true;
+   }
+}
+
+
+
+size_t OutputStream::ConfiguredBufferSize    = OutputStream::DefaultBufferSize;
+size_t OutputStream::ConfiguredWritebackSize = OutputStream::DefaultWritebackSize;
 
 
 // ###### Constructor #######################################################
 OutputStream::OutputStream()
 {
-   Sink       = nullptr;
-   Compressor = CT_None;
+   Sink         = nullptr;
+   Compressor   = CT_None;
+   LastFileSize = 0;
 }
 
 
@@ -58,6 +249,15 @@ OutputStream::~OutputStream()
 }
 
 
+// ###### Configure output buffering (before opening streams) ##############
+void OutputStream::configure(const size_t bufferSize,
+                             const size_t writebackSize)
+{
+   ConfiguredBufferSize    = std::max((size_t)4096, bufferSize);
+   ConfiguredWritebackSize = writebackSize;
+}
+
+
 // ###### Initialise output stream to std::ostream ##########################
 bool OutputStream::openStream(std::ostream& os)
 {
@@ -69,7 +269,9 @@ bool OutputStream::openStream(std::ostream& os)
 
 // ###### Initialise output stream to output file ###########################
 bool OutputStream::openStream(const std::filesystem::path& fileName,
-                              const CompressorType         compressor)
+                              const CompressorType         compressor,
+                              const ZSTDDictionary*        dictionary,
+                              const int                    level)
 {
    // ====== Reset ==========================================================
    closeStream(false);
@@ -77,6 +279,7 @@ bool OutputStream::openStream(const std::filesystem::path& fileName,
    // ====== Initialise output steam to file ================================
    Compressor = compressor;
    FileName   = fileName;
+   Statistics.reset();
    if(FileName != std::filesystem::path()) {
       TmpFileName = FileName.string() + ".tmp";
 
@@ -93,7 +296,8 @@ bool OutputStream::openStream(const std::filesystem::path& fileName,
 #ifdef POSIX_FADV_SEQUENTIAL
       posix_fadvise(handle, 0, 0, POSIX_FADV_SEQUENTIAL|POSIX_FADV_NOREUSE);
 #endif
-      Sink = new boost::iostreams::file_descriptor_sink(handle, boost::iostreams::file_descriptor_flags::close_handle);
+      Sink = new OutputFileSink(handle, ConfiguredBufferSize, ConfiguredWritebackSize,
+                                LastFileSize);
       assert(Sink != nullptr);
 
       // ------ Configure the compressor ------------------------------------
@@ -101,24 +305,18 @@ bool OutputStream::openStream(const std::filesystem::path& fileName,
          Compressor = obtainCompressorFromExtension(FileName);
       }
       switch(Compressor) {
-         case CT_XZ: {
-            const boost::iostreams::lzma_params params(
-               boost::iostreams::lzma::default_compression,
-               std::thread::hardware_concurrency());
-            push(boost::iostreams::lzma_compressor(params));
-           }
-          break;
+         case CT_XZ:
          case CT_BZip2:
-            push(boost::iostreams::bzip2_compressor());
-          break;
          case CT_GZip:
-            push(boost::iostreams::gzip_compressor());
-          break;
          case CT_ZSTD:
-            push(boost::iostreams::zstd_compressor());
+            // Compressed in blocks by the process-wide compression pool
+            Statistics = std::make_shared<CompressionStatistics>();
+            push(PooledCompressor(Compressor,
+                                  (Compressor == CT_ZSTD) ? dictionary : nullptr,
+                                  level, Statistics));
           break;
          case CT_ZLIB:
-            push(boost::iostreams::zlib_compressor());
+            push(boost::iostreams::zlib_compressor(getCompressionLevel(CT_ZLIB, level)));
           break;
          default:
           break;
@@ -150,8 +348,18 @@ void OutputStream::closeStream(const bool sync)
 
    // ====== Close file =====================================================
    reset();
+   std::string error;
    if(Sink) {
-      Sink->close();
+      if(success) {
+         try {
+            Sink->finish();
+            LastFileSize = Sink->bytesWritten();
+         }
+         catch(std::exception& e) {
+            error   = e.what();
+            success = false;
+         }
+      }
       delete Sink;
       Sink = nullptr;
    }
@@ -169,4 +377,7 @@ void OutputStream::closeStream(const bool sync)
    // ====== Clean up =======================================================
    FileName    = std::filesystem::path();
    TmpFileName = std::filesystem::path();
+   if(!error.empty()) {
+      throw std::runtime_error(error);
+   }
 }
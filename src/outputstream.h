@@ -32,10 +32,16 @@
 
 #include "compressortype.h"
 
-#include <boost/iostreams/device/file_descriptor.hpp>
+#include <memory>
+
 #include <boost/iostreams/filtering_stream.hpp>
 
 
+struct CompressionStatistics;
+class OutputFileSink;
+class ZSTDDictionary;
+
+
 class OutputStream : public boost::iostreams::filtering_ostream
 {
 
@@ -45,14 +51,33 @@ class OutputStream : public boost::iostreams::filtering_ostream
 
    bool openStream(std::ostream& os);
    bool openStream(const std::filesystem::path& fileName,
-                   const CompressorType         compressor = CT_FromExtension);
+                   const CompressorType         compressor = CT_FromExtension,
+                   const ZSTDDictionary*        dictionary = nullptr,
+                   const int                    level      = 0);
    void closeStream(const bool sync = true);
 
+   static const size_t DefaultBufferSize    = 256 * 1024;
+   static const size_t DefaultWritebackSize = 4 * 1024 * 1024;
+
+   static void configure(const size_t bufferSize,
+                         const size_t writebackSize);
+
+   // Statistics of the compression pool for the current (or last closed)
+   // file, or nullptr if the compressor does not use the pool:
+   inline const CompressionStatistics* compressionStatistics() const {
+      return Statistics.get();
+   }
+
    private:
    std::filesystem::path                   FileName;
    std::filesystem::path                   TmpFileName;
-   boost::iostreams::file_descriptor_sink* Sink;
+   OutputFileSink*                         Sink;
    CompressorType                          Compressor;
+   std::shared_ptr<CompressionStatistics>  Statistics;
+   unsigned long long                      LastFileSize;
+
+   static size_t                           ConfiguredBufferSize;
+   static size_t                           ConfiguredWritebackSize;
 };
 
 #endif
@@ -72,6 +72,16 @@ const std::string& Ping::getName() const
 }
 
 
+// ###### Run the service ###################################################
+void Ping::run()
+{
+   Traceroute::run();
+
+   // ====== Write the remaining, possibly incomplete, summary windows ======
+   flushPingSummaries(true);
+}
+
+
 // ###### Prepare a new run #################################################
 bool Ping::prepareRun(const bool newRound)
 {
@@ -221,7 +231,12 @@ void Ping::processResults()
          if(ResultCallback) {
             ResultCallback(this, resultEntry);
          }
-         writePingResultEntry(resultEntry);
+         if(Parameters.SummaryInterval > 0) {
+            updatePingSummary(resultEntry);
+         }
+         else {
+            writePingResultEntry(resultEntry);
+         }
       }
 
       // ====== Remove completed entries ====================================
@@ -235,6 +250,11 @@ void Ping::processResults()
       }
    }
 
+   // ====== Write completed summary windows ================================
+   if(Parameters.SummaryInterval > 0) {
+      flushPingSummaries(false);
+   }
+
    // ====== Handle "remove destination after run" option ===================
    if(RemoveDestinationAfterRun == true) {
       std::lock_guard<std::recursive_mutex> lock(DestinationMutex);
@@ -370,3 +390,129 @@ void Ping::writePingResultEntry(const ResultEntry* resultEntry,
                       % hw;
    }
 }
+
+
+// ###### Add Ping result entry to its summary window #######################
+void Ping::updatePingSummary(const ResultEntry* resultEntry)
+{
+   // ====== Find summary window ============================================
+   const std::chrono::seconds interval(Parameters.SummaryInterval);
+   const ResultTimePoint      sendTime    = resultEntry->sendTime(TXTimeStampType::TXTST_Application);
+   const ResultTimePoint      windowStart = sendTime - (sendTime.time_since_epoch() % interval);
+   const PingSummaryKey       key(windowStart, resultEntry->destination());
+
+   std::map<PingSummaryKey, PingSummary>::iterator found = PingSummaries.find(key);
+   if(found == PingSummaries.end()) {
+      found = PingSummaries.emplace(key, PingSummary {
+                 resultEntry->sourceAddress(),
+                 resultEntry->packetSize(),
+                 resultEntry->sourcePort(),
+                 resultEntry->destinationPort(),
+                 0, 0, 0, 0,
+                 DDSketch() }).first;
+   }
+   PingSummary& summary = found->second;
+
+   // ====== Update counters and RTT sketch =================================
+   summary.Sent++;
+   if(resultEntry->status() == Success) {
+      unsigned int         timeSource;
+      const ResultDuration rtt = resultEntry->obtainMostAccurateRTT(RXTimeStampType::RXTST_ReceptionSW,
+                                                                    timeSource);
+      summary.Received++;
+      summary.RTTSketch.add(std::chrono::duration_cast<std::chrono::nanoseconds>(rtt).count());
+   }
+   else if(resultEntry->status() == Timeout) {
+      summary.Lost++;
+   }
+   else {
+      summary.Errors++;
+   }
+}
+
+
+// ###### Write completed summary windows ###################################
+void Ping::flushPingSummaries(const bool all)
+{
+   // A window is complete when its end plus the expiration timeout has
+   // passed, since late responses may still arrive until then.
+   const ResultTimePoint now = ResultClock::now();
+   const ResultDuration  hold =
+      std::chrono::seconds(Parameters.SummaryInterval) +
+      std::chrono::milliseconds(Parameters.Expiration);
+
+   std::map<PingSummaryKey, PingSummary>::iterator iterator = PingSummaries.begin();
+   while(iterator != PingSummaries.end()) {
+      if( (!all) && (iterator->first.first + hold > now) ) {
+         // The map is sorted by window start => all further ones are newer.
+         break;
+      }
+      writePingSummary(iterator->first, iterator->second);
+      iterator = PingSummaries.erase(iterator);
+   }
+}
+
+
+// ###### Write Ping summary to output file #################################
+void Ping::writePingSummary(const PingSummaryKey& key,
+                            const PingSummary&    summary)
+{
+   const ResultTimePoint& windowStart = key.first;
+   const ResultTimePoint  windowEnd   = windowStart + std::chrono::seconds(Parameters.SummaryInterval);
+   const DestinationInfo& destination = key.second;
+   const bool             hasRTT      = (summary.RTTSketch.count() > 0);
+
+   // ====== Write to results file ==========================================
+   if(ResultsOutput) {
+      ResultsOutput->insert(
+         str(boost::format("#S%c %d %s %s %x %x %x %d %d %d %d %d %d %d %d %d %d %d %d %d %d")
+            % (unsigned char)IOModule->getProtocolType()
+
+            % ResultsOutput->measurementID()
+            % summary.SourceAddress.to_string()
+            % destination.address().to_string()
+            % nsSinceEpoch<ResultTimePoint>(windowStart)
+            % nsSinceEpoch<ResultTimePoint>(windowEnd)
+
+            % (unsigned int)destination.trafficClass()
+            % summary.PacketSize
+            % summary.SourcePort
+            % summary.DestinationPort
+
+            % summary.Sent
+            % summary.Received
+            % summary.Lost
+            % summary.Errors
+
+            % (hasRTT ? (long long)summary.RTTSketch.minimum()          : -1LL)
+            % (hasRTT ? (long long)summary.RTTSketch.mean()             : -1LL)
+            % (hasRTT ? (long long)summary.RTTSketch.maximum()          : -1LL)
+            % (hasRTT ? (long long)summary.RTTSketch.quantile(0.50)     : -1LL)
+            % (hasRTT ? (long long)summary.RTTSketch.quantile(0.90)     : -1LL)
+            % (hasRTT ? (long long)summary.RTTSketch.quantile(0.95)     : -1LL)
+            % (hasRTT ? (long long)summary.RTTSketch.quantile(0.99)     : -1LL)
+      ));
+   }
+
+   // ====== Write to stdout ================================================
+   else {
+      const std::string rtts = (hasRTT) ?
+         str(boost::format("min:%3.3fms p50:%3.3fms p90:%3.3fms p99:%3.3fms max:%3.3fms")
+                % (summary.RTTSketch.minimum()        / 1000000.0)
+                % (summary.RTTSketch.quantile(0.50)   / 1000000.0)
+                % (summary.RTTSketch.quantile(0.90)   / 1000000.0)
+                % (summary.RTTSketch.quantile(0.99)   / 1000000.0)
+                % (summary.RTTSketch.maximum()        / 1000000.0)) :
+         std::string("---");
+      std::cout << boost::format("%s: Ping %-4s  %-39s %-39s sent:%u received:%u lost:%u errors:%u  %s\n")
+                      % timePointToString<ResultTimePoint>(windowStart, 3)
+                      % IOModule->getProtocolName()
+                      % summary.SourceAddress.to_string()
+                      % destination.address().to_string()
+                      % summary.Sent
+                      % summary.Received
+                      % summary.Lost
+                      % summary.Errors
+                      % rtts;
+   }
+}
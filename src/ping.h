@@ -31,6 +31,7 @@
 #define PING_H
 
 #include "traceroute.h"
+#include "ddsketch.h"
 
 
 class Ping : public Traceroute
@@ -50,6 +51,7 @@ class Ping : public Traceroute
    virtual const std::string& getName() const;
 
    protected:
+   virtual void run();
    virtual bool prepareRun(const bool newRound = false);
    virtual void scheduleTimeoutEvent();
    virtual void noMoreOutstandingRequests();
@@ -61,8 +63,28 @@ class Ping : public Traceroute
    void writePingResultEntry(const ResultEntry* resultEntry,
                              const char*        indentation = "");
 
+   // ====== Summary mode ===================================================
+   struct PingSummary {
+      boost::asio::ip::address SourceAddress;
+      unsigned int             PacketSize;
+      uint16_t                 SourcePort;
+      uint16_t                 DestinationPort;
+      unsigned int             Sent;
+      unsigned int             Received;
+      unsigned int             Lost;
+      unsigned int             Errors;
+      DDSketch                 RTTSketch;    // RTTs in ns
+   };
+   typedef std::pair<ResultTimePoint, DestinationInfo> PingSummaryKey;
+
+   void updatePingSummary(const ResultEntry* resultEntry);
+   void flushPingSummaries(const bool all);
+   void writePingSummary(const PingSummaryKey& key,
+                         const PingSummary&    summary);
+
    private:
-   const std::string PingInstanceName;
+   const std::string                       PingInstanceName;
+   std::map<PingSummaryKey, PingSummary>   PingSummaries;
 };
 
 #endif
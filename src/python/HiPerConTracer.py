@@ -75,6 +75,7 @@ class HopStatus(Enum):
    # ------ Response received -----------------------------
    Flag_StarredRoute         = (1 << 8)   # Route with * (router did not respond)
    Flag_DestinationReached   = (1 << 9)   # Destination has responded
+   Flag_PartialRoute         = (1 << 10)  # Round has only probed some hops (MDA)
 
 
 # ###### Is destination not reachable? ######################################
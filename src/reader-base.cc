@@ -29,6 +29,8 @@
 
 #include "reader-base.h"
 
+#include <cstring>
+
 
 // Approximated offset to system time:
 // NOTE: This is an *approximation*, for checking whether a time time
@@ -41,6 +43,171 @@ const ReaderTimeDuration ReaderClockOffsetFromSystemTime(
 );
 
 
+// ###### Parse results file name ##########################################
+// This is a hand-written, deterministic parser for the file name grammar
+// (see ResultsFileName), which is much faster than std::regex_match().
+bool parseResultsFileName(const std::string_view service,
+                          const std::string_view filename,
+                          ResultsFileName&       resultsFileName)
+{
+   const char* p   = filename.data();
+   const char* end = p + filename.size();
+
+   auto isDigit = [](const char c) { return (c >= '0') && (c <= '9'); };
+   auto scanDigits = [&](const char* q) {
+      while( (q < end) && (isDigit(*q)) ) {
+         q++;
+      }
+      return q;
+   };
+
+   // ====== Service ========================================================
+   if( (filename.size() <= service.size()) ||
+       (filename.compare(0, service.size(), service) != 0) ||
+       (filename[service.size()] != '-') ) {
+      return false;
+   }
+   resultsFileName.Service = filename.substr(0, service.size());
+   p += service.size() + 1;
+
+   // ====== Protocol (optional) ============================================
+   // Upper-case letters followed by "-". Otherwise, there is no protocol,
+   // and the ID type follows directly (which may be "P"!).
+   const char* q = p;
+   while( (q < end) && (*q >= 'A') && (*q <= 'Z') ) {
+      q++;
+   }
+   if( (q > p) && (q < end) && (*q == '-') ) {
+      resultsFileName.Protocol = std::string_view(p, q + 1 - p);
+      p = q + 1;
+   }
+   else {
+      resultsFileName.Protocol = std::string_view();
+   }
+
+   // ====== ID type and ID =================================================
+   if( (p >= end) || ( (*p != '#') && (*p != 'P') ) ) {
+      return false;
+   }
+   resultsFileName.IDType = *p++;
+   q = scanDigits(p);
+   if( (q == p) || (q >= end) || (*q != '-') ) {
+      return false;
+   }
+   resultsFileName.ID = std::string_view(p, q - p);
+   p = q + 1;
+
+   // ====== Source =========================================================
+   // An address, optionally followed by "%" and the writer number of a
+   // shared writer (e.g. "::%2").
+   q = p;
+   while( (q < end) &&
+          ( (isDigit(*q)) || ( (*q >= 'a') && (*q <= 'f') ) || (*q == ':') || (*q == '.') ) ) {
+      q++;
+   }
+   if( (q > p) && (q < end) && (*q == '%') ) {
+      const char* r = scanDigits(q + 1);
+      if(r == q + 1) {
+         return false;
+      }
+      q = r;
+   }
+   if( (q == p) || (q >= end) || (*q != '-') ) {
+      return false;
+   }
+   resultsFileName.Source = std::string_view(p, q - p);
+   p = q + 1;
+
+   // ====== Time stamp: YYYYMMDD "T" <seconds> "." <microseconds> ==========
+   const char* timeStamp = p;
+   q = scanDigits(p);
+   if( (q - p != 8) || (q >= end) || (*q != 'T') ) {
+      return false;
+   }
+   p = q + 1;
+   q = scanDigits(p);
+   if( (q == p) || (q >= end) || (*q != '.') ) {
+      return false;
+   }
+   p = q + 1;
+   q = scanDigits(p);
+   if( (q - p != 6) || (q >= end) || (*q != '-') ) {
+      return false;
+   }
+   resultsFileName.TimeStamp = std::string_view(timeStamp, q - timeStamp);
+   p = q + 1;
+
+   // ====== Sequence number (may be empty) =================================
+   q = scanDigits(p);
+   if( (q >= end) || (*q != '.') ) {
+      return false;
+   }
+   resultsFileName.SeqNumber = std::string_view(p, q - p);
+   p = q + 1;
+
+   // ====== Extension and compression ======================================
+   const std::string_view rest(p, end - p);
+   std::string_view compression;
+   if(rest.compare(0, 4, "hpct") == 0) {
+      resultsFileName.Extension = rest.substr(0, 4);
+      compression = rest.substr(4);
+   }
+   else if(rest.compare(0, 7, "results") == 0) {
+      resultsFileName.Extension = rest.substr(0, 7);
+      compression = rest.substr(7);
+   }
+   else {
+      return false;
+   }
+   if( (!compression.empty()) &&
+       (compression != ".xz") && (compression != ".bz2") &&
+       (compression != ".gz") && (compression != ".zst") ) {
+      return false;
+   }
+   resultsFileName.Compression = compression;
+   return true;
+}
+
+
+// ###### Parse time stamp of results file name #############################
+// Fast path for the usual "YYYYMMDDTHHMMSS.ffffff" time stamp, giving the
+// same result as stringToTimePoint() with format "%Y%m%dT%H%M%S".
+bool parseResultsFileTimeStamp(const std::string_view timeStamp,
+                               ReaderTimePoint&       timePoint)
+{
+   if( (timeStamp.size() == 22) && (timeStamp[8] == 'T') && (timeStamp[15] == '.') ) {
+      unsigned int year, month, day, hour, minute, second, microseconds;
+      if( (parseNumber(timeStamp.substr(0, 4),  year)         == std::errc()) &&
+          (parseNumber(timeStamp.substr(4, 2),  month)        == std::errc()) &&
+          (parseNumber(timeStamp.substr(6, 2),  day)          == std::errc()) &&
+          (parseNumber(timeStamp.substr(9, 2),  hour)         == std::errc()) &&
+          (parseNumber(timeStamp.substr(11, 2), minute)       == std::errc()) &&
+          (parseNumber(timeStamp.substr(13, 2), second)       == std::errc()) &&
+          (parseNumber(timeStamp.substr(16, 6), microseconds) == std::errc()) &&
+          (month >= 1) && (month <= 12) && (day >= 1) && (day <= 31) &&
+          (hour <= 23) && (minute <= 59) && (second <= 59) ) {
+         std::tm tm = {};
+         tm.tm_year = year - 1900;
+         tm.tm_mon  = month - 1;
+         tm.tm_mday = day;
+         tm.tm_hour = hour;
+         tm.tm_min  = minute;
+         tm.tm_sec  = second;
+         timePoint = ReaderTimePoint(std::chrono::seconds(timegm(&tm)));
+
+         // Same computation as in stringToTimePoint():
+         const double f        = microseconds / 1000000.0;
+         const size_t fseconds = f * std::chrono::high_resolution_clock::period::den / std::chrono::high_resolution_clock::period::num;
+         timePoint += std::chrono::high_resolution_clock::duration(fseconds);
+         return true;
+      }
+   }
+
+   // ====== Anything else -> use the generic function ======================
+   return stringToTimePoint<ReaderTimePoint>(std::string(timeStamp), timePoint, "%Y%m%dT%H%M%S");
+}
+
+
 // ###### Constructor #######################################################
 ReaderBase::ReaderBase(
    const ImporterConfiguration& importerConfiguration,
@@ -68,3 +235,248 @@ ReaderBase::~ReaderBase()
    delete [] Statistics;
    Statistics = nullptr;
 }
+
+
+// ###### Hold back files from fetching #####################################
+void ReaderBase::setHoldBack(const std::filesystem::path& watermark)
+{
+   std::unique_lock lock(Mutex);
+   // A directory path with trailing separator (e.g. the import directory)
+   // has to be compared without it, like the parent path of a file:
+   HoldBackWatermark = (watermark.has_filename()) ? watermark : watermark.parent_path();
+}
+
+
+// ###### Constructor #######################################################
+LineScanner::LineScanner(std::istream& stream,
+                         const size_t  chunkSize)
+   : Stream(stream)
+{
+   assert(chunkSize > 0);
+   Buffer.resize(chunkSize);
+   Begin       = 0;
+   End         = 0;
+   EndOfStream = false;
+}
+
+
+// ###### Destructor ########################################################
+LineScanner::~LineScanner()
+{
+}
+
+
+// ###### Get next line #####################################################
+bool LineScanner::nextLine(std::string_view& line)
+{
+   while(true) {
+      // ====== Look for the end of the next line ===========================
+      const char* data    = Buffer.data();
+      const char* newline = (const char*)memchr(data + Begin, '\n', End - Begin);
+      if(newline != nullptr) {
+         line  = std::string_view(data + Begin, newline - (data + Begin));
+         Begin = (newline - data) + 1;
+         return true;
+      }
+      if(EndOfStream) {
+         if(Begin < End) {
+            // Last line without newline:
+            line  = std::string_view(data + Begin, End - Begin);
+            Begin = End;
+            return true;
+         }
+         return false;
+      }
+
+      // ====== Read next chunk =============================================
+      if(Begin > 0) {
+         // Move incomplete line to the beginning of the buffer:
+         memmove(Buffer.data(), Buffer.data() + Begin, End - Begin);
+         End  -= Begin;
+         Begin = 0;
+      }
+      if(End == Buffer.size()) {
+         // The line does not fit into the buffer -> enlarge it:
+         Buffer.resize(2 * Buffer.size());
+      }
+      Stream.read(Buffer.data() + End, Buffer.size() - End);
+      End += Stream.gcount();
+      if(!Stream) {
+         EndOfStream = true;
+      }
+   }
+}
+
+
+// ###### Split line into fields ############################################
+// Consecutive delimiters are skipped. Additional fields beyond maxFields are
+// ignored, missing ones are set to empty. Returns the number of fields found.
+size_t splitFields(const std::string_view line,
+                   std::string_view*      fields,
+                   const size_t           maxFields,
+                   const char             delimiter)
+{
+   size_t columns = 0;
+   size_t start;
+   size_t end = 0;
+   while((start = line.find_first_not_of(delimiter, end)) != std::string_view::npos) {
+      if(columns == maxFields) {
+         // Skip additional columns
+         break;
+      }
+      end = line.find(delimiter, start);
+      fields[columns++] = line.substr(start, end - start);
+   }
+   for(size_t i = columns; i < maxFields; i++) {
+      fields[i] = std::string_view();
+   }
+   return columns;
+}
+
+
+// ###### Parse IPv4 address ################################################
+static bool parseIPv4(const char* begin, const char* end, uint8_t* bytes)
+{
+   unsigned int octets = 0;
+   while(octets < 4) {
+      // ====== Parse octet =================================================
+      const char*  start = begin;
+      unsigned int value = 0;
+      while( (begin < end) && (*begin >= '0') && (*begin <= '9') ) {
+         value = (10 * value) + (*begin - '0');
+         if( (value > 255) || (begin - start >= 3) ) {
+            return false;
+         }
+         begin++;
+      }
+      if( (begin == start) ||
+          ((begin - start > 1) && (*start == '0')) ) {   // No leading zeros
+         return false;
+      }
+      bytes[octets++] = (uint8_t)value;
+
+      // ====== Check separator =============================================
+      if(octets < 4) {
+         if( (begin >= end) || (*begin != '.') ) {
+            return false;
+         }
+         begin++;
+      }
+   }
+   return (begin == end);
+}
+
+
+// ###### Parse IPv6 address ################################################
+static bool parseIPv6(const char* begin, const char* end, uint8_t* bytes)
+{
+   uint8_t*     position    = bytes;
+   uint8_t*     last        = bytes + 16;
+   uint8_t*     gap         = nullptr;
+   const char*  token       = begin;
+   unsigned int value       = 0;
+   unsigned int digits      = 0;
+
+   // A leading colon is only allowed as part of "::":
+   if( (begin < end) && (*begin == ':') ) {
+      if( (++begin >= end) || (*begin != ':') ) {
+         return false;
+      }
+   }
+   while(begin < end) {
+      const char c = *begin++;
+
+      // ====== Hexadecimal digit ===========================================
+      int digit;
+      if( (c >= '0') && (c <= '9') )      { digit = c - '0';      }
+      else if( (c >= 'a') && (c <= 'f') ) { digit = c - 'a' + 10; }
+      else if( (c >= 'A') && (c <= 'F') ) { digit = c - 'A' + 10; }
+      else                                { digit = -1;           }
+      if(digit >= 0) {
+         if(digits == 4) {
+            return false;
+         }
+         value = (value << 4) | (unsigned int)digit;
+         digits++;
+         continue;
+      }
+
+      // ====== Group separator =============================================
+      if(c == ':') {
+         token = begin;
+         if(digits == 0) {
+            if(gap != nullptr) {
+               return false;   // Only one "::" is allowed
+            }
+            gap = position;
+            continue;
+         }
+         if( (begin >= end) || (position + 2 > last) ) {
+            return false;
+         }
+         *position++ = (uint8_t)(value >> 8);
+         *position++ = (uint8_t)(value & 0xff);
+         value  = 0;
+         digits = 0;
+         continue;
+      }
+
+      // ====== Embedded IPv4 address in the last 32 bits ===================
+      if( (c == '.') && (position + 4 <= last) &&
+          (parseIPv4(token, end, position)) ) {
+         position += 4;
+         digits    = 0;
+         break;
+      }
+      return false;
+   }
+   if(digits > 0) {
+      if(position + 2 > last) {
+         return false;
+      }
+      *position++ = (uint8_t)(value >> 8);
+      *position++ = (uint8_t)(value & 0xff);
+   }
+
+   // ====== Expand "::" ====================================================
+   if(gap != nullptr) {
+      if(position == last) {
+         return false;
+      }
+      const size_t n = position - gap;
+      memmove(last - n, gap, n);
+      memset(gap, 0, (last - n) - gap);
+      position = last;
+   }
+   return (position == last);
+}
+
+
+// ###### Parse IPv4 or IPv6 address ########################################
+// Unlike boost::asio::ip::make_address(), this function does not need a
+// null-terminated copy of the value, and does not throw on bad input.
+bool parseAddress(const std::string_view    value,
+                  boost::asio::ip::address& address)
+{
+   if(value.find(':') == std::string_view::npos) {
+      boost::asio::ip::address_v4::bytes_type bytes;
+      if(parseIPv4(value.data(), value.data() + value.size(), bytes.data())) {
+         address = boost::asio::ip::address_v4(bytes);
+         return true;
+      }
+   }
+   else if(value.find('%') == std::string_view::npos) {
+      boost::asio::ip::address_v6::bytes_type bytes = { };
+      if(parseIPv6(value.data(), value.data() + value.size(), bytes.data())) {
+         address = boost::asio::ip::address_v6(bytes);
+         return true;
+      }
+   }
+   else {
+      // IPv6 address with scope ID (rare) -> let Boost.Asio handle it:
+      boost::system::error_code errorCode;
+      address = boost::asio::ip::make_address(std::string(value), errorCode);
+      return (!errorCode);
+   }
+   return false;
+}
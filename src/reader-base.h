@@ -36,13 +36,18 @@
 #include "logger.h"
 #include "tools.h"
 
+#include <charconv>
 #include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <list>
+#include <map>
 #include <mutex>
-#include <regex>
+#include <set>
 #include <string>
+#include <string_view>
+
+#include <boost/asio/ip/address.hpp>
 
 #include <boost/iostreams/filtering_stream.hpp>
 
@@ -65,6 +70,83 @@ typedef ReaderClock::duration                ReaderTimeDuration;
 extern const ReaderTimeDuration ReaderClockOffsetFromSystemTime;
 
 
+// ###### Chunked line scanner ##############################################
+// Reads the input stream in large chunks, and returns each line as view
+// into the chunk buffer. A line is only valid until the next call of
+// nextLine()!
+class LineScanner
+{
+   public:
+   LineScanner(std::istream& stream,
+               const size_t  chunkSize = 65536);
+   ~LineScanner();
+
+   bool nextLine(std::string_view& line);
+
+   private:
+   std::istream& Stream;
+   std::string   Buffer;
+   size_t        Begin;
+   size_t        End;
+   bool          EndOfStream;
+};
+
+
+size_t splitFields(const std::string_view line,
+                   std::string_view*      fields,
+                   const size_t           maxFields,
+                   const char             delimiter = ' ');
+bool parseAddress(const std::string_view    value,
+                  boost::asio::ip::address& address);
+
+
+// ###### Parts of a results file name ######################################
+// Format: <Service>-(<Protocol>-|)[P#]<ID>-<Source>-<YYYYMMDD>T<Seconds.Microseconds>-<Sequence>.(hpct|results)(<.xz|.bz2|.gz|.zst|>)
+// <Source> is an address, or "0.0.0.0%<N>"/"::%<N>" for shared writer <N>.
+// The parts are views into the file name string, i.e. they are only valid
+// as long as this string exists!
+struct ResultsFileName {
+   std::string_view Service;       // e.g. "Ping"
+   std::string_view Protocol;      // e.g. "ICMP-", or empty
+   char             IDType;        // '#' (Measurement ID) or 'P' (Process ID)
+   std::string_view ID;
+   std::string_view Source;
+   std::string_view TimeStamp;     // e.g. "20241018T133005.000000"
+   std::string_view SeqNumber;
+   std::string_view Extension;     // "hpct" or "results"
+   std::string_view Compression;   // e.g. ".xz", or empty
+};
+
+bool parseResultsFileName(const std::string_view service,
+                          const std::string_view filename,
+                          ResultsFileName&       resultsFileName);
+bool parseResultsFileTimeStamp(const std::string_view timeStamp,
+                               ReaderTimePoint&       timePoint);
+
+
+// ###### Parse number from string view #####################################
+// Returns std::errc() on success, the std::from_chars() error if there is no
+// valid number, or ParseTrailingCharacters for a number followed by further
+// characters.
+constexpr std::errc ParseTrailingCharacters = std::errc::illegal_byte_sequence;
+
+template<typename T> std::errc parseNumber(const std::string_view value,
+                                           T&                     number,
+                                           const int              base = 10)
+{
+   const char* end = value.data() + value.size();
+   const std::from_chars_result result =
+      std::from_chars(value.data(), end, number, base);
+   if(result.ec != std::errc()) {
+      return result.ec;
+   }
+   if(result.ptr != end) {
+      return ParseTrailingCharacters;
+   }
+   return std::errc();
+}
+
+
 // ###### Reader base class #################################################
 class ReaderBase
 {
@@ -76,19 +158,24 @@ class ReaderBase
 
    inline const unsigned int getWorkers() const            { return Workers;            }
    inline const unsigned int getMaxTransactionSize() const { return MaxTransactionSize; }
+   void setHoldBack(const std::filesystem::path& watermark);
 
    virtual const std::string& getIdentification() const = 0;
-   virtual const std::regex&  getFileNameRegExp() const = 0;
+   virtual bool parseFileName(const std::string_view filename,
+                              ResultsFileName&       resultsFileName) const = 0;
 
    virtual int addFile(const std::filesystem::path& dataFile,
-                       const std::smatch            match) = 0;
+                       const ResultsFileName&       resultsFileName) = 0;
    virtual bool removeFile(const std::filesystem::path& dataFile,
-                           const std::smatch            match) = 0;
+                           const ResultsFileName&       resultsFileName) = 0;
    virtual unsigned int fetchFiles(std::list<std::filesystem::path>& dataFileList,
                                    const unsigned int                worker,
                                    const unsigned int                limit = 1) = 0;
+   virtual unsigned int getBacklog(const unsigned int worker) = 0;
    virtual std::filesystem::path getDirectoryHierarchy(const std::filesystem::path& dataFile,
-                                                       const std::smatch            match) = 0;
+                                                       const ResultsFileName&       resultsFileName) = 0;
+   virtual std::filesystem::path getArchiveFile(const std::filesystem::path& dataFile,
+                                                const ResultsFileName&       resultsFileName) = 0;
    virtual void printStatus(std::ostream& os = std::cout) = 0;
 
    virtual void beginParsing(DatabaseClientBase& databaseClient,
@@ -105,6 +192,9 @@ class ReaderBase
    const unsigned int           Workers;
    const unsigned int           MaxTransactionSize;
    std::mutex                   Mutex;
+   // Files in directories not before the watermark are queued, but not
+   // fetched yet (empty path: no files are held back):
+   std::filesystem::path        HoldBackWatermark;
 
    struct WorkerStatistics {
       unsigned long long Processed;
@@ -135,18 +225,34 @@ class ReaderImplementation : public ReaderBase
 
    virtual bool getReaderInputFileEntryForFile(const std::filesystem::path& dataFile, ReaderInputFileEntry& inputFileEntry) const;
    virtual int addFile(const std::filesystem::path& dataFile,
-                       const std::smatch            match);
+                       const ResultsFileName&       resultsFileName);
    virtual bool removeFile(const std::filesystem::path& dataFile,
-                           const std::smatch            match);
+                           const ResultsFileName&       resultsFileName);
    virtual unsigned int fetchFiles(std::list<std::filesystem::path>& dataFileList,
                                    const unsigned int                worker,
                                    const unsigned int                limit = 1);
+   virtual unsigned int getBacklog(const unsigned int worker);
    virtual std::filesystem::path getDirectoryHierarchy(const std::filesystem::path& dataFile,
-                                                       const std::smatch            match);
+                                                       const ResultsFileName&       resultsFileName);
+   virtual std::filesystem::path getArchiveFile(const std::filesystem::path& dataFile,
+                                                const ResultsFileName&       resultsFileName);
    virtual void printStatus(std::ostream& os = std::cout);
 
    protected:
-   std::set<ReaderInputFileEntry>* DataFileSet[ReaderPriority::Max + 1];
+   unsigned int getWorkerForSource(const ReaderInputFileEntry& inputFileEntry,
+                                   const unsigned int          homeWorkerID) const;
+   bool takeOverSource(const unsigned int worker);
+
+   std::set<ReaderInputFileEntry>*  DataFileSet[ReaderPriority::Max + 1];
+
+   // ====== Work stealing ==================================================
+   // Files are queued per source, identified by the source hash. An idle
+   // worker may take over the complete queue of a source from a busy
+   // worker, as long as none of the source's files is in progress there.
+   // New files of the source are then assigned to the new worker, too.
+   std::map<uint32_t, unsigned int>* SourceBacklog;     // Per worker: source -> files
+   std::set<uint32_t>*               InProgressSources; // Per worker: sources of last fetchFiles()
+   std::map<uint32_t, unsigned int>  SourceAssignment;  // Source -> worker, if not home worker
 };
 
 
@@ -162,6 +268,10 @@ ReaderImplementation<ReaderInputFileEntry>::ReaderImplementation(
       DataFileSet[p] = new std::set<ReaderInputFileEntry>[Workers];
       assert(DataFileSet[p] != nullptr);
    }
+   SourceBacklog = new std::map<uint32_t, unsigned int>[Workers];
+   assert(SourceBacklog != nullptr);
+   InProgressSources = new std::set<uint32_t>[Workers];
+   assert(InProgressSources != nullptr);
 }
 
 
@@ -173,6 +283,10 @@ ReaderImplementation<ReaderInputFileEntry>::~ReaderImplementation()
       delete [] DataFileSet[p];
       DataFileSet[p] = nullptr;
    }
+   delete [] SourceBacklog;
+   SourceBacklog = nullptr;
+   delete [] InProgressSources;
+   InProgressSources = nullptr;
 }
 
 
@@ -183,9 +297,9 @@ bool ReaderImplementation<ReaderInputFileEntry>::getReaderInputFileEntryForFile(
         ReaderInputFileEntry&        inputFileEntry) const
 {
    const std::string& filename = dataFile.filename().string();
-   std::smatch        match;
-   if(std::regex_match(filename, match, getFileNameRegExp())) {
-      if(makeInputFileEntry(dataFile, match, inputFileEntry, 1) >= 0) {
+   ResultsFileName    resultsFileName;
+   if(parseFileName(filename, resultsFileName)) {
+      if(makeInputFileEntry(dataFile, resultsFileName, inputFileEntry, 1) >= 0) {
          return true;
       }
    }
@@ -197,18 +311,20 @@ bool ReaderImplementation<ReaderInputFileEntry>::getReaderInputFileEntryForFile(
 template<typename ReaderInputFileEntry>
 int ReaderImplementation<ReaderInputFileEntry>::addFile(
        const std::filesystem::path& dataFile,
-       const std::smatch            match)
+       const ResultsFileName&       resultsFileName)
 {
    ReaderInputFileEntry inputFileEntry;
-   const int workerID = makeInputFileEntry(dataFile, match, inputFileEntry, Workers);
-   if(workerID >= 0) {
+   const int homeWorkerID = makeInputFileEntry(dataFile, resultsFileName, inputFileEntry, Workers);
+   if(homeWorkerID >= 0) {
       std::unique_lock lock(Mutex);
+      const unsigned int workerID = getWorkerForSource(inputFileEntry, homeWorkerID);
 
       // ====== Get priority ================================================
       const ReaderPriority p = getPriorityOfFileEntry(inputFileEntry);
 
       // ====== Insert file entry into list =================================
       if(DataFileSet[p][workerID].insert(inputFileEntry).second) {
+         SourceBacklog[workerID][inputFileEntry.SourceHash]++;
          HPCT_LOG(trace) << getIdentification() << ": Added input file "
                          << relativeTo(dataFile, ImporterConfig.getImportFilePath()) << " to reader";
          return workerID;
@@ -222,17 +338,24 @@ int ReaderImplementation<ReaderInputFileEntry>::addFile(
 template<typename ReaderInputFileEntry>
 bool ReaderImplementation<ReaderInputFileEntry>::removeFile(
         const std::filesystem::path& dataFile,
-        const std::smatch            match)
+        const ResultsFileName&       resultsFileName)
 {
    ReaderInputFileEntry inputFileEntry;
-   const int workerID = makeInputFileEntry(dataFile, match, inputFileEntry, Workers);
-   if(workerID >= 0) {
+   const int homeWorkerID = makeInputFileEntry(dataFile, resultsFileName, inputFileEntry, Workers);
+   if(homeWorkerID >= 0) {
       HPCT_LOG(trace) << getIdentification() << ": Removing input file "
                       << relativeTo(dataFile, ImporterConfig.getImportFilePath()) << " from reader";
       std::unique_lock lock(Mutex);
+      const unsigned int workerID = getWorkerForSource(inputFileEntry, homeWorkerID);
 
       for(int p = ReaderPriority::Max; p >= 0; p--) {
          if(DataFileSet[p][workerID].erase(inputFileEntry) == 1) {
+            std::map<uint32_t, unsigned int>::iterator found =
+               SourceBacklog[workerID].find(inputFileEntry.SourceHash);
+            assert(found != SourceBacklog[workerID].end());
+            if(--found->second == 0) {
+               SourceBacklog[workerID].erase(found);
+            }
             Statistics[workerID].Processed++;
             Statistics[Workers].Processed++;
             return true;
@@ -255,29 +378,146 @@ unsigned int ReaderImplementation<ReaderInputFileEntry>::fetchFiles(
 
    std::unique_lock lock(Mutex);
 
-   for(int p = ReaderPriority::Max; p >= 0; p--) {
-      for(const ReaderInputFileEntry& inputFileEntry : DataFileSet[p][worker]) {
+   // ====== Idle worker -> try to take over a source from a busy one =======
+   if(SourceBacklog[worker].empty()) {
+      takeOverSource(worker);
+   }
+
+   InProgressSources[worker].clear();
+   for(int p = ReaderPriority::Max; (p >= 0) && (dataFileList.size() < limit); p--) {
+      typename std::set<ReaderInputFileEntry>::const_iterator iterator =
+         DataFileSet[p][worker].begin();
+      while( (iterator != DataFileSet[p][worker].end()) &&
+             (dataFileList.size() < limit) ) {
+         const ReaderInputFileEntry& inputFileEntry = *iterator;
+
+         // ====== Held back -> skip the remaining files of the source =====
+         // Older files of the source may still be found by the initial
+         // directory traversal.
+         if( (!HoldBackWatermark.empty()) &&
+             (!(inputFileEntry.DataFile.parent_path() < HoldBackWatermark)) ) {
+            ReaderInputFileEntry lastOfSource = inputFileEntry;
+            lastOfSource.TimeStamp = ReaderTimePoint::max();
+            iterator = DataFileSet[p][worker].upper_bound(lastOfSource);
+            continue;
+         }
+
          // std::cout << dataFileList.size() << ": pri" << p << " " << inputFileEntry.DataFile << "\n";
          dataFileList.push_back(inputFileEntry.DataFile);
-         if(dataFileList.size() >= limit) {
-            break;
-         }
+         InProgressSources[worker].insert(inputFileEntry.SourceHash);
+         iterator++;
       }
    }
    return dataFileList.size();
 }
 
 
+// ###### Get number of queued files of a worker ############################
+template<typename ReaderInputFileEntry>
+unsigned int ReaderImplementation<ReaderInputFileEntry>::getBacklog(const unsigned int worker)
+{
+   assert(worker < Workers);
+   std::unique_lock lock(Mutex);
+
+   size_t backlog = 0;
+   for(int p = ReaderPriority::Max; p >= 0; p--) {
+      backlog += DataFileSet[p][worker].size();
+   }
+   return backlog;
+}
+
+
+// ###### Get worker for the source of a file ###############################
+template<typename ReaderInputFileEntry>
+unsigned int ReaderImplementation<ReaderInputFileEntry>::getWorkerForSource(
+                const ReaderInputFileEntry& inputFileEntry,
+                const unsigned int          homeWorkerID) const
+{
+   // NOTE: Mutex must be locked!
+   std::map<uint32_t, unsigned int>::const_iterator found =
+      SourceAssignment.find(inputFileEntry.SourceHash);
+   if(found != SourceAssignment.end()) {
+      return found->second;
+   }
+   return homeWorkerID;
+}
+
+
+// ###### Take over the files of a source from a busy worker ################
+template<typename ReaderInputFileEntry>
+bool ReaderImplementation<ReaderInputFileEntry>::takeOverSource(const unsigned int worker)
+{
+   // NOTE: Mutex must be locked!
+
+   // ====== Find the busiest worker ========================================
+   unsigned int busyWorker = worker;
+   size_t       maxBacklog = 2 * MaxTransactionSize;   // Not worth it below
+   for(unsigned int w = 0; w < Workers; w++) {
+      const size_t backlog = DataFileSet[ReaderPriority::High][w].size() +
+                             DataFileSet[ReaderPriority::Low][w].size();
+      if( (w != worker) && (backlog > maxBacklog) ) {
+         busyWorker = w;
+         maxBacklog = backlog;
+      }
+   }
+   if(busyWorker == worker) {
+      return false;
+   }
+
+   // ====== Find the largest source that is not in progress ================
+   uint32_t     source      = 0;
+   unsigned int sourceFiles = 0;
+   for(const std::pair<const uint32_t, unsigned int>& sourceBacklog : SourceBacklog[busyWorker]) {
+      if( (sourceBacklog.second > sourceFiles) &&
+          (InProgressSources[busyWorker].find(sourceBacklog.first) == InProgressSources[busyWorker].end()) ) {
+         source      = sourceBacklog.first;
+         sourceFiles = sourceBacklog.second;
+      }
+   }
+   if(sourceFiles == 0) {
+      return false;
+   }
+
+   // ====== Move the source's files, keeping their order ===================
+   std::string sourceName;
+   for(int p = ReaderPriority::Max; p >= 0; p--) {
+      typename std::set<ReaderInputFileEntry>::iterator iterator = DataFileSet[p][busyWorker].begin();
+      while(iterator != DataFileSet[p][busyWorker].end()) {
+         if(iterator->SourceHash == source) {
+            sourceName = iterator->Source;
+            DataFileSet[p][worker].insert(DataFileSet[p][busyWorker].extract(iterator++));
+         }
+         else {
+            iterator++;
+         }
+      }
+   }
+   SourceBacklog[busyWorker].erase(source);
+   SourceBacklog[worker][source] = sourceFiles;
+   if(source % Workers == worker) {
+      SourceAssignment.erase(source);   // Back at its home worker
+   }
+   else {
+      SourceAssignment[source] = worker;
+   }
+
+   HPCT_LOG(debug) << getIdentification() << ": Worker #" << worker + 1
+                   << " took over source " << sourceName << " with " << sourceFiles
+                   << " files from busy worker #" << busyWorker + 1;
+   return true;
+}
+
+
 // ###### Make directory hierarchy from ReaderInputFileEntry ################
 template<typename ReaderInputFileEntry>
 std::filesystem::path ReaderImplementation<ReaderInputFileEntry>::getDirectoryHierarchy(
    const std::filesystem::path& dataFile,
-   const std::smatch            match)
+   const ResultsFileName&       resultsFileName)
 {
    if( (ImporterConfig.getMoveDirectoryDepth() > 0) ||
        (ImporterConfig.getMoveTimestampDepth() > 0) ) {
       ReaderInputFileEntry inputFileEntry;
-      const int workerID = makeInputFileEntry(dataFile, match, inputFileEntry, 1);
+      const int workerID = makeInputFileEntry(dataFile, resultsFileName, inputFileEntry, 1);
       if(workerID >= 0) {
          const ReaderTimePoint& timeStamp = inputFileEntry.TimeStamp;
          return makeDirectoryHierarchy(ImporterConfig.getImportFilePath(),
@@ -290,6 +530,41 @@ std::filesystem::path ReaderImplementation<ReaderInputFileEntry>::getDirectoryHi
 }
 
 
+// ###### Make archive file from ReaderInputFileEntry #######################
+// The archive of a file is named like the files of the same source in the
+// same time bucket, with the start of the bucket as time stamp and
+// sequence number 0. That is, archives are importable like results files.
+template<typename ReaderInputFileEntry>
+std::filesystem::path ReaderImplementation<ReaderInputFileEntry>::getArchiveFile(
+   const std::filesystem::path& dataFile,
+   const ResultsFileName&       resultsFileName)
+{
+   ReaderInputFileEntry inputFileEntry;
+   const int workerID = makeInputFileEntry(dataFile, resultsFileName, inputFileEntry, 1);
+   if(workerID >= 0) {
+      const unsigned long long seconds =
+         std::chrono::duration_cast<std::chrono::seconds>(inputFileEntry.TimeStamp.time_since_epoch()).count();
+      const ReaderTimePoint bucketTimeStamp(
+         std::chrono::seconds(seconds - (seconds % ImporterConfig.getArchiveBucketLength())));
+
+      const std::string archiveName =
+         std::string(resultsFileName.Service) + "-" +
+         std::string(resultsFileName.Protocol) +
+         resultsFileName.IDType + std::string(resultsFileName.ID) + "-" +
+         std::string(resultsFileName.Source) + "-" +
+         timePointToString<ReaderTimePoint>(bucketTimeStamp, 6, "%Y%m%dT%H%M%S") + "-" +
+         std::string(resultsFileName.SeqNumber.size(), '0') + "." +
+         std::string(resultsFileName.Extension) +
+         std::string(resultsFileName.Compression);
+      return makeDirectoryHierarchy(ImporterConfig.getImportFilePath(),
+                                    dataFile, bucketTimeStamp,
+                                    ImporterConfig.getMoveDirectoryDepth(),
+                                    ImporterConfig.getMoveTimestampDepth()) / archiveName;
+   }
+   return std::filesystem::path();
+}
+
+
 // ###### Print reader status ###############################################
 template<typename ReaderInputFileEntry>
 void ReaderImplementation<ReaderInputFileEntry>::printStatus(std::ostream& os)
@@ -34,10 +34,40 @@
 
 
 const std::string JitterReader::Identification("Jitter");
-const std::regex  JitterReader::FileNameRegExp(
-   // Format: Jitter-(Protocol-|)[P#]<ID>-<Source>-<YYYYMMDD>T<Seconds.Microseconds>-<Sequence>.(hpct|results)(<.xz|.bz2|.gz|>)
-   "^Jitter-([A-Z]+-|)([#P])([0-9]+)-([0-9a-f:\\.]+)-([0-9]{8}T[0-9]+\\.[0-9]{6})-([0-9]*)\\.(hpct|results)(\\.xz|\\.bz2|\\.gz|)$"
-);
+const std::vector<BulkColumn> JitterReader::BulkColumns = {
+   { "Timestamp",            "timestamp",             BCT_BigInt   },
+   { "MeasurementID",        "measurementID",         BCT_Integer  },
+   { "SourceIP",             "sourceIP",              BCT_Address  },
+   { "DestinationIP",        "destinationIP",         BCT_Address  },
+   { "Protocol",             "protocol",              BCT_SmallInt },
+   { "TrafficClass",         "trafficClass",          BCT_SmallInt },
+   { "RoundNumber",          "roundNumber",           BCT_Integer  },
+   { "PacketSize",           "packetSize",            BCT_Integer  },
+   { "Checksum",             "checksum",              BCT_Integer  },
+   { "SourcePort",           "sourcePort",            BCT_Integer  },
+   { "DestinationPort",      "destinationPort",       BCT_Integer  },
+   { "Status",               "status",                BCT_SmallInt },
+   { "JitterType",           "jitterType",            BCT_SmallInt },
+   { "TimeSource",           "timeSource",            BCT_Integer  },
+   { "Packets_AppSend",      "appSendPackets",        BCT_Integer  },
+   { "MeanDelay_AppSend",    "appSendMeanLatency",    BCT_BigInt   },
+   { "Jitter_AppSend",       "appSendJitter",         BCT_BigInt   },
+   { "Packets_Queuing",      "queuingPackets",        BCT_Integer  },
+   { "MeanDelay_Queuing",    "queuingMeanLatency",    BCT_BigInt   },
+   { "Jitter_Queuing",       "queuingJitter",         BCT_BigInt   },
+   { "Packets_AppReceive",   "appReceivePackets",     BCT_Integer  },
+   { "MeanDelay_AppReceive", "appReceiveMeanLatency", BCT_BigInt   },
+   { "Jitter_AppReceive",    "appReceiveJitter",      BCT_BigInt   },
+   { "Packets_App",          "applicationPackets",    BCT_Integer  },
+   { "MeanRTT_App",          "applicationMeanRTT",    BCT_BigInt   },
+   { "Jitter_App",           "applicationJitter",     BCT_BigInt   },
+   { "Packets_SW",           "softwarePackets",       BCT_Integer  },
+   { "MeanRTT_SW",           "softwareMeanRTT",       BCT_BigInt   },
+   { "Jitter_SW",            "softwareJitter",        BCT_BigInt   },
+   { "Packets_HW",           "hardwarePackets",       BCT_Integer  },
+   { "MeanRTT_HW",           "hardwareMeanRTT",       BCT_BigInt   },
+   { "Jitter_HW",            "hardwareJitter",        BCT_BigInt   }
+};
 
 
 // ###### Constructor #######################################################
@@ -66,7 +96,10 @@ void JitterReader::beginParsing(DatabaseClientBase& databaseClient,
    rows = 0;
 
    // ====== Generate import statement ======================================
-   if(backend & DatabaseBackendType::SQL_Generic) {
+   if(databaseClient.supportsBulkRows()) {
+      databaseClient.getBulkRows("Jitter", false, true).define(Table, BulkColumns);
+   }
+   else if(backend & DatabaseBackendType::SQL_Generic) {
       statement
          << "INSERT INTO " << Table
          << " (Timestamp,MeasurementID,SourceIP,DestinationIP,Protocol,TrafficClass,RoundNumber,PacketSize,Checksum,SourcePort,DestinationPort,Status,JitterType,TimeSource,Packets_AppSend,MeanDelay_AppSend,Jitter_AppSend,Packets_Queuing,MeanDelay_Queuing,Jitter_Queuing,Packets_AppReceive,MeanDelay_AppReceive,Jitter_AppReceive,Packets_App,MeanRTT_App,Jitter_App,Packets_SW,MeanRTT_SW,Jitter_SW,Packets_HW,MeanRTT_HW,Jitter_HW) VALUES";
@@ -81,46 +114,26 @@ void JitterReader::beginParsing(DatabaseClientBase& databaseClient,
 
 
 // ###### Parse jitter type #################################################
-unsigned int JitterReader::parseJitterType(const std::string&           value,
+unsigned int JitterReader::parseJitterType(const std::string_view       value,
                                            const std::filesystem::path& dataFile)
 {
-   size_t       index      = 0;
-   unsigned int jitterType = 0;
-   try {
-      jitterType = std::stoul(value, &index, 10);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad jitter type format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad jitter type format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned int    jitterType;
+   const std::errc ec = parseNumber(value, jitterType);
+   if(ec != std::errc()) {
+      throwBadValue("Bad jitter type format ", value, dataFile, ec, "stoul");
    }
    return jitterType;
 }
 
 
 // ###### Parse packets  ####################################################
-unsigned int JitterReader::parsePackets(const std::string&           value,
+unsigned int JitterReader::parsePackets(const std::string_view       value,
                                         const std::filesystem::path& dataFile)
 {
-   size_t       index   = 0;
-   unsigned int packets = 0;
-   try {
-      packets = std::stoul(value, &index, 10);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad packets format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad packets format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned int    packets;
+   const std::errc ec = parseNumber(value, packets);
+   if(ec != std::errc()) {
+      throwBadValue("Bad packets format ", value, dataFile, ec, "stoul");
    }
    return packets;
 }
@@ -132,6 +145,16 @@ bool JitterReader::finishParsing(DatabaseClientBase& databaseClient,
 {
    const DatabaseBackendType backend   = databaseClient.getBackend();
    Statement&                statement = databaseClient.getStatement("Jitter");
+
+   if(databaseClient.supportsBulkRows()) {
+      BulkRows& bulkRows = databaseClient.getBulkRows("Jitter");
+      assert(bulkRows.getRows() == rows);
+      if(rows > 0) {
+         databaseClient.executeBulkRows(bulkRows);
+         return true;
+      }
+      return false;
+   }
    assert(statement.getRows() == rows);
 
    if(rows > 0) {
@@ -171,15 +194,18 @@ void JitterReader::parseContents(
 {
    Statement&                statement = databaseClient.getStatement("Jitter");
    const DatabaseBackendType backend   = databaseClient.getBackend();
+   BulkRows*                 bulkRows  = (databaseClient.supportsBulkRows()) ?
+                                            &databaseClient.getBulkRows("Jitter") : nullptr;
    static const unsigned int JitterMinColumns = 32;
    static const unsigned int JitterMaxColumns = 32;
    static const char         JitterDelimiter  = ' ';
 
-   std::string inputLine;
-   std::string tuple[JitterMaxColumns];
+   LineScanner      scanner(dataStream);
+   std::string_view inputLine;
+   std::string_view tuple[JitterMaxColumns];
    const ReaderTimePoint now =
       ReaderClock::now() + ReaderClockOffsetFromSystemTime;
-   while(std::getline(dataStream, inputLine)) {
+   while(scanner.nextLine(inputLine)) {
 
       // ====== Format identifier ===========================================
       if(inputLine.substr(0, 2) == "#?") {
@@ -188,17 +214,7 @@ void JitterReader::parseContents(
       }
 
       // ====== Parse Jitter line ===========================================
-      size_t columns = 0;
-      size_t start;
-      size_t end = 0;
-      while((start = inputLine.find_first_not_of(JitterDelimiter, end)) != std::string::npos) {
-         end = inputLine.find(JitterDelimiter, start);
-         if(columns == JitterMaxColumns) {
-            // Skip additional columns
-            break;
-         }
-         tuple[columns++] = inputLine.substr(start, end - start);
-      }
+      const size_t columns = splitFields(inputLine, tuple, JitterMaxColumns, JitterDelimiter);
       if(columns < JitterMinColumns) {
          throw ResultsReaderDataErrorException("Too few columns in input file " + dataFile.string());
       }
@@ -246,7 +262,52 @@ void JitterReader::parseContents(
          const unsigned long long       hardwareMeanRTT       = parseNanoseconds(tuple[30], dataFile);
          const unsigned long long       hardwareJitter        = parseNanoseconds(tuple[31], dataFile);
 
-         if(backend & DatabaseBackendType::SQL_Generic) {
+         if(bulkRows) {
+            // NOTE: The delays are signed, with -1 for "not available"!
+            bulkRows->beginRow();
+            *bulkRows
+               << timePointToNanoseconds<ReaderTimePoint>(timeStamp)
+               << measurementID
+               << sourceIP
+               << destinationIP
+               << (unsigned int)protocol
+               << (unsigned int)trafficClass
+               << roundNumber
+               << packetSize
+               << checksum
+               << sourcePort
+               << destinationPort
+               << status
+               << jitterType
+               << timeSource
+
+               << appSendPackets
+               << (long long)appSendMeanLatency
+               << (long long)appSendJitter
+
+               << queuingPackets
+               << (long long)queuingMeanLatency
+               << (long long)queuingJitter
+
+               << appReceivePackets
+               << (long long)appReceiveMeanLatency
+               << (long long)appReceiveJitter
+
+               << applicationPackets
+               << (long long)applicationMeanRTT
+               << (long long)applicationJitter
+
+               << softwarePackets
+               << (long long)softwareMeanRTT
+               << (long long)softwareJitter
+
+               << hardwarePackets
+               << (long long)hardwareMeanRTT
+               << (long long)hardwareJitter;
+            bulkRows->endRow();
+            rows++;
+         }
+         else if(backend & DatabaseBackendType::SQL_Generic) {
             statement.beginRow();
             statement
                << timePointToNanoseconds<ReaderTimePoint>(timeStamp) << statement.sep()
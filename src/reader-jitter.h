@@ -43,7 +43,6 @@ class JitterReader : public PingReader
    virtual ~JitterReader();
 
    virtual const std::string& getIdentification() const { return Identification; }
-   virtual const std::regex&  getFileNameRegExp() const { return FileNameRegExp; }
 
    virtual void beginParsing(DatabaseClientBase& databaseClient,
                              unsigned long long& rows);
@@ -55,14 +54,16 @@ class JitterReader : public PingReader
                               boost::iostreams::filtering_istream& dataStream);
 
    protected:
-   unsigned int parseJitterType(const std::string&           value,
+   unsigned int parseJitterType(const std::string_view       value,
                                 const std::filesystem::path& dataFile);
-   unsigned int parsePackets(const std::string&           value,
+   unsigned int parsePackets(const std::string_view       value,
                              const std::filesystem::path& dataFile);
 
    public:
    static const std::string Identification;
-   static const std::regex  FileNameRegExp;
+
+   private:
+   static const std::vector<BulkColumn> BulkColumns;
 };
 
 #endif
@@ -35,10 +35,28 @@
 
 
 const std::string PingReader::Identification("Ping");
-const std::regex  PingReader::FileNameRegExp(
-   // Format: Ping-(Protocol-|)[P#]<ID>-<Source>-<YYYYMMDD>T<Seconds.Microseconds>-<Sequence>.(hpct|results)(<.xz|.bz2|.gz|>)
-   "^Ping-([A-Z]+-|)([#P])([0-9]+)-([0-9a-f:\\.]+)-([0-9]{8}T[0-9]+\\.[0-9]{6})-([0-9]*)\\.(hpct|results)(\\.xz|\\.bz2|\\.gz|)$"
-);
+const std::vector<BulkColumn> PingReader::BulkColumns = {
+   { "SendTimestamp",    "sendTimestamp",   BCT_BigInt   },
+   { "MeasurementID",    "measurementID",   BCT_Integer  },
+   { "SourceIP",         "sourceIP",        BCT_Address  },
+   { "DestinationIP",    "destinationIP",   BCT_Address  },
+   { "Protocol",         "protocol",        BCT_SmallInt },
+   { "TrafficClass",     "trafficClass",    BCT_SmallInt },
+   { "BurstSeq",         "burstSeq",        BCT_Integer  },
+   { "PacketSize",       "packetSize",      BCT_Integer  },
+   { "ResponseSize",     "responseSize",    BCT_Integer  },
+   { "Checksum",         "checksum",        BCT_Integer  },
+   { "SourcePort",       "sourcePort",      BCT_Integer  },
+   { "DestinationPort",  "destinationPort", BCT_Integer  },
+   { "Status",           "status",          BCT_SmallInt },
+   { "TimeSource",       "timeSource",      BCT_Integer  },
+   { "Delay_AppSend",    "delay.appSend",   BCT_BigInt   },
+   { "Delay_Queuing",    "delay.queuing",   BCT_BigInt   },
+   { "Delay_AppReceive", "delay.appRecv",   BCT_BigInt   },
+   { "RTT_App",          "rtt.app",         BCT_BigInt   },
+   { "RTT_SW",           "rtt.sw",          BCT_BigInt   },
+   { "RTT_HW",           "rtt.hw",          BCT_BigInt   }
+};
 
 
 // ###### Constructor #######################################################
@@ -67,7 +85,10 @@ void PingReader::beginParsing(DatabaseClientBase& databaseClient,
    rows = 0;
 
    // ====== Generate import statement ======================================
-   if(backend & DatabaseBackendType::SQL_Generic) {
+   if(databaseClient.supportsBulkRows()) {
+      databaseClient.getBulkRows("Ping", false, true).define(Table, BulkColumns);
+   }
+   else if(backend & DatabaseBackendType::SQL_Generic) {
       statement
          << "INSERT INTO " << Table
          << " (SendTimestamp,MeasurementID,SourceIP,DestinationIP,Protocol,TrafficClass,BurstSeq,PacketSize,ResponseSize,Checksum,SourcePort,DestinationPort,Status,TimeSource,Delay_AppSend,Delay_Queuing, Delay_AppReceive,RTT_App,RTT_SW,RTT_HW) VALUES";
@@ -87,6 +108,16 @@ bool PingReader::finishParsing(DatabaseClientBase& databaseClient,
 {
    const DatabaseBackendType backend   = databaseClient.getBackend();
    Statement&                statement = databaseClient.getStatement("Ping");
+
+   if(databaseClient.supportsBulkRows()) {
+      BulkRows& bulkRows = databaseClient.getBulkRows("Ping");
+      assert(bulkRows.getRows() == rows);
+      if(rows > 0) {
+         databaseClient.executeBulkRows(bulkRows);
+         return true;
+      }
+      return false;
+   }
    assert(statement.getRows() == rows);
 
    if(rows > 0) {
@@ -126,15 +157,19 @@ void PingReader::parseContents(
 {
    Statement&                statement = databaseClient.getStatement("Ping");
    const DatabaseBackendType backend   = databaseClient.getBackend();
+   BulkRows*                 bulkRows  = (databaseClient.supportsBulkRows()) ?
+                                            &databaseClient.getBulkRows("Ping") : nullptr;
    static const unsigned int PingMinColumns = 20;
    static const unsigned int PingMaxColumns = 20;
    static const char         PingDelimiter  = ' ';
 
-   std::string inputLine;
-   std::string tuple[PingMaxColumns];
+   LineScanner      scanner(dataStream);
+   std::string_view inputLine;
+   std::string      convertedLine;
+   std::string_view tuple[PingMaxColumns];
    const ReaderTimePoint now =
       ReaderClock::now() + ReaderClockOffsetFromSystemTime;
-   while(std::getline(dataStream, inputLine)) {
+   while(scanner.nextLine(inputLine)) {
 
       // ====== Format identifier ===========================================
       if(inputLine.substr(0, 2) == "#?") {
@@ -146,20 +181,11 @@ void PingReader::parseContents(
       if(inputLine.substr(0, 2) == "#P") {
          // ====== Conversion from old versions =============================
          if(inputLine.substr(0, 3) == "#P ") {
-            inputLine = convertOldPingLine(inputLine);
+            convertedLine = convertOldPingLine(std::string(inputLine));
+            inputLine     = convertedLine;
          }
 
-         size_t columns = 0;
-         size_t start;
-         size_t end = 0;
-         while((start = inputLine.find_first_not_of(PingDelimiter, end)) != std::string::npos) {
-            end = inputLine.find(PingDelimiter, start);
-            if(columns == PingMaxColumns) {
-               // Skip additional columns
-               break;
-            }
-            tuple[columns++] = inputLine.substr(start, end - start);
-         }
+         const size_t columns = splitFields(inputLine, tuple, PingMaxColumns, PingDelimiter);
          if(columns < PingMinColumns) {
             throw ResultsReaderDataErrorException("Too few columns in input file " +
                                                   relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
@@ -188,7 +214,34 @@ void PingReader::parseContents(
          const long long                rttSoftware     = parseNanoseconds(tuple[18], dataFile);
          const long long                rttHardware     = parseNanoseconds(tuple[19], dataFile);
 
-         if(backend & DatabaseBackendType::SQL_Generic) {
+         if(bulkRows) {
+            bulkRows->beginRow();
+            *bulkRows
+               << timePointToNanoseconds<ReaderTimePoint>(sendTimeStamp)
+               << measurementID
+               << sourceIP
+               << destinationIP
+               << (unsigned int)protocol
+               << (unsigned int)trafficClass
+               << burstSeq
+               << packetSize
+               << responseSize
+               << checksum
+               << sourcePort
+               << destinationPort
+               << status
+
+               << timeSource
+               << delayAppSend
+               << delayQueuing
+               << delayAppReceive
+               << rttApp
+               << rttSoftware
+               << rttHardware;
+            bulkRows->endRow();
+            rows++;
+         }
+         else if(backend & DatabaseBackendType::SQL_Generic) {
             statement.beginRow();
             statement
                << timePointToNanoseconds<ReaderTimePoint>(sendTimeStamp) << statement.sep()
@@ -43,7 +43,6 @@ class PingReader : public TracerouteReader
    virtual ~PingReader();
 
    virtual const std::string& getIdentification() const { return Identification; }
-   virtual const std::regex&  getFileNameRegExp() const { return FileNameRegExp; }
 
    virtual void beginParsing(DatabaseClientBase& databaseClient,
                              unsigned long long& rows);
@@ -56,7 +55,9 @@ class PingReader : public TracerouteReader
 
    public:
    static const std::string Identification;
-   static const std::regex  FileNameRegExp;
+
+   private:
+   static const std::vector<BulkColumn> BulkColumns;
 };
 
 #endif
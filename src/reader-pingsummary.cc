@@ -0,0 +1,297 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#include "conversions.h"
+#include "reader-pingsummary.h"
+#include "tools.h"
+
+#include <boost/asio.hpp>
+
+
+const std::string PingSummaryReader::Identification("PingSummary");
+const std::vector<BulkColumn> PingSummaryReader::BulkColumns = {
+   { "WindowStart",     "windowStart",     BCT_BigInt   },
+   { "MeasurementID",   "measurementID",   BCT_Integer  },
+   { "SourceIP",        "sourceIP",        BCT_Address  },
+   { "DestinationIP",   "destinationIP",   BCT_Address  },
+   { "Protocol",        "protocol",        BCT_SmallInt },
+   { "TrafficClass",    "trafficClass",    BCT_SmallInt },
+   { "WindowEnd",       "windowEnd",       BCT_BigInt   },
+   { "PacketSize",      "packetSize",      BCT_Integer  },
+   { "SourcePort",      "sourcePort",      BCT_Integer  },
+   { "DestinationPort", "destinationPort", BCT_Integer  },
+   { "Sent",            "sent",            BCT_Integer  },
+   { "Received",        "received",        BCT_Integer  },
+   { "Lost",            "lost",            BCT_Integer  },
+   { "Errors",          "errors",          BCT_Integer  },
+   { "RTT_Min",         "rtt.min",         BCT_BigInt   },
+   { "RTT_Mean",        "rtt.mean",        BCT_BigInt   },
+   { "RTT_Max",         "rtt.max",         BCT_BigInt   },
+   { "RTT_P50",         "rtt.p50",         BCT_BigInt   },
+   { "RTT_P90",         "rtt.p90",         BCT_BigInt   },
+   { "RTT_P95",         "rtt.p95",         BCT_BigInt   },
+   { "RTT_P99",         "rtt.p99",         BCT_BigInt   }
+};
+
+
+// ###### Constructor #######################################################
+PingSummaryReader::PingSummaryReader(const ImporterConfiguration& importerConfiguration,
+                                     const unsigned int           workers,
+                                     const unsigned int           maxTransactionSize,
+                                     const std::string&           table)
+   : TracerouteReader(importerConfiguration, workers, maxTransactionSize, table)
+{
+}
+
+
+// ###### Destructor ########################################################
+PingSummaryReader::~PingSummaryReader()
+{
+}
+
+
+// ###### Begin parsing #####################################################
+void PingSummaryReader::beginParsing(DatabaseClientBase& databaseClient,
+                                     unsigned long long& rows)
+{
+   const DatabaseBackendType backend = databaseClient.getBackend();
+   Statement& statement              = databaseClient.getStatement("PingSummary", false, true);
+
+   rows = 0;
+
+   // ====== Generate import statement ======================================
+   if(databaseClient.supportsBulkRows()) {
+      databaseClient.getBulkRows("PingSummary", false, true).define(Table, BulkColumns);
+   }
+   else if(backend & DatabaseBackendType::SQL_Generic) {
+      statement
+         << "INSERT INTO " << Table
+         << " (WindowStart,MeasurementID,SourceIP,DestinationIP,Protocol,TrafficClass,WindowEnd,PacketSize,SourcePort,DestinationPort,Sent,Received,Lost,Errors,RTT_Min,RTT_Mean,RTT_Max,RTT_P50,RTT_P90,RTT_P95,RTT_P99) VALUES";
+   }
+   else if(backend & DatabaseBackendType::NoSQL_Generic) {
+      statement << "{ \"" << Table <<  "\": [";
+   }
+   else {
+      throw ResultsLogicException("Unknown output format");
+   }
+}
+
+
+// ###### Finish parsing ####################################################
+bool PingSummaryReader::finishParsing(DatabaseClientBase& databaseClient,
+                                      unsigned long long& rows)
+{
+   const DatabaseBackendType backend   = databaseClient.getBackend();
+   Statement&                statement = databaseClient.getStatement("PingSummary");
+
+   if(databaseClient.supportsBulkRows()) {
+      BulkRows& bulkRows = databaseClient.getBulkRows("PingSummary");
+      assert(bulkRows.getRows() == rows);
+      if(rows > 0) {
+         databaseClient.executeBulkRows(bulkRows);
+         return true;
+      }
+      return false;
+   }
+   assert(statement.getRows() == rows);
+
+   if(rows > 0) {
+      // ====== Generate import statement ===================================
+      if(backend & DatabaseBackendType::SQL_Generic) {
+         databaseClient.executeUpdate(statement);
+      }
+      else if(backend & DatabaseBackendType::NoSQL_Generic) {
+         statement << " \n] }";
+         databaseClient.executeUpdate(statement);
+      }
+      else {
+         throw ResultsLogicException("Unknown output format");
+      }
+      return true;
+   }
+   return false;
+}
+
+
+// ###### Parse input file ##################################################
+void PingSummaryReader::parseContents(
+        DatabaseClientBase&                  databaseClient,
+        unsigned long long&                  rows,
+        const std::filesystem::path&         dataFile,
+        boost::iostreams::filtering_istream& dataStream)
+{
+   Statement&                statement = databaseClient.getStatement("PingSummary");
+   const DatabaseBackendType backend   = databaseClient.getBackend();
+   BulkRows*                 bulkRows  = (databaseClient.supportsBulkRows()) ?
+                                            &databaseClient.getBulkRows("PingSummary") : nullptr;
+   static const unsigned int PingSummaryMinColumns = 21;
+   static const unsigned int PingSummaryMaxColumns = 21;
+   static const char         PingSummaryDelimiter  = ' ';
+
+   LineScanner      scanner(dataStream);
+   std::string_view inputLine;
+   std::string_view tuple[PingSummaryMaxColumns];
+   const ReaderTimePoint now =
+      ReaderClock::now() + ReaderClockOffsetFromSystemTime;
+   while(scanner.nextLine(inputLine)) {
+
+      // ====== Format identifier ===========================================
+      if(inputLine.substr(0, 2) == "#?") {
+         // Nothing to do here!
+         continue;
+      }
+
+      // ====== Parse Ping summary line =====================================
+      if(inputLine.substr(0, 2) == "#S") {
+         const size_t columns = splitFields(inputLine, tuple, PingSummaryMaxColumns, PingSummaryDelimiter);
+         if(columns < PingSummaryMinColumns) {
+            throw ResultsReaderDataErrorException("Too few columns in input file " +
+                                                  relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+         }
+
+         // ====== Generate import statement ================================
+         const char                     protocol        = tuple[0][2];
+         const unsigned int             measurementID   = parseMeasurementID(tuple[1], dataFile);
+         const boost::asio::ip::address sourceIP        = parseAddress(tuple[2], dataFile);
+         const boost::asio::ip::address destinationIP   = parseAddress(tuple[3], dataFile);
+         const ReaderTimePoint          windowStart     = parseTimeStamp(tuple[4], now, true, dataFile);
+         const ReaderTimePoint          windowEnd       = parseTimeStamp(tuple[5], now, true, dataFile);
+         const uint8_t                  trafficClass    = parseTrafficClass(tuple[6], dataFile);
+         const unsigned int             packetSize      = parsePacketSize(tuple[7], dataFile);
+         const uint16_t                 sourcePort      = parsePort(tuple[8], dataFile);
+         const uint16_t                 destinationPort = parsePort(tuple[9], dataFile);
+         const unsigned int             sent            = parseCount(tuple[10], dataFile);
+         const unsigned int             received        = parseCount(tuple[11], dataFile);
+         const unsigned int             lost            = parseCount(tuple[12], dataFile);
+         const unsigned int             errors          = parseCount(tuple[13], dataFile);
+
+         const long long                rttMin          = parseNanoseconds(tuple[14], dataFile);
+         const long long                rttMean         = parseNanoseconds(tuple[15], dataFile);
+         const long long                rttMax          = parseNanoseconds(tuple[16], dataFile);
+         const long long                rttP50          = parseNanoseconds(tuple[17], dataFile);
+         const long long                rttP90          = parseNanoseconds(tuple[18], dataFile);
+         const long long                rttP95          = parseNanoseconds(tuple[19], dataFile);
+         const long long                rttP99          = parseNanoseconds(tuple[20], dataFile);
+
+         if(bulkRows) {
+            bulkRows->beginRow();
+            *bulkRows
+               << timePointToNanoseconds<ReaderTimePoint>(windowStart)
+               << measurementID
+               << sourceIP
+               << destinationIP
+               << (unsigned int)protocol
+               << (unsigned int)trafficClass
+               << timePointToNanoseconds<ReaderTimePoint>(windowEnd)
+               << packetSize
+               << sourcePort
+               << destinationPort
+               << sent
+               << received
+               << lost
+               << errors
+
+               << rttMin
+               << rttMean
+               << rttMax
+               << rttP50
+               << rttP90
+               << rttP95
+               << rttP99;
+            bulkRows->endRow();
+            rows++;
+         }
+         else if(backend & DatabaseBackendType::SQL_Generic) {
+            statement.beginRow();
+            statement
+               << timePointToNanoseconds<ReaderTimePoint>(windowStart)   << statement.sep()
+               << measurementID                                          << statement.sep()
+               << statement.encodeAddress(sourceIP)                      << statement.sep()
+               << statement.encodeAddress(destinationIP)                 << statement.sep()
+               << (unsigned int)protocol                                 << statement.sep()
+               << (unsigned int)trafficClass                             << statement.sep()
+               << timePointToNanoseconds<ReaderTimePoint>(windowEnd)     << statement.sep()
+               << packetSize                                             << statement.sep()
+               << sourcePort                                             << statement.sep()
+               << destinationPort                                        << statement.sep()
+               << sent                                                   << statement.sep()
+               << received                                               << statement.sep()
+               << lost                                                   << statement.sep()
+               << errors                                                 << statement.sep()
+
+               << rttMin                                                 << statement.sep()
+               << rttMean                                                << statement.sep()
+               << rttMax                                                 << statement.sep()
+               << rttP50                                                 << statement.sep()
+               << rttP90                                                 << statement.sep()
+               << rttP95                                                 << statement.sep()
+               << rttP99;
+            statement.endRow();
+            rows++;
+         }
+         else if(backend & DatabaseBackendType::NoSQL_Generic) {
+            statement.beginRow();
+            statement
+               << "\"windowStart\":"     << timePointToNanoseconds<ReaderTimePoint>(windowStart)   << statement.sep()
+               << "\"measurementID\":"   << measurementID                                          << statement.sep()
+               << "\"sourceIP\":"        << statement.encodeAddress(sourceIP)                      << statement.sep()
+               << "\"destinationIP\":"   << statement.encodeAddress(destinationIP)                 << statement.sep()
+               << "\"protocol\":"        << (unsigned int)protocol                                 << statement.sep()
+               << "\"trafficClass\":"    << (unsigned int)trafficClass                             << statement.sep()
+               << "\"windowEnd\":"       << timePointToNanoseconds<ReaderTimePoint>(windowEnd)     << statement.sep()
+               << "\"packetSize\":"      << packetSize                                             << statement.sep()
+               << "\"sourcePort\":"      << sourcePort                                             << statement.sep()
+               << "\"destinationPort\":" << destinationPort                                        << statement.sep()
+               << "\"sent\":"            << sent                                                   << statement.sep()
+               << "\"received\":"        << received                                               << statement.sep()
+               << "\"lost\":"            << lost                                                   << statement.sep()
+               << "\"errors\":"          << errors                                                 << statement.sep()
+
+               << "\"rtt.min\":"         << rttMin                                                 << statement.sep()
+               << "\"rtt.mean\":"        << rttMean                                                << statement.sep()
+               << "\"rtt.max\":"         << rttMax                                                 << statement.sep()
+               << "\"rtt.p50\":"         << rttP50                                                 << statement.sep()
+               << "\"rtt.p90\":"         << rttP90                                                 << statement.sep()
+               << "\"rtt.p95\":"         << rttP95                                                 << statement.sep()
+               << "\"rtt.p99\":"         << rttP99;
+
+            statement.endRow();
+            rows++;
+         }
+         else {
+            throw ResultsLogicException("Unknown output format");
+         }
+      }
+
+      else {
+         throw ResultsReaderDataErrorException("Unexpected input in input file " +
+                                               relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+      }
+   }
+}
@@ -0,0 +1,63 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#ifndef READER_PINGSUMMARY
+#define READER_PINGSUMMARY
+
+#include "reader-traceroute.h"
+
+
+class PingSummaryReader : public TracerouteReader
+{
+   public:
+   PingSummaryReader(const ImporterConfiguration& importerConfiguration,
+                     const unsigned int           workers            = 1,
+                     const unsigned int           maxTransactionSize = 4,
+                     const std::string&           table              = "PingSummary");
+   virtual ~PingSummaryReader();
+
+   virtual const std::string& getIdentification() const { return Identification; }
+
+   virtual void beginParsing(DatabaseClientBase& databaseClient,
+                             unsigned long long& rows);
+   virtual bool finishParsing(DatabaseClientBase& databaseClient,
+                              unsigned long long& rows);
+   virtual void parseContents(DatabaseClientBase&                  databaseClient,
+                              unsigned long long&                  rows,
+                              const std::filesystem::path&         dataFile,
+                              boost::iostreams::filtering_istream& dataStream);
+
+   public:
+   static const std::string Identification;
+
+   private:
+   static const std::vector<BulkColumn> BulkColumns;
+};
+
+#endif
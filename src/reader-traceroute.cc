@@ -33,13 +33,69 @@
 
 #include <boost/crc.hpp>
 
-
-const std::string  TracerouteReader::Identification("Traceroute");
-const std::regex   TracerouteReader::FileNameRegExp(
-   // Format: Traceroute-(Protocol-|)[P#]<ID>-<Source>-<YYYYMMDD>T<Seconds.Microseconds>-<Sequence>.(hpct|results)(<.xz|.bz2|.gz|>)
-   "^Traceroute-([A-Z]+-|)([#P])([0-9]+)-([0-9a-f:\\.]+)-([0-9]{8}T[0-9]+\\.[0-9]{6})-([0-9]*)\\.(hpct|results)(\\.xz|\\.bz2|\\.gz|)$"
-);
-const unsigned int TracerouteReader::FileNameRegExpMatchSize = 9;   // Number if groups in regexp above
+#include <climits>
+
+
+const std::string TracerouteReader::Identification("Traceroute");
+const std::vector<BulkColumn> TracerouteReader::BulkColumns = {
+   { "Timestamp",        nullptr, BCT_BigInt   },
+   { "MeasurementID",    nullptr, BCT_Integer  },
+   { "SourceIP",         nullptr, BCT_Address  },
+   { "DestinationIP",    nullptr, BCT_Address  },
+   { "Protocol",         nullptr, BCT_SmallInt },
+   { "TrafficClass",     nullptr, BCT_SmallInt },
+   { "RoundNumber",      nullptr, BCT_Integer  },
+   { "HopNumber",        nullptr, BCT_SmallInt },
+   { "TotalHops",        nullptr, BCT_SmallInt },
+   { "PacketSize",       nullptr, BCT_Integer  },
+   { "ResponseSize",     nullptr, BCT_Integer  },
+   { "Checksum",         nullptr, BCT_Integer  },
+   { "SourcePort",       nullptr, BCT_Integer  },
+   { "DestinationPort",  nullptr, BCT_Integer  },
+   { "Status",           nullptr, BCT_SmallInt },
+   { "PathHash",         nullptr, BCT_BigInt   },
+   { "SendTimestamp",    nullptr, BCT_BigInt   },
+   { "HopIP",            nullptr, BCT_Address  },
+   { "TimeSource",       nullptr, BCT_Integer  },
+   { "Delay_AppSend",    nullptr, BCT_BigInt   },
+   { "Delay_Queuing",    nullptr, BCT_BigInt   },
+   { "Delay_AppReceive", nullptr, BCT_BigInt   },
+   { "RTT_App",          nullptr, BCT_BigInt   },
+   { "RTT_SW",           nullptr, BCT_BigInt   },
+   { "RTT_HW",           nullptr, BCT_BigInt   }
+};
+// For document-oriented backends, there is one document per traceroute,
+// with the hops as nested documents:
+const std::vector<BulkColumn> TracerouteReader::HopColumns = {
+   { "SendTimestamp",    "sendTimestamp", BCT_BigInt  },
+   { "ResponseSize",     "responseSize",  BCT_Integer },
+   { "HopIP",            "hopIP",         BCT_Address },
+   { "Status",           "status",        BCT_Integer },
+   { "TimeSource",       "timeSource",    BCT_Integer },
+   { "Delay_AppSend",    "delay.appSend", BCT_BigInt  },
+   { "Delay_Queuing",    "delay.queuing", BCT_BigInt  },
+   { "Delay_AppReceive", "delay.appRecv", BCT_BigInt  },
+   { "RTT_App",          "rtt.app",       BCT_BigInt  },
+   { "RTT_SW",           "rtt.sw",        BCT_BigInt  },
+   { "RTT_HW",           "rtt.hw",        BCT_BigInt  }
+};
+const std::vector<BulkColumn> TracerouteReader::DocumentColumns = {
+   { "Timestamp",       "timestamp",       BCT_BigInt,   nullptr     },
+   { "MeasurementID",   "measurementID",   BCT_Integer,  nullptr     },
+   { "SourceIP",        "sourceIP",        BCT_Address,  nullptr     },
+   { "DestinationIP",   "destinationIP",   BCT_Address,  nullptr     },
+   { "Protocol",        "protocol",        BCT_SmallInt, nullptr     },
+   { "TrafficClass",    "trafficClass",    BCT_SmallInt, nullptr     },
+   { "RoundNumber",     "roundNumber",     BCT_Integer,  nullptr     },
+   { "PacketSize",      "packetSize",      BCT_Integer,  nullptr     },
+   { "Checksum",        "checksum",        BCT_Integer,  nullptr     },
+   { "SourcePort",      "sourcePort",      BCT_Integer,  nullptr     },
+   { "DestinationPort", "destinationPort", BCT_Integer,  nullptr     },
+   { "StatusFlags",     "statusFlags",     BCT_Integer,  nullptr     },
+   { "TotalHops",       "totalHops",       BCT_SmallInt, nullptr     },
+   { "PathHash",        "pathHash",        BCT_BigInt,   nullptr     },
+   { "Hops",            "hops",            BCT_Rows,     &HopColumns }
+};
 
 
 // ###### < operator for sorting ############################################
@@ -85,49 +141,63 @@ std::ostream& operator<<(std::ostream& os, const TracerouteFileEntry& entry)
 }
 
 
+// ###### Get number from file name part ####################################
+// Same result as atol() for a string of decimal digits, i.e. 0 if empty
+// and LONG_MAX on overflow.
+static long fileNameNumber(const std::string_view value)
+{
+   long number = 0;
+   if(parseNumber(value, number) == std::errc::result_out_of_range) {
+      return LONG_MAX;
+   }
+   return number;
+}
+
+
 // ###### Make TracerouteFileEntry from file name  ##########################
 int makeInputFileEntry(const std::filesystem::path& dataFile,
-                       const std::smatch            match,
+                       const ResultsFileName&       resultsFileName,
                        TracerouteFileEntry&         inputFileEntry,
                        const unsigned int           workers)
 {
-   if(match.size() == TracerouteReader::FileNameRegExpMatchSize) {
-      // ====== Extract information from file name ==========================
-      ReaderTimePoint timeStamp;
-      if(stringToTimePoint<ReaderTimePoint>(match[5].str(), timeStamp, "%Y%m%dT%H%M%S")) {
-         inputFileEntry.Source    = match[4];
-         inputFileEntry.TimeStamp = timeStamp;
-         inputFileEntry.SeqNumber = atol(match[6].str().c_str());
-         inputFileEntry.DataFile  = dataFile;
-
-         // ====== Map file to worker =======================================
-         uint32_t sourceIdentifier;
-         if( (inputFileEntry.Source == "::") || (inputFileEntry.Source == "0.0.0.0") ) {
-            // Source is unspecific -> use Process ID or Measurement ID:
-            sourceIdentifier = (uint32_t)atol(match[3].str().c_str());
-         }
-         else {
-            sourceIdentifier = 0;
-         }
+   // ====== Extract information from file name =============================
+   ReaderTimePoint timeStamp;
+   if(parseResultsFileTimeStamp(resultsFileName.TimeStamp, timeStamp)) {
+      inputFileEntry.Source    = resultsFileName.Source;
+      inputFileEntry.TimeStamp = timeStamp;
+      inputFileEntry.SeqNumber = fileNameNumber(resultsFileName.SeqNumber);
+      inputFileEntry.DataFile  = dataFile;
+
+      // ====== Map file to worker ==========================================
+      uint32_t sourceIdentifier;
+      const std::string_view address =
+         resultsFileName.Source.substr(0, resultsFileName.Source.find('%'));
+      if( (address == "::") || (address == "0.0.0.0") ) {
+         // Source is unspecific -> use Process ID or Measurement ID:
+         sourceIdentifier = (uint32_t)fileNameNumber(resultsFileName.ID);
+      }
+      else {
+         sourceIdentifier = 0;
+      }
 
-         // Addresses are somewhat systematic
-         // => Using CRC32 as hash algorithm, for improved worker mapping.
-         boost::crc_32_type crc32hasher;
-         crc32hasher.process_bytes(inputFileEntry.Source.data(),
-                                   inputFileEntry.Source.length());
-         crc32hasher.process_bytes((const char*)&sourceIdentifier,
-                                   sizeof(sourceIdentifier));
-         const uint32_t hash = crc32hasher.checksum();
-         const int workerID = hash % workers;
+      // Addresses are somewhat systematic
+      // => Using CRC32 as hash algorithm, for improved worker mapping.
+      boost::crc_32_type crc32hasher;
+      crc32hasher.process_bytes(inputFileEntry.Source.data(),
+                                inputFileEntry.Source.length());
+      crc32hasher.process_bytes((const char*)&sourceIdentifier,
+                                sizeof(sourceIdentifier));
+      const uint32_t hash = crc32hasher.checksum();
+      const int workerID = hash % workers;
+      inputFileEntry.SourceHash = hash;
 /*
-         std::cout << inputFileEntry.Source << "\t"
-                   << timePointToString<ReaderTimePoint>(inputFileEntry.TimeStamp, 6)
-                   << "\t" << inputFileEntry.SeqNumber << "\t"
-                   << inputFileEntry.DataFile
-                   << " -> " << workerID << "\n";
+      std::cout << inputFileEntry.Source << "\t"
+                << timePointToString<ReaderTimePoint>(inputFileEntry.TimeStamp, 6)
+                << "\t" << inputFileEntry.SeqNumber << "\t"
+                << inputFileEntry.DataFile
+                << " -> " << workerID << "\n";
 */
-         return workerID;
-      }
+      return workerID;
    }
    return -1;
 }
@@ -161,276 +231,182 @@ TracerouteReader::~TracerouteReader()
 { }
 
 
+// ###### Throw exception for bad value in input file #######################
+void TracerouteReader::throwBadValue(const char*                  message,
+                                     const std::string_view       value,
+                                     const std::filesystem::path& dataFile,
+                                     const std::errc              ec,
+                                     const char*                  conversion) const
+{
+   std::string what(message);
+   what.append(value);
+   what += " in input file " + relativeTo(dataFile, ImporterConfig.getImportFilePath()).string();
+   // Like the former std::stoul()/std::stoull() parsing, only name the
+   // failed conversion, but not trailing characters after a number:
+   if( (ec != std::errc()) && (ec != ParseTrailingCharacters) ) {
+      what += ": ";
+      what += (conversion != nullptr) ? conversion : std::make_error_code(ec).message();
+   }
+   throw ResultsReaderDataErrorException(what);
+}
+
+
 // ###### Parse measurement ID ##############################################
-unsigned long long TracerouteReader::parseMeasurementID(const std::string&           value,
+unsigned long long TracerouteReader::parseMeasurementID(const std::string_view       value,
                                                         const std::filesystem::path& dataFile)
 {
-   size_t index;
-   try {
-      const unsigned long long measurementID = std::stoull(value, &index, 10);
-      if(index == value.size()) {
-         return measurementID;
-      }
+   unsigned long long measurementID;
+   const std::errc    ec = parseNumber(value, measurementID);
+   if(ec != std::errc()) {
+      throwBadValue("Bad measurement ID value ", value, dataFile, ec, "stoull");
    }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad measurement ID value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   throw ResultsReaderDataErrorException("Bad measurement ID value " + value +
-                                         " in input file " +
-                                         relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   return measurementID;
 }
 
 
-// ###### Parse time stamp ##################################################
-boost::asio::ip::address TracerouteReader::parseAddress(const std::string&           value,
+// ###### Parse address #####################################################
+boost::asio::ip::address TracerouteReader::parseAddress(const std::string_view       value,
                                                         const std::filesystem::path& dataFile)
 {
-   try {
-      const boost::asio::ip::address address = boost::asio::ip::make_address(value);
-      return address;
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad address " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   throw ResultsReaderDataErrorException("Bad address " + value +
-                                         " in input file " +
-                                         relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   boost::asio::ip::address address;
+   if(!::parseAddress(value, address)) {
+      throwBadValue("Bad address ", value, dataFile, std::errc::invalid_argument);
+   }
+   return address;
 }
 
 
 // ###### Parse time stamp ##################################################
-ReaderTimePoint TracerouteReader::parseTimeStamp(const std::string&           value,
+ReaderTimePoint TracerouteReader::parseTimeStamp(const std::string_view       value,
                                                  const ReaderTimePoint&       now,
                                                  const bool                   inNanoseconds,
                                                  const std::filesystem::path& dataFile)
 {
-   size_t             index = 0;
-   unsigned long long ts    = 0;
-   try {
-      ts = std::stoull(value, &index, 16);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad time stamp format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index == value.size()) {
-      const ReaderTimePoint timeStamp = (inNanoseconds == true) ? nanosecondsToTimePoint<ReaderTimePoint>(ts) :
-                                                                  nanosecondsToTimePoint<ReaderTimePoint>(1000ULL * ts);
-      if( (timeStamp < now - std::chrono::hours(10 * 365 * 24)) ||   /* 10 years in the past */
-          (timeStamp > now + std::chrono::hours(24)) ) {             /* 1 day in the future  */
-         std::cerr << "timeStamp=" << timePointToString<ReaderTimePoint>(timeStamp, 9) << " now=" <<  timePointToString<ReaderTimePoint>(now, 9) << "\n";
-         throw ResultsReaderDataErrorException("Invalid time stamp value (too old, or in the future) " + value +
-                                               " in input file " +
-                                               relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
-      }
-      return timeStamp;
-   }
-   throw ResultsReaderDataErrorException("Bad time stamp format " + value +
-                                         " in input file " +
-                                         relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long long ts;
+   const std::errc    ec = parseNumber(value, ts, 16);
+   if(ec != std::errc()) {
+      throwBadValue("Bad time stamp format ", value, dataFile, ec, "stoull");
+   }
+   const ReaderTimePoint timeStamp = (inNanoseconds == true) ? nanosecondsToTimePoint<ReaderTimePoint>(ts) :
+                                                               nanosecondsToTimePoint<ReaderTimePoint>(1000ULL * ts);
+   if( (timeStamp < now - std::chrono::hours(10 * 365 * 24)) ||   /* 10 years in the past */
+       (timeStamp > now + std::chrono::hours(24)) ) {             /* 1 day in the future  */
+      std::cerr << "timeStamp=" << timePointToString<ReaderTimePoint>(timeStamp, 9) << " now=" <<  timePointToString<ReaderTimePoint>(now, 9) << "\n";
+      throwBadValue("Invalid time stamp value (too old, or in the future) ", value, dataFile);
+   }
+   return timeStamp;
 }
 
 
 // ###### Parse round number ################################################
-unsigned int TracerouteReader::parseRoundNumber(const std::string&           value,
+unsigned int TracerouteReader::parseRoundNumber(const std::string_view       value,
                                                 const std::filesystem::path& dataFile)
 {
-   size_t        index       = 0;
-   unsigned long roundNumber = 0;
-   try {
-      roundNumber = std::stoul(value, &index, 10);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad round number " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad round number " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long   roundNumber;
+   const std::errc ec = parseNumber(value, roundNumber);
+   if(ec != std::errc()) {
+      throwBadValue("Bad round number ", value, dataFile, ec, "stoul");
    }
    return roundNumber;
 }
 
 
 // ###### Parse traffic class ###############################################
-uint8_t TracerouteReader::parseTrafficClass(const std::string&           value,
+uint8_t TracerouteReader::parseTrafficClass(const std::string_view       value,
                                             const std::filesystem::path& dataFile)
 {
-   size_t        index        = 0;
-   unsigned long trafficClass = 0;
-   try {
-      trafficClass = std::stoul(value, &index, 16);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad traffic class format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad traffic class format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long   trafficClass;
+   const std::errc ec = parseNumber(value, trafficClass, 16);
+   if(ec != std::errc()) {
+      throwBadValue("Bad traffic class format ", value, dataFile, ec, "stoul");
    }
    if(trafficClass > 0xff) {
-      throw ResultsReaderDataErrorException("Invalid traffic class value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+      throwBadValue("Invalid traffic class value ", value, dataFile);
    }
    return (uint8_t)trafficClass;
 }
 
 
 // ###### Parse packet size #################################################
-unsigned int TracerouteReader::parsePacketSize(const std::string&           value,
+unsigned int TracerouteReader::parsePacketSize(const std::string_view       value,
                                                const std::filesystem::path& dataFile)
 {
-   size_t        index      = 0;
-   unsigned long packetSize = 0;
-   try {
-      packetSize = std::stoul(value, &index, 10);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad packet size format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad packet size format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long   packetSize;
+   const std::errc ec = parseNumber(value, packetSize);
+   if(ec != std::errc()) {
+      throwBadValue("Bad packet size format ", value, dataFile, ec, "stoul");
    }
    return packetSize;
 }
 
 
-// ###### Parse response size #################################################
-unsigned int TracerouteReader::parseResponseSize(const std::string&           value,
-                                                const std::filesystem::path& dataFile)
+// ###### Parse response size ###############################################
+unsigned int TracerouteReader::parseResponseSize(const std::string_view       value,
+                                                 const std::filesystem::path& dataFile)
 {
-   size_t        index      = 0;
-   unsigned long responseSize = 0;
-   try {
-      responseSize = std::stoul(value, &index, 10);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad response size format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad response size format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long   responseSize;
+   const std::errc ec = parseNumber(value, responseSize);
+   if(ec != std::errc()) {
+      throwBadValue("Bad response size format ", value, dataFile, ec, "stoul");
    }
    return responseSize;
 }
 
 
 // ###### Parse checksum ####################################################
-uint16_t TracerouteReader::parseChecksum(const std::string&           value,
+uint16_t TracerouteReader::parseChecksum(const std::string_view       value,
                                          const std::filesystem::path& dataFile)
 {
-   size_t        index    = 0;
-   unsigned long checksum = 0;
-   try {
-      checksum = std::stoul(value, &index, 16);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad checksum format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad checksum format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long   checksum;
+   const std::errc ec = parseNumber(value, checksum, 16);
+   if(ec != std::errc()) {
+      throwBadValue("Bad checksum format ", value, dataFile, ec, "stoul");
    }
    if(checksum > 0xffff) {
-      throw ResultsReaderDataErrorException("Invalid checksum value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+      throwBadValue("Invalid checksum value ", value, dataFile);
    }
    return (uint16_t)checksum;
 }
 
 
 // ###### Parse port ########################################################
-uint16_t TracerouteReader::parsePort(const std::string&           value,
+uint16_t TracerouteReader::parsePort(const std::string_view       value,
                                      const std::filesystem::path& dataFile)
 {
-   size_t        index = 0;
-   unsigned long port  = 0;
-   try {
-      port = std::stoul(value, &index, 10);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad port format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad port format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long   port;
+   const std::errc ec = parseNumber(value, port);
+   if(ec != std::errc()) {
+      throwBadValue("Bad port format ", value, dataFile, ec, "stoul");
    }
    if(port > 65535) {
-      throw ResultsReaderDataErrorException("Invalid port value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+      throwBadValue("Invalid port value ", value, dataFile);
    }
    return (uint16_t)port;
 }
 
 
 // ###### Parse status ######################################################
-unsigned int TracerouteReader::parseStatus(const std::string&           value,
+unsigned int TracerouteReader::parseStatus(const std::string_view       value,
                                            const std::filesystem::path& dataFile,
                                            const unsigned int           base)
 {
-   size_t        index  = 0;
-   unsigned long status = 0;
-   try {
-      status = std::stoul(value, &index, base);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad status format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad status format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long   status;
+   const std::errc ec = parseNumber(value, status, (int)base);
+   if(ec != std::errc()) {
+      throwBadValue("Bad status format ", value, dataFile, ec, "stoul");
    }
    return status;
 }
 
 
 // ###### Parse path hash ###################################################
-long long TracerouteReader::parsePathHash(const std::string&           value,
+long long TracerouteReader::parsePathHash(const std::string_view       value,
                                           const std::filesystem::path& dataFile)
 {
-   size_t   index    = 0;
-   uint64_t pathHash = 0;
-   try {
-      pathHash = std::stoull(value, &index, 16);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad path hash " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad path hash " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   uint64_t        pathHash;
+   const std::errc ec = parseNumber(value, pathHash, 16);
+   if(ec != std::errc()) {
+      throwBadValue("Bad path hash ", value, dataFile, ec, "stoull");
    }
    // Cast to signed long long as-is:
    return (long long)pathHash;
@@ -438,107 +414,76 @@ long long TracerouteReader::parsePathHash(const std::string&           value,
 
 
 // ###### Parse total number of hops ########################################
-unsigned int TracerouteReader::parseTotalHops(const std::string&           value,
+unsigned int TracerouteReader::parseTotalHops(const std::string_view       value,
                                               const std::filesystem::path& dataFile)
 {
-   size_t        index     = 0;
-   unsigned long totalHops = 0;
-   try {
-      totalHops = std::stoul(value, &index, 10);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad total hops value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad total hops value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long   totalHops;
+   const std::errc ec = parseNumber(value, totalHops);
+   if(ec != std::errc()) {
+      throwBadValue("Bad total hops value ", value, dataFile, ec, "stoul");
    }
    if( (totalHops < 1) || (totalHops > 255) ) {
-      throw ResultsReaderDataErrorException("Invalid total hops value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+      throwBadValue("Invalid total hops value ", value, dataFile);
    }
    return totalHops;
 }
 
 
 // ###### Parse hop number ##################################################
-unsigned int TracerouteReader::parseHopNumber(const std::string&           value,
+unsigned int TracerouteReader::parseHopNumber(const std::string_view       value,
                                               const std::filesystem::path& dataFile)
 {
-   size_t        index     = 0;
-   unsigned long hopNumber = 0;
-   try {
-      hopNumber = std::stoul(value, &index, 10);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad hop number value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad hop number value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned long   hopNumber;
+   const std::errc ec = parseNumber(value, hopNumber);
+   if(ec != std::errc()) {
+      throwBadValue("Bad hop number value ", value, dataFile, ec, "stoul");
    }
    if( (hopNumber < 1) || (hopNumber > 255) ) {
-      throw ResultsReaderDataErrorException("Invalid hop number value " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+      throwBadValue("Invalid hop number value ", value, dataFile);
    }
    return hopNumber;
 }
 
 
-// ###### Parse packet size #################################################
-unsigned int TracerouteReader::parseTimeSource(const std::string&           value,
+// ###### Parse time source #################################################
+unsigned int TracerouteReader::parseTimeSource(const std::string_view       value,
                                                const std::filesystem::path& dataFile)
 {
-   size_t       index      = 0;
-   unsigned int timeSource = 0;
-   try {
-      timeSource = std::stoul(value, &index, 16);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad time source format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad time source format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   unsigned int    timeSource;
+   const std::errc ec = parseNumber(value, timeSource, 16);
+   if(ec != std::errc()) {
+      throwBadValue("Bad time source format ", value, dataFile, ec, "stoul");
    }
    return timeSource;
 }
 
 
-// ###### Parse nanoseconds ################################################
-long long TracerouteReader::parseNanoseconds(const std::string&           value,
+// ###### Parse nanoseconds #################################################
+long long TracerouteReader::parseNanoseconds(const std::string_view       value,
                                              const std::filesystem::path& dataFile)
 {
-   size_t        index = 0;
-   unsigned long ns    = 0;
-   try {
-      ns = std::stoul(value, &index, 10);
-   }
-   catch(std::exception& e) {
-      throw ResultsReaderDataErrorException("Bad nanoseconds format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string() + ": " + e.what());
-   }
-   if(index != value.size()) {
-      throw ResultsReaderDataErrorException("Bad nanoseconds format " + value +
-                                            " in input file " +
-                                            relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
+   long long       ns;
+   const std::errc ec = parseNumber(value, ns);
+   if(ec != std::errc()) {
+      throwBadValue("Bad nanoseconds format ", value, dataFile, ec, "stoul");
    }
    return ns;
 }
 
 
+// ###### Parse count #######################################################
+unsigned int TracerouteReader::parseCount(const std::string_view       value,
+                                          const std::filesystem::path& dataFile)
+{
+   unsigned long   count;
+   const std::errc ec = parseNumber(value, count);
+   if(ec != std::errc()) {
+      throwBadValue("Bad count format ", value, dataFile, ec, "stoul");
+   }
+   return count;
+}
+
+
 // ###### Begin parsing #####################################################
 void TracerouteReader::beginParsing(DatabaseClientBase& databaseClient,
                                     unsigned long long& rows)
@@ -549,7 +494,11 @@ void TracerouteReader::beginParsing(DatabaseClientBase& databaseClient,
    rows = 0;
 
    // ====== Generate import statement ======================================
-   if(backend & DatabaseBackendType::SQL_Generic) {
+   if(databaseClient.supportsBulkRows()) {
+      databaseClient.getBulkRows("Traceroute", false, true).define(
+         Table, (backend & DatabaseBackendType::NoSQL_Generic) ? DocumentColumns : BulkColumns);
+   }
+   else if(backend & DatabaseBackendType::SQL_Generic) {
       statement
          << "INSERT INTO " << Table
          << " (Timestamp,MeasurementID,SourceIP,DestinationIP,Protocol,TrafficClass,RoundNumber,HopNumber,TotalHops,PacketSize,ResponseSize,Checksum,SourcePort,DestinationPort,Status,PathHash,SendTimestamp,HopIP,TimeSource,Delay_AppSend,Delay_Queuing,Delay_AppReceive,RTT_App,RTT_SW,RTT_HW) VALUES";
@@ -569,6 +518,16 @@ bool TracerouteReader::finishParsing(DatabaseClientBase& databaseClient,
 {
    const DatabaseBackendType backend   = databaseClient.getBackend();
    Statement&                statement = databaseClient.getStatement("Traceroute");
+
+   if(databaseClient.supportsBulkRows()) {
+      BulkRows& bulkRows = databaseClient.getBulkRows("Traceroute");
+      assert(bulkRows.getRows() == rows);
+      if(rows > 0) {
+         databaseClient.executeBulkRows(bulkRows);
+         return true;
+      }
+      return false;
+   }
    assert(statement.getRows() == rows);
 
    if(rows > 0) {
@@ -608,6 +567,8 @@ void TracerouteReader::parseContents(
 {
    Statement&                statement = databaseClient.getStatement("Traceroute");
    const DatabaseBackendType backend   = databaseClient.getBackend();
+   BulkRows*                 bulkRows  = (databaseClient.supportsBulkRows()) ?
+                                            &databaseClient.getBulkRows("Traceroute") : nullptr;
    static const unsigned int TracerouteMinColumns = 4;
    static const unsigned int TracerouteMaxColumns = 14;
    static const char         TracerouteDelimiter  = ' ';
@@ -627,40 +588,53 @@ void TracerouteReader::parseContents(
    long long                 pathHash        = 0;
    uint8_t                   trafficClass    = 0x00;
    unsigned int              packetSize      = 0;
+   bool                      firstHop        = true;
    unsigned long long        oldTimeStamp;   // Just used for version 1 conversion!
-
-   std::string inputLine;
-   std::string tuple[TracerouteMaxColumns];
+   BulkRows*                 hopRows         = nullptr;
+
+   LineScanner             scanner(dataStream);
+   std::string_view        inputLine;
+   std::string             convertedLine;   // Storage for expanded/converted lines
+   std::string_view        tuple[TracerouteMaxColumns];
+   TracerouteExpander      expander;
+   std::deque<std::string> expandedLines;
    const ReaderTimePoint now =
       ReaderClock::now() + ReaderClockOffsetFromSystemTime;
-   while(std::getline(dataStream, inputLine)) {
+   while( (!expandedLines.empty()) || (scanner.nextLine(inputLine)) ) {
+      if(!expandedLines.empty()) {
+         convertedLine = std::move(expandedLines.front());
+         inputLine     = convertedLine;
+         expandedLines.pop_front();
+      }
 
       // ====== Format identifier ===========================================
-      if(inputLine.substr(0, 2) == "#?") {
+      else if(inputLine.substr(0, 2) == "#?") {
          // Nothing to do here!
          continue;
       }
 
-      // ====== Conversion from old versions ================================
-      if(inputLine.substr(0, 3) == "#T ") {
-         version = 1;
-      }
-      if(version < 2) {
-         inputLine = convertOldTracerouteLine(inputLine, oldTimeStamp);
+      // ====== Unchanged path -> expand to full record =====================
+      else if(inputLine.substr(0, 2) == "#U") {
+         expander.expand(inputLine, expandedLines);
+         continue;
       }
 
-      // ====== Parse Traceroute line =======================================
-      size_t columns = 0;
-      size_t start;
-      size_t end = 0;
-      while((start = inputLine.find_first_not_of(TracerouteDelimiter, end)) != std::string::npos) {
-         end = inputLine.find(TracerouteDelimiter, start);
-         if(columns == TracerouteMaxColumns) {
-            // Skip additional columns
-            break;
+      // ====== Conversion from old versions ================================
+      else {
+         if(inputLine.substr(0, 3) == "#T ") {
+            version = 1;
+         }
+         if(version < 2) {
+            convertedLine = convertOldTracerouteLine(std::string(inputLine), oldTimeStamp);
+            inputLine     = convertedLine;
+         }
+         else {
+            expander.learn(inputLine);
          }
-         tuple[columns++] = inputLine.substr(start, end - start);
       }
+
+      // ====== Parse Traceroute line =======================================
+      const size_t columns = splitFields(inputLine, tuple, TracerouteMaxColumns, TracerouteDelimiter);
       if(columns < TracerouteMinColumns) {
          throw ResultsReaderDataErrorException("Too few columns in input file " +
                                                relativeTo(dataFile, ImporterConfig.getImportFilePath()).string());
@@ -669,8 +643,13 @@ void TracerouteReader::parseContents(
       // ====== Generate import statement ===================================
       if( (tuple[0].size() >= 3) && (tuple[0][0] == '#') && (tuple[0][1] == 'T') ) {
          if( (statusFlags != ~0U) && (backend & DatabaseBackendType::NoSQL_Generic) ) {
-            statement << "]";
-            statement.endRow();
+            if(bulkRows) {
+               bulkRows->endRow();
+            }
+            else {
+               statement << "]";
+               statement.endRow();
+            }
             rows++;
          }
 
@@ -689,7 +668,26 @@ void TracerouteReader::parseContents(
          statusFlags     = parseStatus(tuple[12], dataFile);
          pathHash        = parsePathHash(tuple[13], dataFile);
 
-         if(backend & DatabaseBackendType::NoSQL_Generic) {
+         if( (bulkRows) && (backend & DatabaseBackendType::NoSQL_Generic) ) {
+            bulkRows->beginRow();
+            *bulkRows
+               << timePointToNanoseconds<ReaderTimePoint>(timeStamp)
+               << measurementID
+               << sourceIP
+               << destinationIP
+               << (unsigned int)protocol
+               << (unsigned int)trafficClass
+               << roundNumber
+               << packetSize
+               << checksum
+               << sourcePort
+               << destinationPort
+               << statusFlags
+               << totalHops
+               << pathHash;
+            hopRows = &bulkRows->beginNestedRows();
+         }
+         else if(backend & DatabaseBackendType::NoSQL_Generic) {
             statement.beginRow();
             statement
                << "\"timestamp\":"       << timePointToNanoseconds<ReaderTimePoint>(timeStamp) << statement.sep()
@@ -707,14 +705,15 @@ void TracerouteReader::parseContents(
                << "\"totalHops\":"       << totalHops                                          << statement.sep()
                << "\"pathHash\":"        << pathHash                                           << statement.sep()
                << "\"hops\": [ ";
+            firstHop = true;
          }
       }
       else if( (tuple[0].size() >= 1) && (tuple[0][0] == '\t') ) {
          if(statusFlags == ~0U) {
             throw ResultsReaderDataErrorException("Hop data has no corresponding #T line");
          }
-
-         const ReaderTimePoint          sendTimeStamp   = parseTimeStamp(tuple[0], now, true, dataFile);
+         // NOTE: The first column begins with the TAB, which has to be skipped!
+         const ReaderTimePoint          sendTimeStamp   = parseTimeStamp(tuple[0].substr(1), now, true, dataFile);
          const unsigned int             hopNumber       = parseHopNumber(tuple[1], dataFile);
          const unsigned int             responseSize    = parseResponseSize(tuple[2], dataFile);
          const unsigned int             status          = parseStatus(tuple[3], dataFile, 10);
@@ -727,7 +726,57 @@ void TracerouteReader::parseContents(
          const long long                rttHardware     = parseNanoseconds(tuple[10], dataFile);
          const boost::asio::ip::address hopIP           = parseAddress(tuple[11], dataFile);
 
-         if(backend & DatabaseBackendType::SQL_Generic) {
+         if( (bulkRows) && (backend & DatabaseBackendType::NoSQL_Generic) ) {
+            assert(hopRows != nullptr);
+            hopRows->beginRow();
+            *hopRows
+               << timePointToNanoseconds<ReaderTimePoint>(sendTimeStamp)
+               << responseSize
+               << hopIP
+               << status
+
+               << timeSource
+               << delayAppSend
+               << delayQueuing
+               << delayAppReceive
+               << rttApp
+               << rttSoftware
+               << rttHardware;
+            hopRows->endRow();
+         }
+         else if(bulkRows) {
+            bulkRows->beginRow();
+            *bulkRows
+               << timePointToNanoseconds<ReaderTimePoint>(timeStamp)
+               << measurementID
+               << sourceIP
+               << destinationIP
+               << (unsigned int)protocol
+               << (unsigned int)trafficClass
+               << roundNumber
+               << hopNumber
+               << totalHops
+               << packetSize
+               << responseSize
+               << checksum
+               << sourcePort
+               << destinationPort
+               << (status | statusFlags)
+               << pathHash
+               << timePointToNanoseconds<ReaderTimePoint>(sendTimeStamp)
+               << hopIP
+
+               << timeSource
+               << delayAppSend
+               << delayQueuing
+               << delayAppReceive
+               << rttApp
+               << rttSoftware
+               << rttHardware;
+            bulkRows->endRow();
+            rows++;
+         }
+         else if(backend & DatabaseBackendType::SQL_Generic) {
             statement.beginRow();
             statement
                << timePointToNanoseconds<ReaderTimePoint>(timeStamp)     << statement.sep()
@@ -761,7 +810,7 @@ void TracerouteReader::parseContents(
          }
          else if(backend & DatabaseBackendType::NoSQL_Generic) {
             statement
-               << ((hopNumber > 1) ? ", { " :" { ")
+               << ((!firstHop) ? ", { " :" { ")
 
                << "\"sendTimestamp\":" << timePointToNanoseconds<ReaderTimePoint>(sendTimeStamp) << statement.sep()
                << "\"responseSize\":"  << responseSize                                           << statement.sep()
@@ -777,6 +826,7 @@ void TracerouteReader::parseContents(
                << "\"rtt.hw\":"        << rttHardware
 
                << " }";
+            firstHop = false;
          }
          else {
             throw ResultsLogicException("Unknown output format");
@@ -788,8 +838,13 @@ void TracerouteReader::parseContents(
       }
    }
    if( (statusFlags != ~0U) && (backend & DatabaseBackendType::NoSQL_Generic) ) {
-      statement << "]";
-      statement.endRow();
+      if(bulkRows) {
+         bulkRows->endRow();
+      }
+      else {
+         statement << "]";
+         statement.endRow();
+      }
       rows++;
    }
 }
@@ -40,12 +40,13 @@ struct TracerouteFileEntry {
    ReaderTimePoint       TimeStamp;
    unsigned int          SeqNumber;
    std::filesystem::path DataFile;
+   uint32_t              SourceHash;
 };
 bool operator<(const TracerouteFileEntry& a, const TracerouteFileEntry& b);
 std::ostream& operator<<(std::ostream& os, const TracerouteFileEntry& entry);
 
 int makeInputFileEntry(const std::filesystem::path& dataFile,
-                       const std::smatch            match,
+                       const ResultsFileName&       resultsFileName,
                        TracerouteFileEntry&         inputFileEntry,
                        const unsigned int           workers);
 ReaderPriority getPriorityOfFileEntry(const TracerouteFileEntry& inputFileEntry);
@@ -62,7 +63,10 @@ class TracerouteReader : public ReaderImplementation<TracerouteFileEntry>
    virtual ~TracerouteReader();
 
    virtual const std::string& getIdentification() const { return Identification; }
-   virtual const std::regex&  getFileNameRegExp() const { return FileNameRegExp; }
+   virtual bool parseFileName(const std::string_view filename,
+                              ResultsFileName&       resultsFileName) const {
+      return parseResultsFileName(getIdentification(), filename, resultsFileName);
+   }
 
    virtual void beginParsing(DatabaseClientBase& databaseClient,
                              unsigned long long& rows);
@@ -74,49 +78,57 @@ class TracerouteReader : public ReaderImplementation<TracerouteFileEntry>
                               boost::iostreams::filtering_istream& dataStream);
 
    protected:
-   unsigned long long parseMeasurementID(const std::string&           value,
+   unsigned long long parseMeasurementID(const std::string_view       value,
                                          const std::filesystem::path& dataFile);
-   boost::asio::ip::address parseAddress(const std::string&           value,
+   boost::asio::ip::address parseAddress(const std::string_view       value,
                                          const std::filesystem::path& dataFile);
-   ReaderTimePoint parseTimeStamp(const std::string&           value,
+   ReaderTimePoint parseTimeStamp(const std::string_view       value,
                                   const ReaderTimePoint&       now,
                                   const bool                   inNanoseconds,
                                   const std::filesystem::path& dataFile);
-   unsigned int parseRoundNumber(const std::string&           value,
+   unsigned int parseRoundNumber(const std::string_view       value,
                                  const std::filesystem::path& dataFile);
-   uint8_t parseTrafficClass(const std::string&           value,
+   uint8_t parseTrafficClass(const std::string_view       value,
                              const std::filesystem::path& dataFile);
-   unsigned int parsePacketSize(const std::string&           value,
+   unsigned int parsePacketSize(const std::string_view       value,
                                 const std::filesystem::path& dataFile);
-   unsigned int parseResponseSize(const std::string&           value,
+   unsigned int parseResponseSize(const std::string_view       value,
                                  const std::filesystem::path& dataFile);
-   uint16_t parseChecksum(const std::string&           value,
+   uint16_t parseChecksum(const std::string_view       value,
                           const std::filesystem::path& dataFile);
-   uint16_t parsePort(const std::string&           value,
+   uint16_t parsePort(const std::string_view       value,
                       const std::filesystem::path& dataFile);
-   unsigned int parseStatus(const std::string&           value,
+   unsigned int parseStatus(const std::string_view       value,
                             const std::filesystem::path& dataFile,
                             const unsigned int           base = 16);
-   unsigned int parseTimeSource(const std::string&           value,
+   unsigned int parseTimeSource(const std::string_view       value,
                                 const std::filesystem::path& dataFile);
-   unsigned int parseTotalHops(const std::string&           value,
+   unsigned int parseTotalHops(const std::string_view       value,
                                const std::filesystem::path& dataFile);
-   unsigned int parseHopNumber(const std::string&           value,
+   unsigned int parseHopNumber(const std::string_view       value,
                                const std::filesystem::path& dataFile);
-   unsigned int parseHop(const std::string&           value,
-                         const std::filesystem::path& dataFile);
-   long long parsePathHash(const std::string&           value,
+   long long parsePathHash(const std::string_view       value,
                            const std::filesystem::path& dataFile);
-   long long parseNanoseconds(const std::string&           value,
+   long long parseNanoseconds(const std::string_view       value,
                               const std::filesystem::path& dataFile);
+   unsigned int parseCount(const std::string_view       value,
+                           const std::filesystem::path& dataFile);
+   [[noreturn]] void throwBadValue(const char*                  message,
+                                   const std::string_view       value,
+                                   const std::filesystem::path& dataFile,
+                                   const std::errc              ec         = std::errc(),
+                                   const char*                  conversion = nullptr) const;
 
    protected:
    const std::string        Table;
 
    public:
-   static const std::string  Identification;
-   static const std::regex   FileNameRegExp;
-   static const unsigned int FileNameRegExpMatchSize;
+   static const std::string Identification;
+
+   private:
+   static const std::vector<BulkColumn> BulkColumns;
+   static const std::vector<BulkColumn> DocumentColumns;
+   static const std::vector<BulkColumn> HopColumns;
 };
 
 #endif
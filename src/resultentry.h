@@ -75,7 +75,8 @@ enum HopStatus {
 
    // ------ Response received ----------------------------
    Flag_StarredRoute       = (1 << 8),  // Route with * (router did not respond)
-   Flag_DestinationReached = (1 << 9)   // Destination has responded
+   Flag_DestinationReached = (1 << 9),  // Destination has responded
+   Flag_PartialRoute       = (1 << 10)  // Round has only probed some hops (MDA)
 };
 
 
@@ -81,4 +81,20 @@ class ResultsDatabaseDataErrorException : public ResultsDatabaseException
    ResultsDatabaseDataErrorException(const std::string& error) : ResultsDatabaseException(error) { }
 };
 
+
+// Duplicate key => data is already in the database
+class ResultsDatabaseDuplicateKeyException : public ResultsDatabaseDataErrorException
+{
+   public:
+   ResultsDatabaseDuplicateKeyException(const std::string& error) : ResultsDatabaseDataErrorException(error) { }
+};
+
+
+// Temporary problem (deadlock, serialisation failure, etc.) => retry
+class ResultsDatabaseTransientErrorException : public ResultsDatabaseException
+{
+   public:
+   ResultsDatabaseTransientErrorException(const std::string& error) : ResultsDatabaseException(error) { }
+};
+
 #endif
@@ -0,0 +1,244 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+
+#include "resultsarchive.h"
+#include "compressortype.h"
+#include "resultsindex.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+
+
+// ###### Encode 32-bit little-endian value #################################
+static void putLE32(unsigned char* buffer, const uint32_t value)
+{
+   buffer[0] = value & 0xff;
+   buffer[1] = (value >> 8) & 0xff;
+   buffer[2] = (value >> 16) & 0xff;
+   buffer[3] = (value >> 24) & 0xff;
+}
+
+
+// ###### Decode 32-bit little-endian value #################################
+static uint32_t getLE32(const unsigned char* buffer)
+{
+   return (uint32_t)buffer[0]         | ((uint32_t)buffer[1] << 8) |
+          ((uint32_t)buffer[2] << 16) | ((uint32_t)buffer[3] << 24);
+}
+
+
+// ###### Write complete buffer #############################################
+static void writeAll(const int handle, const char* data, size_t length)
+{
+   while(length > 0) {
+      const ssize_t written = ::write(handle, data, length);
+      if(written < 0) {
+         if(errno == EINTR) {
+            continue;
+         }
+         throw std::runtime_error(strerror(errno));
+      }
+      data   += written;
+      length -= written;
+   }
+}
+
+
+// ###### Append results file to archive ####################################
+// The archive is locked during the update. On failure, it is truncated to
+// its previous size, i.e. it never contains a partial member.
+void ResultsArchive::appendFile(const std::filesystem::path& archiveFileName,
+                                const std::filesystem::path& fileName)
+{
+   // ====== Check compressor ===============================================
+   const CompressorType compressor = obtainCompressorFromExtension(fileName);
+   if(obtainCompressorFromExtension(archiveFileName) != compressor) {
+      throw std::runtime_error("Compression of " + fileName.filename().string() +
+                               " does not match archive " + archiveFileName.string());
+   }
+
+   // ====== Open results file and archive ==================================
+   const int input = ::open(fileName.c_str(), O_RDONLY);
+   if(input < 0) {
+      throw std::runtime_error("Unable to open " + fileName.string() + ": " + strerror(errno));
+   }
+   const int handle = ::open(archiveFileName.c_str(), O_WRONLY|O_CREAT|O_APPEND, 0644);
+   if(handle < 0) {
+      const int error = errno;
+      ::close(input);
+      throw std::runtime_error("Unable to open archive " + archiveFileName.string() + ": " + strerror(error));
+   }
+   struct stat inputStatus;
+   struct stat archiveStatus;
+   if( (fstat(input, &inputStatus) != 0) ||
+       (flock(handle, LOCK_EX) != 0) ||
+       (fstat(handle, &archiveStatus) != 0) ) {
+      const int error = errno;
+      ::close(handle);
+      ::close(input);
+      throw std::runtime_error("Unable to lock archive " + archiveFileName.string() + ": " + strerror(error));
+   }
+   const unsigned long long size   = inputStatus.st_size;
+   const off_t              offset = archiveStatus.st_size;
+
+   try {
+      // ====== Write member header =========================================
+      if(compressor == CT_ZSTD) {
+         const std::string payload = str(boost::format("HPCT-Member 1 %llu %s\n")
+                                            % size % fileName.filename().string());
+         unsigned char header[8];
+         putLE32(&header[0], MemberFrameMagic);
+         putLE32(&header[4], payload.size());
+         writeAll(handle, (const char*)&header, sizeof(header));
+         writeAll(handle, payload.data(), payload.size());
+      }
+
+      // ====== Copy results file ===========================================
+      std::vector<char>  buffer(1048576);
+      unsigned long long copied = 0;
+      for(;;) {
+         const ssize_t bytesRead = ::read(input, buffer.data(), buffer.size());
+         if(bytesRead == 0) {
+            break;
+         }
+         else if(bytesRead < 0) {
+            if(errno == EINTR) {
+               continue;
+            }
+            throw std::runtime_error(strerror(errno));
+         }
+         writeAll(handle, buffer.data(), bytesRead);
+         copied += bytesRead;
+      }
+      if(copied != size) {
+         throw std::runtime_error("File has changed while archiving");
+      }
+      if(fdatasync(handle) != 0) {
+         throw std::runtime_error(strerror(errno));
+      }
+   }
+   catch(std::exception& e) {
+      if(ftruncate(handle, offset) != 0) { }
+      ::close(handle);
+      ::close(input);
+      throw std::runtime_error("Appending " + fileName.filename().string() +
+                               " to archive " + archiveFileName.string() +
+                               " failed: " + e.what());
+   }
+
+   // ====== Update the archive index =======================================
+   // Without the index of every member, the archive index would be
+   // incomplete. Then, it is removed.
+   const std::filesystem::path archiveIndexFileName = ResultsIndex::getIndexFileName(archiveFileName);
+   ResultsIndex                memberIndex;
+   ResultsIndex                archiveIndex;
+   std::error_code             ec;
+   if( (memberIndex.readIndex(ResultsIndex::getIndexFileName(fileName))) &&
+       ((offset == 0) || (archiveIndex.readIndex(archiveIndexFileName))) ) {
+      archiveIndex.merge(memberIndex);
+      try {
+         archiveIndex.writeIndex(archiveIndexFileName);
+      }
+      catch(std::exception& e) {
+         std::filesystem::remove(archiveIndexFileName, ec);
+      }
+   }
+   else {
+      std::filesystem::remove(archiveIndexFileName, ec);
+   }
+
+   ::close(handle);
+   ::close(input);
+}
+
+
+// ###### Read the list of archive members ##################################
+// Returns false, if the file is not an archive with member frames.
+bool ResultsArchive::readMembers(const std::filesystem::path&       archiveFileName,
+                                 std::vector<ResultsArchiveMember>& members)
+{
+   members.clear();
+   if(obtainCompressorFromExtension(archiveFileName) != CT_ZSTD) {
+      return false;
+   }
+
+   std::error_code          ec;
+   const unsigned long long fileSize = std::filesystem::file_size(archiveFileName, ec);
+   std::ifstream            is(archiveFileName, std::ios::binary);
+   if( (ec) || (!is.good()) ) {
+      return false;
+   }
+
+   unsigned long long position = 0;
+   while(position < fileSize) {
+      // ====== Read member frame ===========================================
+      unsigned char header[8];
+      is.seekg(position);
+      if(!is.read((char*)&header, sizeof(header))) {
+         return false;
+      }
+      const uint32_t length = getLE32(&header[4]);
+      if( (getLE32(&header[0]) != MemberFrameMagic) || (length > MaxMemberHeader) ) {
+         return false;
+      }
+      std::string payload(length, 0x00);
+      if(!is.read(payload.data(), length)) {
+         return false;
+      }
+
+      // ====== Parse member description ====================================
+      std::istringstream   ps(payload);
+      std::string          tag;
+      unsigned int         version;
+      ResultsArchiveMember member;
+      ps >> tag >> version >> member.Size;
+      ps.get();
+      std::getline(ps, member.Name);
+      if( (ps.fail()) || (tag != "HPCT-Member") || (version != 1) ) {
+         return false;
+      }
+      member.Offset = position + sizeof(header) + length;
+      if(member.Offset + member.Size > fileSize) {
+         return false;
+      }
+      members.push_back(member);
+      position = member.Offset + member.Size;
+   }
+   return true;
+}
@@ -0,0 +1,72 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#ifndef RESULTSARCHIVE_H
+#define RESULTSARCHIVE_H
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+// ==========================================================================
+// Archive of imported results files.
+//
+// Instead of keeping millions of small results files, the importer may
+// append the files of a source and time bucket to one archive. Compressed
+// streams can be concatenated, i.e. an archive is a valid compressed file,
+// and it is readable like any other results file.
+// For ZSTD, each member is preceded by a skippable frame with its name and
+// size. Decoders ignore these frames, but they allow to list and extract
+// the members. XZ, BZip2 and GZip have no such frames; their archives are
+// plain concatenations of the members.
+// If all members have an index file, the archive has the merged index.
+// ==========================================================================
+
+struct ResultsArchiveMember
+{
+   std::string        Name;
+   unsigned long long Offset;
+   unsigned long long Size;
+};
+
+class ResultsArchive
+{
+   public:
+   static void appendFile(const std::filesystem::path& archiveFileName,
+                          const std::filesystem::path& fileName);
+   static bool readMembers(const std::filesystem::path&       archiveFileName,
+                           std::vector<ResultsArchiveMember>& members);
+
+   // ZSTD skippable frame, with magic number 0x184D2A50 + 0xE:
+   static const unsigned int MemberFrameMagic = 0x184D2A5E;
+   static const unsigned int MaxMemberHeader  = 4096;
+};
+
+#endif
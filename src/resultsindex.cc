@@ -0,0 +1,333 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+
+#include "resultsindex.h"
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/format.hpp>
+#include <zlib.h>
+
+
+// ###### Constructor #######################################################
+ResultsIndex::ResultsIndex()
+{
+   clear();
+}
+
+
+// ###### Destructor ########################################################
+ResultsIndex::~ResultsIndex()
+{
+}
+
+
+// ###### Reset index #######################################################
+void ResultsIndex::clear()
+{
+   Lines          = 0;
+   Bytes          = 0;
+   Records        = 0;
+   FirstTimeStamp = 0;
+   LastTimeStamp  = 0;
+   Checksum       = 0;
+   RecordsByType.clear();
+   BloomFilter.assign(BloomFilterBits / 8, 0);
+}
+
+
+// ###### Add line of the results file ######################################
+void ResultsIndex::add(const std::string& line)
+{
+   // ====== Update counters and checksum ===================================
+   Lines++;
+   Bytes += line.size() + 1;
+   Checksum = crc32(Checksum, (const Bytef*)line.data(), line.size());
+   Checksum = crc32(Checksum, (const Bytef*)"\n", 1);
+
+   // ====== Only records are indexed =======================================
+   // Jitter output may indent its Ping records; traceroute hop lines start
+   // with a TAB, followed by a hexadecimal number.
+   const char* linestr = line.c_str();
+   while( (*linestr == '\t') || (*linestr == ' ') ) {
+      linestr++;
+   }
+   if( (linestr[0] != '#') || (linestr[1] == '?') || (linestr[1] == 0x00) ) {
+      return;
+   }
+
+   // ====== Obtain pointers to the first 5 columns =========================
+   const unsigned int maxColumns = 5;
+   const char*        value[maxColumns];
+   size_t             length[maxColumns];
+   unsigned int       c = 0;
+   value[0] = linestr;
+   while(c < maxColumns) {
+      const char* end = value[c];
+      while( (*end != ' ') && (*end != 0x00) ) {
+         end++;
+      }
+      length[c] = end - value[c];
+      c++;
+      if(*end == 0x00) {
+         break;
+      }
+      if(c < maxColumns) {
+         value[c] = end + 1;
+      }
+   }
+
+   Records++;
+   RecordsByType[std::string(value[0], length[0])]++;
+
+   // ====== Version 1: "#P Source Destination TimeStamp(µs) ..." ===========
+   // ====== Version 2: "#P<p> ID Source Destination TimeStamp(ns) ..." =====
+   const bool         version2         = (length[0] > 2);
+   const unsigned int destinationIndex = (version2) ? 3 : 2;
+   const unsigned int timeStampIndex   = (version2) ? 4 : 3;
+   if(c > destinationIndex) {
+      unsigned int hash[BloomFilterHashes];
+      hashDestination(value[destinationIndex], length[destinationIndex], hash);
+      for(unsigned int i = 0; i < BloomFilterHashes; i++) {
+         BloomFilter[hash[i] / 8] |= (1 << (hash[i] % 8));
+      }
+   }
+   if(c > timeStampIndex) {
+      char*                    end;
+      const unsigned long long timeStamp =
+         strtoull(value[timeStampIndex], &end, 16) * ((version2) ? 1 : 1000);
+      if(end == value[timeStampIndex] + length[timeStampIndex]) {
+         if( (FirstTimeStamp == 0) || (timeStamp < FirstTimeStamp) ) {
+            FirstTimeStamp = timeStamp;
+         }
+         if(timeStamp > LastTimeStamp) {
+            LastTimeStamp = timeStamp;
+         }
+      }
+   }
+}
+
+
+// ###### Merge index of a following results file ###########################
+// The result is the index of the concatenation of both files, as written
+// into a results archive.
+void ResultsIndex::merge(const ResultsIndex& index)
+{
+   Lines    += index.Lines;
+   Bytes    += index.Bytes;
+   Records  += index.Records;
+   Checksum  = crc32_combine(Checksum, index.Checksum, index.Bytes);
+   for(const auto& recordsOfType : index.RecordsByType) {
+      RecordsByType[recordsOfType.first] += recordsOfType.second;
+   }
+   if( (index.FirstTimeStamp != 0) &&
+       ((FirstTimeStamp == 0) || (index.FirstTimeStamp < FirstTimeStamp)) ) {
+      FirstTimeStamp = index.FirstTimeStamp;
+   }
+   if(index.LastTimeStamp > LastTimeStamp) {
+      LastTimeStamp = index.LastTimeStamp;
+   }
+   for(size_t i = 0; i < BloomFilter.size(); i++) {
+      BloomFilter[i] |= index.BloomFilter[i];
+   }
+}
+
+
+// ###### Compute Bloom filter positions of a destination ###################
+// FNV-1a is used, since the positions must not depend on the platform of
+// the writer. The further positions are derived by double hashing.
+void ResultsIndex::hashDestination(const char*  destination,
+                                   const size_t length,
+                                   unsigned int hash[BloomFilterHashes]) const
+{
+   uint64_t fnv = 0xcbf29ce484222325ULL;
+   for(size_t i = 0; i < length; i++) {
+      fnv ^= (unsigned char)destination[i];
+      fnv *= 0x100000001b3ULL;
+   }
+   const uint32_t h1 = (uint32_t)fnv;
+   const uint32_t h2 = (uint32_t)(fnv >> 32) | 1;
+   for(unsigned int i = 0; i < BloomFilterHashes; i++) {
+      hash[i] = (h1 + i * h2) % BloomFilterBits;
+   }
+}
+
+
+// ###### Check whether the time stamp range overlaps [from, to) ############
+// A time stamp of 0 means an open end of the range.
+bool ResultsIndex::overlaps(const unsigned long long fromTimeStamp,
+                            const unsigned long long toTimeStamp) const
+{
+   if(Records == 0) {
+      return false;
+   }
+   if( (fromTimeStamp != 0) && (LastTimeStamp < fromTimeStamp) ) {
+      return false;
+   }
+   if( (toTimeStamp != 0) && (FirstTimeStamp >= toTimeStamp) ) {
+      return false;
+   }
+   return true;
+}
+
+
+// ###### Check whether the file may contain a destination ##################
+// False positives are possible, false negatives are not.
+bool ResultsIndex::mayContainDestination(const std::string& destination) const
+{
+   unsigned int hash[BloomFilterHashes];
+   hashDestination(destination.data(), destination.size(), hash);
+   for(unsigned int i = 0; i < BloomFilterHashes; i++) {
+      if(!(BloomFilter[hash[i] / 8] & (1 << (hash[i] % 8)))) {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+// ###### Write index file ##################################################
+// The index is written to a temporary file first, so that a reader never
+// sees an incomplete index.
+void ResultsIndex::writeIndex(const std::filesystem::path& indexFileName) const
+{
+   const std::filesystem::path tempFileName = indexFileName.string() + ".tmp";
+   std::ofstream os(tempFileName, std::ios::binary | std::ios::trunc);
+   if(!os.good()) {
+      throw std::runtime_error("Unable to write results index " + indexFileName.string());
+   }
+
+   os << "#? HPCT Index 1\n"
+      << "Lines "          << Lines   << "\n"
+      << "Bytes "          << Bytes   << "\n"
+      << "Records "        << Records << "\n";
+   for(const auto& recordsOfType : RecordsByType) {
+      os << "Type " << recordsOfType.first << " " << recordsOfType.second << "\n";
+   }
+   os << "FirstTimeStamp " << str(boost::format("%x") % FirstTimeStamp) << "\n"
+      << "LastTimeStamp "  << str(boost::format("%x") % LastTimeStamp)  << "\n"
+      << "CRC32 "          << str(boost::format("%08x") % Checksum)     << "\n"
+      << "Destinations "   << BloomFilterBits << " " << BloomFilterHashes << " ";
+   for(const unsigned char byte : BloomFilter) {
+      os << str(boost::format("%02x") % (unsigned int)byte);
+   }
+   os << "\n";
+   os.close();
+   if(!os.good()) {
+      std::filesystem::remove(tempFileName);
+      throw std::runtime_error("Unable to write results index " + indexFileName.string());
+   }
+   std::filesystem::rename(tempFileName, indexFileName);
+}
+
+
+// ###### Read index file ###################################################
+// Returns false, if there is no usable index. The caller then has to read
+// the results file itself.
+bool ResultsIndex::readIndex(const std::filesystem::path& indexFileName)
+{
+   clear();
+
+   std::ifstream is(indexFileName, std::ios::binary);
+   std::string   line;
+   if( (!is.good()) || (!std::getline(is, line)) || (line != "#? HPCT Index 1") ) {
+      return false;
+   }
+
+   bool haveDestinations = false;
+   while(std::getline(is, line)) {
+      std::istringstream ls(line);
+      std::string        key;
+      ls >> key;
+      if(key == "Lines") {
+         ls >> Lines;
+      }
+      else if(key == "Bytes") {
+         ls >> Bytes;
+      }
+      else if(key == "Records") {
+         ls >> Records;
+      }
+      else if(key == "Type") {
+         std::string        type;
+         unsigned long long records;
+         ls >> type >> records;
+         RecordsByType[type] = records;
+      }
+      else if(key == "FirstTimeStamp") {
+         ls >> std::hex >> FirstTimeStamp;
+      }
+      else if(key == "LastTimeStamp") {
+         ls >> std::hex >> LastTimeStamp;
+      }
+      else if(key == "CRC32") {
+         ls >> std::hex >> Checksum;
+      }
+      else if(key == "Destinations") {
+         unsigned int bits;
+         unsigned int hashes;
+         std::string  filter;
+         ls >> bits >> hashes >> filter;
+         if( (bits != BloomFilterBits) || (hashes != BloomFilterHashes) ||
+             (filter.size() != 2 * BloomFilter.size()) ) {
+            return false;
+         }
+         for(size_t i = 0; i < BloomFilter.size(); i++) {
+            char*             end;
+            const std::string byte = filter.substr(2 * i, 2);
+            BloomFilter[i] = (unsigned char)strtoul(byte.c_str(), &end, 16);
+            if(end != byte.c_str() + 2) {
+               return false;
+            }
+         }
+         haveDestinations = true;
+      }
+      // Unknown keys are ignored, for compatibility with later versions.
+      if(ls.fail()) {
+         return false;
+      }
+   }
+   return haveDestinations;
+}
+
+
+// ###### Get name of the index file for a results file #####################
+std::filesystem::path ResultsIndex::getIndexFileName(const std::filesystem::path& resultsFileName)
+{
+   return resultsFileName.string() + ".idx";
+}
+
+
+// ###### Check whether a file name is an index file name ###################
+bool ResultsIndex::isIndexFileName(const std::filesystem::path& fileName)
+{
+   return (fileName.extension() == ".idx");
+}
@@ -0,0 +1,112 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+
+#ifndef RESULTSINDEX_H
+#define RESULTSINDEX_H
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+
+// ==========================================================================
+// Sidecar index of a results file.
+//
+// When a results file is rotated, the writer stores a small text file
+// <results file>.idx next to it, containing the first/last time stamp,
+// the record counts by record type, a Bloom filter of the destinations
+// and a CRC-32 of the uncompressed content. Tools can use it to skip files
+// without decompressing them, and to estimate the work of an import run.
+// ==========================================================================
+
+class ResultsIndex
+{
+   public:
+   ResultsIndex();
+   ~ResultsIndex();
+
+   void clear();
+   void add(const std::string& line);
+   void merge(const ResultsIndex& index);
+
+   inline bool empty() const {
+      return (Lines == 0);
+   }
+   inline unsigned long long lines() const {
+      return Lines;
+   }
+   inline unsigned long long bytes() const {
+      return Bytes;
+   }
+   inline unsigned long long records() const {
+      return Records;
+   }
+   inline const std::map<std::string, unsigned long long>& recordsByType() const {
+      return RecordsByType;
+   }
+   inline unsigned long long firstTimeStamp() const {
+      return FirstTimeStamp;
+   }
+   inline unsigned long long lastTimeStamp() const {
+      return LastTimeStamp;
+   }
+   inline unsigned int checksum() const {
+      return Checksum;
+   }
+
+   bool overlaps(const unsigned long long fromTimeStamp,
+                 const unsigned long long toTimeStamp) const;
+   bool mayContainDestination(const std::string& destination) const;
+
+   void writeIndex(const std::filesystem::path& indexFileName) const;
+   bool readIndex(const std::filesystem::path& indexFileName);
+
+   static std::filesystem::path getIndexFileName(const std::filesystem::path& resultsFileName);
+   static bool isIndexFileName(const std::filesystem::path& fileName);
+
+   static const unsigned int BloomFilterBits   = 8192;
+   static const unsigned int BloomFilterHashes = 4;
+
+   private:
+   void hashDestination(const char* destination, const size_t length,
+                        unsigned int hash[BloomFilterHashes]) const;
+
+   unsigned long long                        Lines;
+   unsigned long long                        Bytes;
+   unsigned long long                        Records;
+   std::map<std::string, unsigned long long> RecordsByType;
+   unsigned long long                        FirstTimeStamp;
+   unsigned long long                        LastTimeStamp;
+   unsigned int                              Checksum;
+   std::vector<unsigned char>                BloomFilter;
+};
+
+#endif
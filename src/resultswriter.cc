@@ -29,6 +29,7 @@
 
 #include "resultswriter.h"
 #include "assure.h"
+#include "compressionpool.h"
 #include "compressortype.h"
 #include "logger.h"
 #include "tools.h"
@@ -44,16 +45,20 @@
 
 
 // ###### Constructor #######################################################
-ResultsWriter::ResultsWriter(const std::string&   programID,
-                             const unsigned int   measurementID,
-                             const std::string&   directory,
-                             const std::string&   uniqueID,
-                             const std::string&   prefix,
-                             const unsigned int   transactionLength,
-                             const unsigned int   timestampDepth,
-                             const uid_t          uid,
-                             const gid_t          gid,
-                             const CompressorType compressor)
+ResultsWriter::ResultsWriter(const std::string&    programID,
+                             const unsigned int    measurementID,
+                             const std::string&    directory,
+                             const std::string&    uniqueID,
+                             const std::string&    prefix,
+                             const unsigned int    transactionLength,
+                             const unsigned int    timestampDepth,
+                             const uid_t           uid,
+                             const gid_t           gid,
+                             const CompressorType  compressor,
+                             const ZSTDDictionary* dictionary,
+                             const int             compressionLevel,
+                             const double          compressionCPUBudget,
+                             const bool            writeIndex)
    : ProgramID(programID),
      MeasurementID(measurementID),
      Directory(directory),
@@ -63,10 +68,18 @@ ResultsWriter::ResultsWriter(const std::string&   programID,
      UID(uid),
      GID(gid),
      Compressor(compressor),
+     Dictionary(dictionary),
+     CompressionCPUBudget(compressionCPUBudget),
+     WriteIndex(writeIndex),
      UniqueID(uniqueID)
 {
-   Inserts   = 0;
-   SeqNumber = 0;
+   CompressionLevel = getCompressionLevel(Compressor, compressionLevel);
+   Shared           = false;
+   SharedIPv6       = false;
+   Prepared         = false;
+   Services         = 1;
+   Inserts          = 0;
+   SeqNumber        = 0;
 }
 
 
@@ -89,6 +102,14 @@ void ResultsWriter::specifyOutputFormat(const std::string& outputFormatName,
 // ###### Prepare directories ###############################################
 bool ResultsWriter::prepare()
 {
+   std::lock_guard<std::recursive_mutex> lock(OutputMutex);
+
+   // ====== A shared writer is prepared by its first service only ==========
+   if(Prepared) {
+      return true;
+   }
+   Prepared = true;
+
    try {
       std::filesystem::create_directory(Directory);
    }
@@ -103,13 +124,39 @@ bool ResultsWriter::prepare()
 // ###### Change output file ################################################
 bool ResultsWriter::changeFile(const bool createNewFile)
 {
+   std::lock_guard<std::recursive_mutex> lock(OutputMutex);
+
+   // ====== Write index of current file ===================================
+   // The index is written before the results file gets its final name.
+   // Then, a reader finding the results file also finds its index.
+   std::filesystem::path indexFileName;
+   if( (WriteIndex) && (Inserts > 0) ) {
+      try {
+         indexFileName = ResultsIndex::getIndexFileName(TargetFileName);
+         Index.writeIndex(indexFileName);
+      }
+      catch(std::exception const& e) {
+         HPCT_LOG(warning) << "Failed to write index of output file "
+                           << TargetFileName << ": " << e.what();
+         indexFileName.clear();
+      }
+   }
+   Index.clear();
+
    // ====== Close current file =============================================
    try {
       Output.closeStream( (Inserts > 0) );
+      if( (createNewFile) && (Inserts > 0) ) {
+         adaptCompressionLevel();
+      }
    }
    catch(std::exception const& e) {
       HPCT_LOG(error) << "Failed to close output file "
                       << TargetFileName << ": " << e.what();
+      if(!indexFileName.empty()) {
+         std::error_code ec;
+         std::filesystem::remove(indexFileName, ec);
+      }
    }
 
    // ====== Create new file ================================================
@@ -137,7 +184,7 @@ bool ResultsWriter::changeFile(const bool createNewFile)
 
          // ------ Open new output file -------------------------------------
          TargetFileName = targetPath / name;
-         Output.openStream(TargetFileName);
+         Output.openStream(TargetFileName, Compressor, Dictionary, CompressionLevel);
          OutputCreationTime = std::chrono::steady_clock::now();
          return Output.good();
       }
@@ -151,9 +198,49 @@ bool ResultsWriter::changeFile(const bool createNewFile)
 }
 
 
+// ###### Adapt compression level to the CPU budget #########################
+// The CPU budget is the fraction of one CPU core that compressing the
+// output of this writer may use. The compression CPU time of the closed file
+// is compared to the time the file has been open: above the budget, the
+// level is decreased; below half of the budget, it is increased.
+void ResultsWriter::adaptCompressionLevel()
+{
+   const CompressionStatistics* statistics = Output.compressionStatistics();
+   if( (CompressionCPUBudget <= 0.0) || (statistics == nullptr) ||
+       (statistics->Blocks == 0) ) {
+      return;
+   }
+   const double wallTime = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - OutputCreationTime).count();
+   if(wallTime <= 0.0) {
+      return;
+   }
+   const double cpuUsage = std::chrono::duration<double>(statistics->CPUTime).count() / wallTime;
+
+   const int oldLevel = CompressionLevel;
+   if(cpuUsage > CompressionCPUBudget) {
+      CompressionLevel = std::max(getMinCompressionLevel(Compressor), CompressionLevel - 1);
+   }
+   else if(cpuUsage < 0.5 * CompressionCPUBudget) {
+      CompressionLevel = std::min(getMaxCompressionLevel(Compressor), CompressionLevel + 1);
+   }
+
+   HPCT_LOG(debug) << "Compressed " << TargetFileName << " at level " << oldLevel << ": "
+                   << statistics->InputBytes << " -> " << statistics->OutputBytes << " B, "
+                   << boost::format("%1.2f%%") % (100.0 * cpuUsage) << " CPU";
+   if(CompressionLevel != oldLevel) {
+      HPCT_LOG(info) << "Compression level of " << Prefix << " changed from "
+                     << oldLevel << " to " << CompressionLevel << ": "
+                     << boost::format("%1.2f%%") % (100.0 * cpuUsage) << " CPU, budget "
+                     << boost::format("%1.2f%%") % (100.0 * CompressionCPUBudget);
+   }
+}
+
+
 // ###### Start new transaction, if transaction length has been reached #####
 bool ResultsWriter::mayStartNewTransaction()
 {
+   std::lock_guard<std::recursive_mutex> lock(OutputMutex);
    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
    if(std::chrono::duration_cast<std::chrono::seconds>(now - OutputCreationTime).count() > TransactionLength) {
       return changeFile();
@@ -165,16 +252,24 @@ bool ResultsWriter::mayStartNewTransaction()
 // ###### Generate INSERT statement #########################################
 void ResultsWriter::insert(const std::string& tuple)
 {
+   std::lock_guard<std::recursive_mutex> lock(OutputMutex);
    if(__builtin_expect(Inserts == 0, 0)) {
       if(!OutputFormatName.empty()) {
          // Write header
-         Output << "#? HPCT "
-                       << OutputFormatName    << " "
-                       << OutputFormatVersion << " "
-                       << ProgramID           << "\n";
+         const std::string header = "#? HPCT " +
+                                       OutputFormatName                    + " " +
+                                       std::to_string(OutputFormatVersion) + " " +
+                                       ProgramID;
+         Output << header << "\n";
+         if(WriteIndex) {
+            Index.add(header);
+         }
       }
    }
    Output << tuple << "\n";
+   if(WriteIndex) {
+      Index.add(tuple);
+   }
    Inserts++;
 }
 
@@ -191,23 +286,73 @@ ResultsWriter* ResultsWriter::makeResultsWriter(
    const unsigned int              resultsTimestampDepth,
    const uid_t                     uid,
    const gid_t                     gid,
-   const CompressorType            compressor)
+   const CompressorType            compressor,
+   const unsigned int              servicesPerWriter,
+   const ZSTDDictionary*           dictionary,
+   const int                       compressionLevel,
+   const double                    compressionCPUBudget,
+   const bool                      writeIndex)
 {
    if(!resultsDirectory.empty()) {
+      // ====== Try to attach to an existing shared writer ==================
+      // servicesPerWriter: 1 = one writer per service (i.e. not shared),
+      //                    N = up to N services of the same type per writer,
+      //                    0 = all services of the same type in one writer.
+      const bool shared = (servicesPerWriter != 1);
+      if(shared) {
+         for(ResultsWriter* resultsWriter : resultsWriterSet) {
+            if( (resultsWriter->Shared) &&
+                (resultsWriter->SharedIPv6 == sourceAddress.is_v6()) &&
+                (resultsWriter->Prefix == resultsPrefix) &&
+                (resultsWriter->Directory == resultsDirectory) &&
+                ( (servicesPerWriter == 0) ||
+                  (resultsWriter->Services < servicesPerWriter) ) ) {
+               resultsWriter->Services++;
+               return resultsWriter;
+            }
+         }
+      }
+
+      // ====== Create new writer ===========================================
+      // A shared writer has no single source address. The records carry
+      // the source address, so the unspecified address of the address
+      // family is used in the file name, with the writer number as
+      // discriminator (e.g. "::%2"). Then, the files of different shared
+      // writers remain separate sources for the readers.
+      std::string source;
+      if(shared) {
+         unsigned int writerNumber = 1;
+         for(ResultsWriter* resultsWriter : resultsWriterSet) {
+            if( (resultsWriter->Shared) &&
+                (resultsWriter->SharedIPv6 == sourceAddress.is_v6()) &&
+                (resultsWriter->Prefix == resultsPrefix) &&
+                (resultsWriter->Directory == resultsDirectory) ) {
+               writerNumber++;
+            }
+         }
+         source = ((sourceAddress.is_v6()) ? std::string("::") : std::string("0.0.0.0")) +
+                     "%" + std::to_string(writerNumber);
+      }
+      else {
+         source = sourceAddress.to_string();
+      }
       std::string uniqueID =
          resultsPrefix + "-" +
          ((measurementID != 0) ?
             "#" + std::to_string(measurementID) :
             "P" + std::to_string(getpid())) + "-" +
-         sourceAddress.to_string() + "-" +
+         source + "-" +
          boost::posix_time::to_iso_string(boost::posix_time::microsec_clock::universal_time());
       replace(uniqueID.begin(), uniqueID.end(), ' ', '-');
 
       ResultsWriter* resultsWriter =
          new ResultsWriter(programID, measurementID, resultsDirectory, uniqueID,
                            resultsPrefix, resultsTransactionLength, resultsTimestampDepth,
-                           uid, gid, compressor);
+                           uid, gid, compressor, dictionary,
+                           compressionLevel, compressionCPUBudget, writeIndex);
       assure(resultsWriter != nullptr);
+      resultsWriter->Shared     = shared;
+      resultsWriter->SharedIPv6 = sourceAddress.is_v6();
       resultsWriterSet.insert(resultsWriter);
       return resultsWriter;
    }
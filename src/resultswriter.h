@@ -32,10 +32,13 @@
 
 #include "compressortype.h"
 #include "outputstream.h"
+#include "resultsindex.h"
+#include "zstddictionary.h"
 
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -46,16 +49,20 @@
 class ResultsWriter
 {
    public:
-   ResultsWriter(const std::string&   programID,
-                 const unsigned int   measurementID,
-                 const std::string&   directory,
-                 const std::string&   uniqueID,
-                 const std::string&   prefix,
-                 const unsigned int   transactionLength,
-                 const unsigned int   timestampDepth,
-                 const uid_t          uid,
-                 const gid_t          gid,
-                 const CompressorType compressor);
+   ResultsWriter(const std::string&    programID,
+                 const unsigned int    measurementID,
+                 const std::string&    directory,
+                 const std::string&    uniqueID,
+                 const std::string&    prefix,
+                 const unsigned int    transactionLength,
+                 const unsigned int    timestampDepth,
+                 const uid_t           uid,
+                 const gid_t           gid,
+                 const CompressorType  compressor,
+                 const ZSTDDictionary* dictionary           = nullptr,
+                 const int             compressionLevel     = 0,
+                 const double          compressionCPUBudget = 0.0,
+                 const bool            writeIndex           = false);
    virtual ~ResultsWriter();
 
    void specifyOutputFormat(const std::string& outputFormatName,
@@ -64,6 +71,18 @@ class ResultsWriter
    inline unsigned int measurementID() const {
       return MeasurementID;
    }
+   inline unsigned long long fileSeqNumber() const {
+      return SeqNumber;
+   }
+   inline int compressionLevel() const {
+      return CompressionLevel;
+   }
+   inline bool isShared() const {
+      return Shared;
+   }
+   inline std::recursive_mutex& outputMutex() {
+      return OutputMutex;
+   }
 
    bool prepare();
    bool changeFile(const bool createNewFile = true);
@@ -81,9 +100,16 @@ class ResultsWriter
       const unsigned int              resultsTimestampDepth,
       const uid_t                     uid,
       const gid_t                     gid,
-      const CompressorType            compressor = CT_XZ);
+      const CompressorType            compressor           = CT_XZ,
+      const unsigned int              servicesPerWriter    = 1,
+      const ZSTDDictionary*           dictionary           = nullptr,
+      const int                       compressionLevel     = 0,
+      const double                    compressionCPUBudget = 0.0,
+      const bool                      writeIndex           = false);
 
    protected:
+   void adaptCompressionLevel();
+
    const std::string                     ProgramID;
    const unsigned int                    MeasurementID;
    const std::filesystem::path           Directory;
@@ -93,13 +119,23 @@ class ResultsWriter
    const uid_t                           UID;
    const gid_t                           GID;
    const CompressorType                  Compressor;
+   const ZSTDDictionary*                 Dictionary;
+   const double                          CompressionCPUBudget;
+   const bool                            WriteIndex;
 
+   std::recursive_mutex                  OutputMutex;
+   int                                   CompressionLevel;
+   bool                                  Shared;
+   bool                                  SharedIPv6;
+   bool                                  Prepared;
+   unsigned int                          Services;
    std::string                           UniqueID;
    std::filesystem::path                 TempFileName;
    std::filesystem::path                 TargetFileName;
    size_t                                Inserts;
    unsigned long long                    SeqNumber;
    OutputStream                          Output;
+   ResultsIndex                          Index;
    std::chrono::steady_clock::time_point OutputCreationTime;
    std::string                           OutputFormatName;
    unsigned int                          OutputFormatVersion;
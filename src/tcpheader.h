@@ -0,0 +1,198 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#ifndef TCPHEADER_H
+#define TCPHEADER_H
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+
+#include "internet16.h"
+
+
+// ==========================================================================
+// From RFC 9293:
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |          Source Port          |       Destination Port        |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |                        Sequence Number                        |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |                    Acknowledgment Number                      |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |  Data |       |C|E|U|A|P|R|S|F|                               |
+//    | Offset| Rsrvd |W|C|R|C|S|S|Y|I|            Window             |
+//    |       |       |R|E|G|K|H|T|N|N|                               |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |           Checksum            |         Urgent Pointer        |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |                           [Options]                           |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//
+// ==========================================================================
+
+enum TCPFlags
+{
+   TCPFlag_FIN = 0x01,
+   TCPFlag_SYN = 0x02,
+   TCPFlag_RST = 0x04,
+   TCPFlag_PSH = 0x08,
+   TCPFlag_ACK = 0x10,
+   TCPFlag_URG = 0x20,
+   TCPFlag_ECE = 0x40,
+   TCPFlag_CWR = 0x80
+};
+
+
+class TCPHeader
+{
+   public:
+   TCPHeader() {
+      std::fill(Data, Data + sizeof(Data), 0);
+   }
+
+   inline uint16_t sourcePort()      const                     { return decode(0, 1);           }
+   inline uint16_t destinationPort() const                     { return decode(2, 3);           }
+   inline uint32_t seqNumber()       const                     { return decode32(4);            }
+   inline uint32_t ackNumber()       const                     { return decode32(8);            }
+   inline uint8_t  dataOffset()      const                     { return (Data[12] >> 4) << 2;   }
+   inline uint8_t  flags()           const                     { return Data[13];               }
+   inline uint16_t window()          const                     { return decode(14, 15);         }
+   inline uint16_t checksum()        const                     { return decode(16, 17);         }
+   inline uint16_t urgentPointer()   const                     { return decode(18, 19);         }
+
+   inline void sourcePort(const uint16_t sourcePort)           { encode(0, 1, sourcePort);      }
+   inline void destinationPort(const uint16_t destinationPort) { encode(2, 3, destinationPort); }
+   inline void seqNumber(const uint32_t seqNumber)             { encode32(4, seqNumber);        }
+   inline void ackNumber(const uint32_t ackNumber)             { encode32(8, ackNumber);        }
+   inline void dataOffset(const uint8_t dataOffset)            { Data[12] = (dataOffset >> 2) << 4; }
+   inline void flags(const uint8_t flags)                      { Data[13] = flags;              }
+   inline void window(const uint16_t window)                   { encode(14, 15, window);        }
+   inline void checksum(const uint16_t checksum)               { encode(16, 17, checksum);      }
+   inline void urgentPointer(const uint16_t urgentPointer)     { encode(18, 19, urgentPointer); }
+
+   inline void computeInternet16(uint32_t& sum) const {
+      ::computeInternet16(sum, (uint8_t*)&Data, sizeof(Data));
+   }
+
+   inline const uint8_t* data() const {
+      return (const uint8_t*)&Data;
+   }
+   inline size_t size() const {
+      return sizeof(Data);
+   }
+
+   friend std::istream& operator>>(std::istream& is, TCPHeader& header) {
+      is.read(reinterpret_cast<char*>(header.Data), 20);
+      if(header.dataOffset() < 20) {
+         is.setstate(std::ios::failbit);
+      }
+      else {
+         // Skip options:
+         is.ignore(header.dataOffset() - 20);
+      }
+      return is;
+   }
+
+   inline friend std::ostream& operator<<(std::ostream& os, const TCPHeader& header) {
+      return os.write(reinterpret_cast<const char*>(header.Data), sizeof(header.Data));
+   }
+
+   private:
+   inline uint16_t decode(const unsigned int a, const unsigned int b) const {
+      return ((uint16_t)Data[a] << 8) + Data[b];
+   }
+
+   inline void encode(const unsigned int a, const unsigned int b, const uint16_t n) {
+      Data[a] = static_cast<uint8_t>(n >> 8);
+      Data[b] = static_cast<uint8_t>(n & 0xff);
+   }
+
+   inline uint32_t decode32(const unsigned int a) const {
+      return ((uint32_t)Data[a] << 24) | ((uint32_t)Data[a + 1] << 16) |
+             ((uint32_t)Data[a + 2] << 8) | (uint32_t)Data[a + 3];
+   }
+
+   inline void encode32(const unsigned int a, const uint32_t n) {
+      Data[a]     = static_cast<uint8_t>(n >> 24);
+      Data[a + 1] = static_cast<uint8_t>((n >> 16) & 0xff);
+      Data[a + 2] = static_cast<uint8_t>((n >> 8) & 0xff);
+      Data[a + 3] = static_cast<uint8_t>(n & 0xff);
+   }
+
+   uint8_t Data[20];
+};
+
+
+
+// Read-only view on a TCP header within a receive buffer, without copying.
+// valid() is only true if the buffer holds the complete header, including
+// options. For a header quoted in an ICMP error, only the first 8 bytes
+// (ports and sequence number) are required, see RFC 792!
+class TCPHeaderView
+{
+   public:
+   TCPHeaderView(const uint8_t* data, const size_t length, const bool quoted = false)
+      : Data( ((quoted) ? (length >= 8) :
+                          ( (length >= 20) &&
+                            ((size_t)(data[12] >> 4) * 4 >= 20) &&
+                            ((size_t)(data[12] >> 4) * 4 <= length) )) ? data : nullptr),
+        Quoted(quoted) { }
+
+   inline bool     valid()           const { return Data != nullptr;                  }
+   inline size_t   size()            const { return (Quoted) ? 8 : dataOffset();      }
+
+   inline uint16_t sourcePort()      const { return decode(0, 1);                     }
+   inline uint16_t destinationPort() const { return decode(2, 3);                     }
+   inline uint32_t seqNumber()       const { return decode32(4);                      }
+
+   // NOTE: Only available for complete, i.e. not quoted, headers!
+   inline uint32_t ackNumber()       const { return decode32(8);                      }
+   inline uint8_t  dataOffset()      const { return (Data[12] >> 4) << 2;             }
+   inline uint8_t  flags()           const { return Data[13];                         }
+   inline uint16_t window()          const { return decode(14, 15);                   }
+
+   private:
+   inline uint16_t decode(const unsigned int a, const unsigned int b) const {
+      return ((uint16_t)Data[a] << 8) + Data[b];
+   }
+
+   inline uint32_t decode32(const unsigned int a) const {
+      return ((uint32_t)Data[a] << 24) | ((uint32_t)Data[a + 1] << 16) |
+             ((uint32_t)Data[a + 2] << 8) | (uint32_t)Data[a + 3];
+   }
+
+   const uint8_t* Data;
+   const bool     Quoted;
+};
+
+#endif
@@ -0,0 +1,181 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Check of the results file name parser: parseResultsFileName() has to
+// accept exactly the file names matched by the former std::regex of the
+// readers, with the same parts. The file names are generated randomly from
+// valid and invalid parts, with random modifications.
+
+#include "reader-base.h"
+
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+
+// ###### Regular expression of the former readers ##########################
+// The source may have the "%<N>" suffix of a shared writer.
+static std::regex makeFileNameRegExp(const std::string& service)
+{
+   return std::regex(
+      "^" + service + "-([A-Z]+-|)([#P])([0-9]+)-([0-9a-f:\\.]+(%[0-9]+)?)-([0-9]{8}T[0-9]+\\.[0-9]{6})-([0-9]*)\\.(hpct|results)(\\.xz|\\.bz2|\\.gz|\\.zst|)$"
+   );
+}
+
+
+// ###### Pick random valid or, rarely, invalid part ########################
+static const std::string& pick(std::mt19937&                   random,
+                               const std::vector<std::string>& valid,
+                               const std::vector<std::string>& invalid)
+{
+   if( (invalid.empty()) || (random() % 16 != 0) ) {
+      return valid[random() % valid.size()];
+   }
+   return invalid[random() % invalid.size()];
+}
+
+
+// ###### Generate random file name #########################################
+static std::string makeFileName(std::mt19937& random)
+{
+   static const std::vector<std::string> Services        = { "Ping", "Traceroute", "PingSummary", "Jitter" };
+   static const std::vector<std::string> BadServices     = { "ping", "Pin", "" };
+   static const std::vector<std::string> Protocols       = { "", "ICMP-", "UDP-", "TCP-", "P-" };
+   static const std::vector<std::string> BadProtocols    = { "icmp-", "ICMP", "-" };
+   static const std::vector<std::string> IDTypes         = { "#", "P" };
+   static const std::vector<std::string> BadIDTypes      = { "X", "" };
+   static const std::vector<std::string> IDs             = { "1000001", "12345", "0" };
+   static const std::vector<std::string> BadIDs          = { "", "12a" };
+   static const std::vector<std::string> Sources         = { "10.0.0.1", "0.0.0.0", "::", "2001:db8::1",
+                                                             "fe80::1", "::%2", "0.0.0.0%17" };
+   static const std::vector<std::string> BadSources      = { "::%", "%3", "1.2.3.4%x", "G::1", "" };
+   static const std::vector<std::string> Dates           = { "20241219" };
+   static const std::vector<std::string> BadDates        = { "2024121", "202412190" };
+   static const std::vector<std::string> Ts              = { "T" };
+   static const std::vector<std::string> BadTs           = { "t", "" };
+   static const std::vector<std::string> Seconds         = { "090830", "0" };
+   static const std::vector<std::string> BadSeconds      = { "", "12x" };
+   static const std::vector<std::string> Microseconds    = { "364329" };
+   static const std::vector<std::string> BadMicroseconds = { "36432", "3643290" };
+   static const std::vector<std::string> SeqNumbers      = { "000000001", "12", "" };
+   static const std::vector<std::string> BadSeqNumbers   = { "1a" };
+   static const std::vector<std::string> Extensions      = { "hpct", "results" };
+   static const std::vector<std::string> BadExtensions   = { "txt", "hpc" };
+   static const std::vector<std::string> Compressions    = { "", ".xz", ".bz2", ".gz", ".zst" };
+   static const std::vector<std::string> BadCompressions = { ".zip", ".xz.idx" };
+   static const std::string Characters = "-.#PT0123456789abcdef:%ABZxz";
+
+   std::string fileName =
+      pick(random, Services, BadServices) + "-" +
+      pick(random, Protocols, BadProtocols) +
+      pick(random, IDTypes, BadIDTypes) + pick(random, IDs, BadIDs) + "-" +
+      pick(random, Sources, BadSources) + "-" +
+      pick(random, Dates, BadDates) + pick(random, Ts, BadTs) +
+      pick(random, Seconds, BadSeconds) + "." +
+      pick(random, Microseconds, BadMicroseconds) + "-" +
+      pick(random, SeqNumbers, BadSeqNumbers) + "." +
+      pick(random, Extensions, BadExtensions) +
+      pick(random, Compressions, BadCompressions);
+
+   // ====== Random modifications ===========================================
+   const unsigned int modifications = (random() % 3 == 0) ? (1 + random() % 3) : 0;
+   for(unsigned int i = 0; i < modifications; i++) {
+      const size_t position = random() % (fileName.size() + 1);
+      const char   c        = Characters[random() % Characters.size()];
+      switch(random() % 3) {
+         case 0:
+            fileName.insert(position, 1, c);
+          break;
+         case 1:
+            if(position < fileName.size()) {
+               fileName.erase(position, 1);
+            }
+          break;
+         default:
+            if(position < fileName.size()) {
+               fileName[position] = c;
+            }
+          break;
+      }
+   }
+   return fileName;
+}
+
+
+// ###### Main program ######################################################
+int main(int argc, char** argv)
+{
+   const std::vector<std::string> services = {
+      "Ping", "Traceroute", "PingSummary", "Jitter"
+   };
+   std::vector<std::regex> regExps;
+   for(const std::string& service : services) {
+      regExps.push_back(makeFileNameRegExp(service));
+   }
+
+   std::mt19937 random(4711);
+   const unsigned int fileNames = 100000;
+   unsigned int       matches   = 0;
+   unsigned int       errors    = 0;
+   for(unsigned int i = 0; i < fileNames; i++) {
+      const std::string fileName = makeFileName(random);
+      for(size_t s = 0; s < services.size(); s++) {
+         std::smatch     match;
+         ResultsFileName resultsFileName;
+         const bool regExpResult = std::regex_match(fileName, match, regExps[s]);
+         const bool parseResult  = parseResultsFileName(services[s], fileName, resultsFileName);
+
+         // ====== Compare results ==========================================
+         bool same = (regExpResult == parseResult);
+         if( (same) && (regExpResult) ) {
+            matches++;
+            same = (resultsFileName.Service     == services[s])                          &&
+                   (resultsFileName.Protocol    == match[1].str())                       &&
+                   (std::string(1, resultsFileName.IDType) == match[2].str())            &&
+                   (resultsFileName.ID          == match[3].str())                       &&
+                   (resultsFileName.Source      == match[4].str())                       &&
+                   (resultsFileName.TimeStamp   == match[6].str())                       &&
+                   (resultsFileName.SeqNumber   == match[7].str())                       &&
+                   (resultsFileName.Extension   == match[8].str())                       &&
+                   (resultsFileName.Compression == match[9].str());
+         }
+         if(!same) {
+            std::cerr << "ERROR: Mismatch for service " << services[s]
+                      << " and file name " << fileName
+                      << ": regex " << regExpResult << ", parser " << parseResult << "\n";
+            errors++;
+         }
+      }
+   }
+
+   std::cout << fileNames << " file names, " << matches << " matches, "
+             << errors << " mismatches\n";
+   return (errors == 0) ? 0 : 1;
+}
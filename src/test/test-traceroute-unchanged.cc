@@ -0,0 +1,137 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+// Round-trip check of change-only Traceroute output: the #U records must be
+// imported with the same hop rows as the full #T record they refer to.
+
+#include "databaseclient-base.h"
+#include "database-configuration.h"
+#include "importer-configuration.h"
+#include "reader-traceroute.h"
+#include "tools.h"
+
+#include <iostream>
+#include <sstream>
+
+#include <boost/format.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+
+// ###### Count occurrences of a string #####################################
+static unsigned int count(const std::string& text, const std::string& what)
+{
+   unsigned int n = 0;
+   for(size_t position = text.find(what); position != std::string::npos;
+       position = text.find(what, position + what.size())) {
+      n++;
+   }
+   return n;
+}
+
+
+// ###### Import lines and return the generated statement ###################
+static std::string import(TracerouteReader&   reader,
+                          DatabaseClientBase& databaseClient,
+                          const std::string&  contents,
+                          unsigned long long& rows)
+{
+   std::istringstream                  input(contents);
+   boost::iostreams::filtering_istream dataStream;
+   dataStream.push(input);
+
+   std::ostringstream output;
+   std::streambuf*    coutBuffer = std::cout.rdbuf(output.rdbuf());
+   try {
+      reader.beginParsing(databaseClient, rows);
+      reader.parseContents(databaseClient, rows, "test.hpct", dataStream);
+      reader.finishParsing(databaseClient, rows);
+   }
+   catch(...) {
+      std::cout.rdbuf(coutBuffer);
+      throw;
+   }
+   std::cout.rdbuf(coutBuffer);
+   return output.str();
+}
+
+
+// ###### Main program ######################################################
+int main(int argc, char** argv)
+{
+   DatabaseConfiguration databaseConfiguration;
+   if(!databaseConfiguration.setBackend("DebugSQL")) {
+      std::cerr << "ERROR: DebugSQL backend is not available!\n";
+      return 1;
+   }
+   DatabaseClientBase* databaseClient = databaseConfiguration.createClient();
+   if(databaseClient == nullptr) {
+      std::cerr << "ERROR: Unable to create database client!\n";
+      return 1;
+   }
+   ImporterConfiguration importerConfiguration;
+   TracerouteReader      reader(importerConfiguration);
+
+   // ====== Full record, followed by unchanged records =====================
+   const unsigned long long t0 =
+      timePointToNanoseconds<ReaderTimePoint>(nowInUTC<ReaderTimePoint>()) - 3600000000000ULL;
+   const unsigned long long t1 = t0 + 1000000000ULL;
+   const unsigned long long t2 = t0 + 2000000000ULL;
+   const std::string contents =
+      "#? HPCT Traceroute 2 test\n" +
+      (boost::format("#Ti 1 10.0.0.1 10.0.0.2 %x 0 2 0 44 abcd 0 0 0 1234\n") % t0).str() +
+      (boost::format("\t%x 1 64 11 00000000 -1 -1 -1 1000 -1 -1 10.1.0.1\n") % t0).str() +
+      (boost::format("\t%x 2 64 255 00000000 -1 -1 -1 2000 -1 -1 10.0.0.2\n") % (t0 + 1000)).str() +
+      (boost::format("#Ui 1 10.0.0.1 10.0.0.2 %x 0 0 abce 1234 1500 -1 -1 2500 -1 -1\n") % t1).str() +
+      (boost::format("#Ui 1 10.0.0.1 10.0.0.2 %x 0 0 abcf 1234\n") % t2).str();
+
+   unsigned long long rows;
+   const std::string  statement = import(reader, *databaseClient, contents, rows);
+
+   // ====== Check the rows =================================================
+   unsigned int errors = 0;
+   if(rows != 6) {
+      std::cerr << "ERROR: Expected 6 rows, got " << rows << "!\n";
+      errors++;
+   }
+   for(const unsigned long long timeStamp : { t0, t1, t2 }) {
+      // Each record has to provide both hops, with the record's time stamp:
+      const unsigned int hops = count(statement, "(" + std::to_string(timeStamp) + ",");
+      if(hops != 2) {
+         std::cerr << "ERROR: Expected 2 hop rows for time stamp " << timeStamp
+                   << ", got " << hops << "!\n";
+         errors++;
+      }
+   }
+   if(errors > 0) {
+      std::cerr << statement << "\n";
+   }
+
+   delete databaseClient;
+   return (errors == 0) ? 0 : 1;
+}
@@ -51,6 +51,38 @@
 #endif
 
 
+// ###### Get change-only mode from name ####################################
+TracerouteChangeOnlyMode getTracerouteChangeOnlyModeFromName(const std::string& name)
+{
+   if(name == "off") {
+      return TCOM_Off;
+   }
+   else if(name == "rtts") {
+      return TCOM_RTTs;
+   }
+   else if(name == "hash") {
+      return TCOM_Hash;
+   }
+   return TCOM_Invalid;
+}
+
+
+// ###### Get name of change-only mode ######################################
+const char* getTracerouteChangeOnlyModeName(const TracerouteChangeOnlyMode mode)
+{
+   switch(mode) {
+      case TCOM_Off:
+         return "off";
+      case TCOM_RTTs:
+         return "rtts";
+      case TCOM_Hash:
+         return "hash";
+      default:
+         return "invalid";
+   }
+}
+
+
 // ###### Constructor #######################################################
 Traceroute::Traceroute(const std::string                moduleName,
                        ResultsWriter*                   resultsWriter,
@@ -68,7 +100,8 @@ Traceroute::Traceroute(const std::string                moduleName,
      IOContext(),
      SourceAddress(sourceAddress),
      TimeoutTimer(IOContext),
-     IntervalTimer(IOContext)
+     IntervalTimer(IOContext),
+     Cache(Parameters.TTLCacheSize, Parameters.TTLCacheMaxAge)
 {
    assure(Parameters.Rounds >= 1);
    assure(Parameters.InitialMaxTTL >= 1);
@@ -92,10 +125,36 @@ Traceroute::Traceroute(const std::string                moduleName,
    IterationNumber     = 0;
    MinTTL              = 1;
    MaxTTL              = Parameters.InitialMaxTTL;
+   RunMaxRTT           = ResultDuration::zero();
+   AdaptiveTimeoutScheduled = false;
+   MDAFollowUp         = false;
+   LastPathHashesFileSeqNumber = 0;
    TargetChecksumArray = new uint32_t[Parameters.Rounds];
    assure(TargetChecksumArray != nullptr);
    StopRequested.exchange(false);
 
+   // ====== Multipath Detection Algorithm (MDA) ============================
+   // With MDA, Rounds is the maximum number of flows per hop.
+   if(Parameters.MDAConfidence > 0.0) {
+      unsigned int interfaces = 1;
+      unsigned int flows;
+      do {
+         flows = std::min(getMDAStoppingPoint(interfaces, Parameters.MDAConfidence),
+                          Parameters.Rounds);
+         MDAStoppingPoints.push_back(flows);
+         interfaces++;
+      } while(flows < Parameters.Rounds);
+      MDAFlowsSent.resize(Parameters.FinalMaxTTL + 1, 0);
+   }
+
+   // ====== Warm start from TTL cache snapshot =============================
+   if(!Parameters.TTLCacheDirectory.empty()) {
+      CacheFileName = Parameters.TTLCacheDirectory /
+                         ("TTLCache-" + moduleName + "-" + SourceAddress.to_string() + ".cache");
+      Cache.load(CacheFileName);
+   }
+   CacheSnapshotTimeStamp = std::chrono::steady_clock::now();
+
    // ====== Prepare destination endpoints ==================================
    std::lock_guard<std::recursive_mutex> lock(DestinationMutex);
    for(std::set<DestinationInfo>::const_iterator destinationIterator = destinationArray.begin();
@@ -241,6 +300,7 @@ bool Traceroute::prepareRun(const bool newRound)
             std::set<DestinationInfo>::iterator toBeDeleted = DestinationIterator;
             DestinationIterator++;
             HPCT_LOG(debug) << getName() << ": Removing " << *toBeDeleted;
+            RTTEstimates.erase(*toBeDeleted);
             Destinations.erase(toBeDeleted);
          }
       }
@@ -255,6 +315,7 @@ bool Traceroute::prepareRun(const bool newRound)
    MinTTL              = 1;
    MaxTTL              = (DestinationIterator != Destinations.end()) ?
                             getInitialMaxTTL(*DestinationIterator) : Parameters.InitialMaxTTL;
+   std::fill(MDAFlowsSent.begin(), MDAFlowsSent.end(), 0);
    LastHop             = 0xffffffff;
    OutstandingRequests = 0;
    RunStartTimeStamp   = std::chrono::steady_clock::now();
@@ -270,6 +331,7 @@ void Traceroute::run()
    prepareRun(true);
    sendRequests();
    IOContext.run();
+   saveTTLCache();
 }
 
 
@@ -292,8 +354,14 @@ unsigned long long Traceroute::makeDeviation(const unsigned long long interval,
 // ###### Schedule timeout timer ############################################
 void Traceroute::scheduleTimeoutEvent()
 {
+   unsigned long long timeout = Parameters.Expiration;
+   if( (Parameters.AdaptiveTimeout) && (DestinationIterator != Destinations.end()) ) {
+      timeout = getAdaptiveTimeout(*DestinationIterator);
+   }
+   AdaptiveTimeoutScheduled = (timeout < Parameters.Expiration);
+
    TimeoutTimer.expires_at(std::chrono::steady_clock::now() +
-                           std::chrono::milliseconds(Parameters.Expiration));
+                           std::chrono::milliseconds(timeout));
    TimeoutTimer.async_wait(std::bind(&Traceroute::handleTimeoutEvent, this,
                                      std::placeholders::_1));
 }
@@ -314,7 +382,13 @@ void Traceroute::handleTimeoutEvent(const boost::system::error_code& errorCode)
 
       // ====== Has destination been reached with current TTL? ==============
       if(DestinationIterator != Destinations.end()) {
-         TTLCache[*DestinationIterator] = LastHop;
+         // Only the main probing pass provides RTT samples. The MDA
+         // follow-up requests only probe additional flows of known hops.
+         if( (Parameters.AdaptiveTimeout) && (!MDAFollowUp) ) {
+            updateRTTEstimate(*DestinationIterator,
+                              (errorCode != boost::asio::error::operation_aborted));
+         }
+         Cache.update(*DestinationIterator, std::min(LastHop, Parameters.FinalMaxTTL));
          if(LastHop == 0xffffffff) {
             if(notReachedWithCurrentTTL()) {
                // Try another round ...
@@ -324,6 +398,14 @@ void Traceroute::handleTimeoutEvent(const boost::system::error_code& errorCode)
          }
       }
 
+      // ====== MDA: probe additional flows where paths diverge ==============
+      if( (!MDAStoppingPoints.empty()) &&
+          (DestinationIterator != Destinations.end()) ) {
+         if(sendMDARequests()) {
+            return;
+         }
+      }
+
       // ====== Create results output =======================================
       processResults();
 
@@ -363,6 +445,12 @@ void Traceroute::scheduleIntervalEvent()
       if(ResultsOutput) {
          ResultsOutput->mayStartNewTransaction();
       }
+
+      // ====== Check, whether it is time for a TTL cache snapshot ==========
+      if(std::chrono::steady_clock::now() - CacheSnapshotTimeStamp >=
+            std::chrono::seconds(Parameters.TTLCacheSnapshotInterval)) {
+         saveTTLCache();
+      }
    }
    else {
        // ====== Done -> exit! ==============================================
@@ -433,10 +521,25 @@ void Traceroute::sendRequests()
 
       // ====== Send Echo Requests ==========================================
       assure(MinTTL > 0);
-      OutstandingRequests +=
-         IOModule->sendRequest(destination,
-                               MaxTTL, MinTTL, 0, Parameters.Rounds - 1,
-                               SeqNumber, TargetChecksumArray);
+      RunMaxRTT   = ResultDuration::zero();
+      MDAFollowUp = false;
+      if(MDAStoppingPoints.empty()) {
+         OutstandingRequests +=
+            IOModule->sendRequest(destination,
+                                  MaxTTL, MinTTL, 0, Parameters.Rounds - 1,
+                                  SeqNumber, TargetChecksumArray);
+      }
+      else {
+         // MDA: start with the flows necessary to detect a second interface
+         const unsigned int flows = MDAStoppingPoints[0];
+         OutstandingRequests +=
+            IOModule->sendRequest(destination,
+                                  MaxTTL, MinTTL, 0, flows - 1,
+                                  SeqNumber, TargetChecksumArray);
+         for(unsigned int ttl = MinTTL; ttl <= MaxTTL; ttl++) {
+            MDAFlowsSent[ttl] = flows;
+         }
+      }
 
       scheduleTimeoutEvent();
    }
@@ -448,17 +551,157 @@ void Traceroute::sendRequests()
 }
 
 
+// ###### MDA: send requests for additional flows ###########################
+bool Traceroute::sendMDARequests()
+{
+   // ====== Count the interfaces seen at each hop ==========================
+   std::vector<std::set<boost::asio::ip::address>> interfaces(MaxTTL + 1);
+   for(const std::pair<const unsigned short, ResultEntry*>& result : ResultsMap) {
+      const ResultEntry* resultEntry = result.second;
+      if( (resultEntry->status() != Unknown) &&
+          (resultEntry->status() != Timeout) &&
+          (!statusIsSendError(resultEntry->status())) &&
+          (resultEntry->hopNumber() <= MaxTTL) ) {
+         interfaces[resultEntry->hopNumber()].insert(resultEntry->hopAddress());
+      }
+   }
+
+   // ====== Probe more flows at hops with multiple interfaces ==============
+   // MDA-Lite: only where a divergence has been detected, the number of
+   // flows is increased to the stopping point for the number of interfaces
+   // seen so far.
+   const DestinationInfo& destination = *DestinationIterator;
+   const unsigned int     lastTTL     = std::min(LastHop, MaxTTL);
+   bool                   sent        = false;
+   // All hops are checked, since MinTTL may have been raised by trying
+   // further TTLs before.
+   for(unsigned int ttl = 1; ttl <= lastTTL; ttl++) {
+      const size_t seen = interfaces[ttl].size();
+      if(seen >= 2) {
+         const unsigned int flows =
+            MDAStoppingPoints[std::min(seen, MDAStoppingPoints.size()) - 1];
+         if(flows > MDAFlowsSent[ttl]) {
+            HPCT_LOG(debug) << getName() << ": MDA for " << destination
+                            << ": " << seen << " interfaces at hop " << ttl
+                            << ", probing flows " << MDAFlowsSent[ttl]
+                            << " to " << flows - 1;
+            OutstandingRequests +=
+               IOModule->sendRequest(destination,
+                                     ttl, ttl, MDAFlowsSent[ttl], flows - 1,
+                                     SeqNumber, TargetChecksumArray);
+            MDAFlowsSent[ttl] = flows;
+            sent              = true;
+         }
+      }
+   }
+   if(sent) {
+      MDAFollowUp = true;
+      scheduleTimeoutEvent();
+   }
+   return sent;
+}
+
+
+// ###### MDA: compute stopping point #######################################
+// Number of flows needed to detect, with the given confidence, another
+// interface when the given number of interfaces has been seen so far
+// (see Veitch et al.: "Failure Control in Multipath Route Tracing").
+unsigned int Traceroute::getMDAStoppingPoint(const unsigned int interfaces,
+                                             const float        confidence)
+{
+   assure( (confidence > 0.0) && (confidence < 1.0) );
+   const double k = interfaces;
+   return (unsigned int)std::ceil(std::log((1.0 - confidence) / (k + 1.0)) /
+                                  std::log(k / (k + 1.0)));
+}
+
+
 // ###### Get value for initial MaxTTL ######################################
-unsigned int Traceroute::getInitialMaxTTL(const DestinationInfo& destination) const
+unsigned int Traceroute::getInitialMaxTTL(const DestinationInfo& destination)
 {
-   const std::map<DestinationInfo, unsigned int>::const_iterator found = TTLCache.find(destination);
-   if(found != TTLCache.end()) {
-      return std::min(found->second, Parameters.FinalMaxTTL);
+   unsigned int ttl;
+   if(Cache.lookup(destination, ttl)) {
+      return std::min(ttl, Parameters.FinalMaxTTL);
    }
    return Parameters.InitialMaxTTL;
 }
 
 
+// ###### Write TTL cache snapshot ##########################################
+void Traceroute::saveTTLCache()
+{
+   if(!CacheFileName.empty()) {
+      std::lock_guard<std::recursive_mutex> lock(DestinationMutex);
+      Cache.save(CacheFileName);
+   }
+   CacheSnapshotTimeStamp = std::chrono::steady_clock::now();
+}
+
+
+// ###### Get adaptive timeout for destination ############################
+unsigned long long Traceroute::getAdaptiveTimeout(const DestinationInfo& destination) const
+{
+   const std::map<DestinationInfo, RTTEstimate>::const_iterator found =
+      RTTEstimates.find(destination);
+   if(found == RTTEstimates.end()) {
+      // No estimate yet -> use the full expiration time
+      return Parameters.Expiration;
+   }
+
+   // ====== RTO = SRTT + max(G, K * RTTVAR), see RFC 6298 ==================
+   const RTTEstimate& estimate = found->second;
+   const long long    rto      = estimate.SRTT + std::max(1000LL, 4 * estimate.RTTVar);
+   const unsigned long long timeout =
+      ((unsigned long long)rto * estimate.Backoff + 999) / 1000;
+   return std::min(std::max((unsigned long long)Parameters.MinimumTimeout, timeout),
+                   (unsigned long long)Parameters.Expiration);
+}
+
+
+// ###### Update RTT estimate of destination ################################
+void Traceroute::updateRTTEstimate(const DestinationInfo& destination,
+                                   const bool             timeoutExpired)
+{
+   std::map<DestinationInfo, RTTEstimate>::iterator found =
+      RTTEstimates.find(destination);
+
+   // ====== Add RTT sample =================================================
+   // The sample is the RTT of the latest response to the probes sent, i.e.
+   // the time after which no further responses are to be expected.
+   if(RunMaxRTT > ResultDuration::zero()) {
+      const long long r =
+         std::chrono::duration_cast<std::chrono::microseconds>(RunMaxRTT).count();
+      if(found == RTTEstimates.end()) {
+         RTTEstimate estimate;
+         estimate.SRTT    = r;
+         estimate.RTTVar  = r / 2;
+         estimate.Backoff = 1;
+         found = RTTEstimates.insert(std::pair<DestinationInfo, RTTEstimate>(destination, estimate)).first;
+      }
+      else {
+         RTTEstimate& estimate = found->second;
+         estimate.RTTVar = (3 * estimate.RTTVar + std::abs(estimate.SRTT - r)) / 4;
+         estimate.SRTT   = (7 * estimate.SRTT + r) / 8;
+      }
+   }
+
+   // ====== Back off, if responses may have been missed ====================
+   if(found != RTTEstimates.end()) {
+      RTTEstimate& estimate = found->second;
+      if( (timeoutExpired) && (AdaptiveTimeoutScheduled) && (LastHop == 0xffffffff) ) {
+         // The adaptive timeout has expired without reaching the destination.
+         // The responses may just have been late -> increase the timeout.
+         estimate.Backoff = std::min(2 * estimate.Backoff, 64U);
+         HPCT_LOG(debug) << getName() << ": Adaptive timeout for " << destination
+                         << " expired, backoff is now " << estimate.Backoff;
+      }
+      else if(LastHop != 0xffffffff) {
+         estimate.Backoff = 1;
+      }
+   }
+}
+
+
 // ###### Received a new response ###########################################
 void Traceroute::newResult(const ResultEntry* resultEntry)
 {
@@ -466,6 +709,17 @@ void Traceroute::newResult(const ResultEntry* resultEntry)
       OutstandingRequests--;
    }
 
+   // ====== Remember the latest response for the RTT estimate ==============
+   if( (!MDAFollowUp) &&
+       (resultEntry->status() != Timeout) &&
+       (!statusIsSendError(resultEntry->status())) ) {
+      unsigned int         timeSource;
+      const ResultDuration rtt = resultEntry->getRTT(RXTimeStampType::RXTST_Application, timeSource);
+      if(rtt > RunMaxRTT) {
+         RunMaxRTT = rtt;
+      }
+   }
+
    // ====== Found last hop? ================================================
    if(resultEntry->status() == Success) {
       LastHop = std::min(LastHop, resultEntry->hopNumber());
@@ -516,6 +770,7 @@ void Traceroute::processResults()
       unsigned int currentHop         = 0;
       bool         completeTraceroute = true;   // all hops have responded
       bool         destinationReached = false;  // destination has responded
+      bool         partialRoute       = false;  // not all hops probed (MDA)
       std::string pathString          = SourceAddress.to_string();
       for(ResultEntry* resultEntry : resultsVector) {
          if(resultEntry->roundNumber() == round) {
@@ -523,6 +778,19 @@ void Traceroute::processResults()
             currentHop++;
             totalHops = resultEntry->hopNumber();
 
+            // ====== MDA: hops not probed in this round ====================
+            if( (currentHop < totalHops) && (MDAStoppingPoints.empty()) ) {
+               // Without MDA, every hop is probed in each round -> skip gap
+               HPCT_LOG(warning) << getName() << ": Unexpected gap before hop "
+                                 << totalHops << " in round " << round;
+               currentHop = totalHops;
+            }
+            while(currentHop < totalHops) {
+               pathString += "-?";
+               partialRoute = true;
+               currentHop++;
+            }
+
             // ====== We have reached the destination =======================
             if(resultEntry->status() == Success) {
                pathString += "-" + resultEntry->destinationAddress().to_string();
@@ -565,12 +833,26 @@ void Traceroute::processResults()
       if(destinationReached) {
          statusFlags |= Flag_DestinationReached;
       }
+      if(partialRoute) {
+         statusFlags |= Flag_PartialRoute;
+      }
 
       // ====== Print traceroute entries =======================================
       HPCT_LOG(trace) << getName() << ": Round " << round << ":";
 
-      bool     writeHeader   = true;
-      uint16_t checksumCheck = 0;
+      // A shared results writer must not interleave the lines of a record
+      // with lines of other services. Also, the check for an unchanged path
+      // has to see the same output file as the record written afterwards.
+      std::unique_lock<std::recursive_mutex> outputLock;
+      if(ResultsOutput) {
+         outputLock = std::unique_lock<std::recursive_mutex>(ResultsOutput->outputMutex());
+      }
+
+      const bool         unchanged     = isUnchangedPath(round, pathHash);
+      const ResultEntry* firstEntry    = nullptr;
+      std::string        hopRTTs;
+      bool               writeHeader   = true;
+      uint16_t           checksumCheck = 0;
       for(ResultEntry* resultEntry : resultsVector) {
          if(resultEntry->roundNumber() == round) {
             HPCT_LOG(trace) << getName() << ": " << *resultEntry;
@@ -578,9 +860,32 @@ void Traceroute::processResults()
             if(ResultCallback) {
                ResultCallback(this, resultEntry);
             }
-            writeTracerouteResultEntry(resultEntry, timeStamp, writeHeader,
-                                       totalHops, statusFlags, pathHash,
-                                       checksumCheck);
+            if(!unchanged) {
+               writeTracerouteResultEntry(resultEntry, timeStamp, writeHeader,
+                                          totalHops, statusFlags, pathHash,
+                                          checksumCheck);
+            }
+            else {
+               if(firstEntry == nullptr) {
+                  firstEntry = resultEntry;
+               }
+               if(Parameters.ChangeOnly == TCOM_RTTs) {
+                  unsigned int   timeSource;
+                  ResultDuration rttApplication;
+                  ResultDuration rttSoftware;
+                  ResultDuration rttHardware;
+                  ResultDuration delayAppSend;
+                  ResultDuration delayAppReceive;
+                  ResultDuration delayQueuing;
+                  resultEntry->obtainResultsValues(timeSource,
+                                                   rttApplication, rttSoftware, rttHardware,
+                                                   delayQueuing, delayAppSend, delayAppReceive);
+                  hopRTTs += str(boost::format(" %d %d %d")
+                                    % std::chrono::duration_cast<std::chrono::nanoseconds>(rttApplication).count()
+                                    % std::chrono::duration_cast<std::chrono::nanoseconds>(rttSoftware).count()
+                                    % std::chrono::duration_cast<std::chrono::nanoseconds>(rttHardware).count());
+               }
+            }
 
             if( (resultEntry->status() == Success) ||
                 (statusIsUnreachable(resultEntry->status())) ) {
@@ -589,10 +894,81 @@ void Traceroute::processResults()
             }
          }
       }
+      if(firstEntry != nullptr) {
+         writeUnchangedTracerouteEntry(firstEntry, timeStamp, pathHash, hopRTTs);
+      }
    }
 }
 
 
+// ###### Check whether the path is unchanged ###############################
+bool Traceroute::isUnchangedPath(const unsigned int round,
+                                 const uint64_t     pathHash)
+{
+   if( (Parameters.ChangeOnly == TCOM_Off) ||
+       (ResultsOutput == nullptr) ||
+       (OutputFormatVersion < OFT_HiPerConTracer_Version2) ||
+       (DestinationIterator == Destinations.end()) ) {
+      return false;
+   }
+
+   // ====== Each results file must be self-contained =======================
+   // An unchanged record refers to the last full record of the path.
+   // Since results files may be imported in any order, this full record
+   // has to be in the same file. That is, start over with a new file.
+   if(ResultsOutput->fileSeqNumber() != LastPathHashesFileSeqNumber) {
+      LastPathHashes.clear();
+      LastPathHashesFileSeqNumber = ResultsOutput->fileSeqNumber();
+   }
+
+   // ====== Compare with last path hash ====================================
+   const std::pair<DestinationInfo, unsigned int> key(*DestinationIterator, round);
+   std::map<std::pair<DestinationInfo, unsigned int>, uint64_t>::iterator found =
+      LastPathHashes.find(key);
+   if(found != LastPathHashes.end()) {
+      if(found->second == pathHash) {
+         return true;
+      }
+      found->second = pathHash;
+   }
+   else {
+      LastPathHashes.insert(std::pair<std::pair<DestinationInfo, unsigned int>, uint64_t>(key, pathHash));
+   }
+   return false;
+}
+
+
+// ###### Write unchanged Traceroute entry to output file ###################
+void Traceroute::writeUnchangedTracerouteEntry(const ResultEntry* resultEntry,
+                                               uint64_t&          timeStamp,
+                                               const uint64_t     pathHash,
+                                               const std::string& hopRTTs)
+{
+   if(timeStamp == 0) {
+      // Same time stamp as for full entries, see writeTracerouteResultEntry()!
+      timeStamp = nsSinceEpoch<ResultTimePoint>(
+         resultEntry->sendTime(TXTimeStampType::TXTST_Application));
+   }
+
+   ResultsOutput->insert(
+      str(boost::format("#U%c %d %s %s %x %d %x %x %x%s")
+         % (unsigned char)IOModule->getProtocolType()
+
+         % ResultsOutput->measurementID()
+         % resultEntry->sourceAddress().to_string()
+         % resultEntry->destinationAddress().to_string()
+         % timeStamp
+         % resultEntry->roundNumber()
+
+         % (unsigned int)(*DestinationIterator).trafficClass()
+         % resultEntry->checksum()
+         % (int64_t)pathHash
+
+         % hopRTTs
+   ));
+}
+
+
 // ###### Write Traceroute result entry to output file ######################
 void Traceroute::writeTracerouteResultEntry(const ResultEntry* resultEntry,
                                             uint64_t&          timeStamp,
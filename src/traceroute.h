@@ -34,9 +34,11 @@
 #include "resultentry.h"
 #include "resultswriter.h"
 #include "service.h"
+#include "ttlcache.h"
 
 #include <atomic>
 #include <chrono>
+#include <filesystem>
 #include <mutex>
 #include <thread>
 
@@ -46,6 +48,18 @@
 class ICMPHeader;
 
 
+enum TracerouteChangeOnlyMode
+{
+   TCOM_Invalid = -1,
+   TCOM_Off     = 0,   // Always write full records
+   TCOM_RTTs    = 1,   // Unchanged path: write path hash and per-hop RTTs
+   TCOM_Hash    = 2    // Unchanged path: write path hash only
+};
+
+TracerouteChangeOnlyMode getTracerouteChangeOnlyModeFromName(const std::string& name);
+const char* getTracerouteChangeOnlyModeName(const TracerouteChangeOnlyMode mode);
+
+
 struct TracerouteParameters
 {
    unsigned long long Interval;
@@ -58,6 +72,17 @@ struct TracerouteParameters
    unsigned int       PacketSize;
    uint16_t           SourcePort;
    uint16_t           DestinationPort;
+   unsigned int       SummaryInterval;   // Ping summary window in s (0 = raw)
+   TracerouteChangeOnlyMode ChangeOnly;
+
+   float                 MDAConfidence;
+   bool                  AdaptiveTimeout;
+   unsigned int          MinimumTimeout;
+
+   unsigned int          TTLCacheSize;
+   unsigned int          TTLCacheMaxAge;
+   unsigned int          TTLCacheSnapshotInterval;
+   std::filesystem::path TTLCacheDirectory;
 };
 
 
@@ -87,7 +112,7 @@ class Traceroute : public Service
 
    protected:
    virtual bool prepareRun(const bool newRound = false);
-   void         run();
+   virtual void run();
    virtual void scheduleTimeoutEvent();
    void         cancelTimeoutEvent();
    virtual void handleTimeoutEvent(const boost::system::error_code& errorCode);
@@ -98,10 +123,17 @@ class Traceroute : public Service
    virtual bool notReachedWithCurrentTTL();
    virtual void sendRequests();
    virtual void processResults();
+   bool         sendMDARequests();
+   static unsigned int getMDAStoppingPoint(const unsigned int interfaces,
+                                           const float        confidence);
 
    static unsigned long long makeDeviation(const unsigned long long interval,
                                            const float              deviation);
-   unsigned int getInitialMaxTTL(const DestinationInfo&   destination) const;
+   unsigned int getInitialMaxTTL(const DestinationInfo&   destination);
+   void         saveTTLCache();
+   unsigned long long getAdaptiveTimeout(const DestinationInfo& destination) const;
+   void         updateRTTEstimate(const DestinationInfo& destination,
+                                  const bool             timeoutExpired);
    void         newResult(const ResultEntry* resultEntry);
 
    inline std::vector<ResultEntry*> makeSortedResultsVector(int (*compareResults)(const ResultEntry* a,
@@ -119,6 +151,12 @@ class Traceroute : public Service
    }
 
    static int compareTracerouteResults(const ResultEntry* a, const ResultEntry* b);
+   bool isUnchangedPath(const unsigned int round,
+                        const uint64_t     pathHash);
+   void writeUnchangedTracerouteEntry(const ResultEntry* resultEntry,
+                                      uint64_t&          timeStamp,
+                                      const uint64_t     pathHash,
+                                      const std::string& hopRTTs);
    void writeTracerouteResultEntry(const ResultEntry* resultEntry,
                                    uint64_t&          timeStamp,
                                    bool&              writeHeader,
@@ -146,9 +184,27 @@ class Traceroute : public Service
    unsigned int                            OutstandingRequests;
    unsigned int                            LastHop;
    std::map<unsigned short, ResultEntry*>  ResultsMap;
-   std::map<DestinationInfo, unsigned int> TTLCache;
+   // RFC 6298-style RTT estimate per destination, for adaptive timeouts:
+   struct RTTEstimate {
+      long long    SRTT;      // Smoothed RTT in us
+      long long    RTTVar;    // RTT variation in us
+      unsigned int Backoff;   // Timeout multiplier
+   };
+   std::map<DestinationInfo, RTTEstimate>  RTTEstimates;
+   ResultDuration                          RunMaxRTT;
+   bool                                    AdaptiveTimeoutScheduled;
+   bool                                    MDAFollowUp;   // MDA requests outstanding
+
+   TTLCache                                Cache;
+   std::filesystem::path                   CacheFileName;
+   std::chrono::steady_clock::time_point   CacheSnapshotTimeStamp;
    unsigned int                            MinTTL;
    unsigned int                            MaxTTL;
+   std::vector<unsigned int>               MDAStoppingPoints;
+   std::vector<unsigned int>               MDAFlowsSent;
+   // Last path hash per destination and round, for change-only output:
+   std::map<std::pair<DestinationInfo, unsigned int>, uint64_t> LastPathHashes;
+   unsigned long long                      LastPathHashesFileSeqNumber;
    std::chrono::steady_clock::time_point   RunStartTimeStamp;
    uint32_t*                               TargetChecksumArray;
 
@@ -158,4 +158,33 @@ class TraceServiceHeader
    uint8_t      Data[MAX_TRACESERVICE_HEADER_SIZE];
 };
 
+
+
+// Read-only view on a TraceService header within a receive buffer, without
+// copying. valid() is only true if the buffer holds at least the fixed part.
+class TraceServiceHeaderView
+{
+   public:
+   TraceServiceHeaderView(const uint8_t* data, const size_t length)
+      : Data((length >= MIN_TRACESERVICE_HEADER_SIZE) ? data : nullptr) { }
+
+   inline bool     valid()       const { return Data != nullptr; }
+
+   inline uint32_t magicNumber() const {
+      return ( ((uint32_t)Data[0] << 24) |
+               ((uint32_t)Data[1] << 16) |
+               ((uint32_t)Data[2] << 8)  |
+               (uint32_t)Data[3] );
+   }
+   inline uint8_t  sendTTL()     const { return Data[4]; }
+   inline uint8_t  round()       const { return Data[5]; }
+   inline uint16_t seqNumber()   const {
+      return ( ((uint16_t)Data[6] << 8) |
+               (uint16_t)Data[7] );
+   }
+
+   private:
+   const uint8_t* Data;
+};
+
 #endif
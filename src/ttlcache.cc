@@ -0,0 +1,311 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+#include "ttlcache.h"
+#include "assure.h"
+#include "logger.h"
+#include "tools.h"
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/format.hpp>
+
+
+// ###### Constructor #######################################################
+TTLCache::TTLCache(const unsigned int capacity,
+                   const unsigned int maxAge)
+   : Capacity(std::max(1U, capacity)),
+     MaxAge(maxAge)
+{
+   // ====== Allocate table with a load factor of at most 50% ===============
+   size_t tableSize = 16;
+   while(tableSize < 2 * Capacity) {
+      tableSize <<= 1;
+   }
+   Table.resize(tableSize);
+   Mask      = tableSize - 1;
+   Entries   = 0;
+   ClockHand = 0;
+   clear();
+}
+
+
+// ###### Destructor ########################################################
+TTLCache::~TTLCache()
+{
+}
+
+
+// ###### Remove all entries ################################################
+void TTLCache::clear()
+{
+   for(Slot& slot : Table) {
+      slot.Used       = false;
+      slot.Referenced = false;
+   }
+   Entries   = 0;
+   ClockHand = 0;
+}
+
+
+// ###### Hash function (FNV-1a over address and traffic class) #############
+size_t TTLCache::hashDestination(const DestinationInfo& destination)
+{
+   uint64_t hash = 0xcbf29ce484222325ULL;
+   auto mix = [&hash](const uint8_t byte) {
+      hash ^= byte;
+      hash *= 0x100000001b3ULL;
+   };
+
+   const boost::asio::ip::address& address = destination.address();
+   if(address.is_v4()) {
+      for(const uint8_t byte : address.to_v4().to_bytes()) {
+         mix(byte);
+      }
+   }
+   else {
+      for(const uint8_t byte : address.to_v6().to_bytes()) {
+         mix(byte);
+      }
+   }
+   mix(destination.trafficClass());
+   return (size_t)hash;
+}
+
+
+// ###### Find slot of destination or the free slot to insert it ############
+size_t TTLCache::findSlot(const DestinationInfo& destination,
+                          const size_t           hash) const
+{
+   // Linear probing. Since the load factor is at most 50%, there is always
+   // a free slot terminating the probe sequence.
+   size_t index = hash & Mask;
+   while(Table[index].Used) {
+      if( (Table[index].Hash == hash) && (Table[index].Destination == destination) ) {
+         break;
+      }
+      index = (index + 1) & Mask;
+   }
+   return index;
+}
+
+
+// ###### Look up TTL of destination ########################################
+bool TTLCache::lookup(const DestinationInfo& destination,
+                      unsigned int&          ttl)
+{
+   const size_t index = findSlot(destination, hashDestination(destination));
+   Slot&        slot  = Table[index];
+   if(slot.Used) {
+      if(isExpired(slot, usSinceEpoch(std::chrono::system_clock::now()))) {
+         erase(index);
+         return false;
+      }
+      slot.Referenced = true;
+      ttl             = slot.TTL;
+      return true;
+   }
+   return false;
+}
+
+
+// ###### Add or update TTL of destination ##################################
+void TTLCache::update(const DestinationInfo& destination,
+                      const unsigned int     ttl)
+{
+   insert(destination, ttl, usSinceEpoch(std::chrono::system_clock::now()));
+}
+
+
+// ###### Insert entry, evicting another one if the cache is full ###########
+void TTLCache::insert(const DestinationInfo& destination,
+                      const unsigned int     ttl,
+                      const uint64_t         lastUpdate)
+{
+   const size_t hash  = hashDestination(destination);
+   size_t       index = findSlot(destination, hash);
+   if(!Table[index].Used) {
+      if(Entries >= Capacity) {
+         evict(lastUpdate);
+         // The eviction may have moved entries -> search again:
+         index = findSlot(destination, hash);
+      }
+      Table[index].Destination = destination;
+      Table[index].Hash        = hash;
+      Table[index].Used        = true;
+      Entries++;
+   }
+   Table[index].TTL        = ttl;
+   Table[index].LastUpdate = lastUpdate;
+   Table[index].Referenced = true;
+}
+
+
+// ###### Remove entry (backward-shift deletion) ############################
+void TTLCache::erase(size_t index)
+{
+   assure(Table[index].Used);
+   Table[index].Used       = false;
+   Table[index].Referenced = false;
+   Entries--;
+
+   // ====== Move following entries of the probe sequence back ==============
+   size_t next = index;
+   for(;;) {
+      next = (next + 1) & Mask;
+      if(!Table[next].Used) {
+         break;
+      }
+      // An entry may only be moved to the free slot, if its home slot is
+      // not located cyclically in (index, next]:
+      const size_t home = Table[next].Hash & Mask;
+      if( ((index <= next) && ((home <= index) || (home > next))) ||
+          ((index > next)  && ((home <= index) && (home > next))) ) {
+         Table[index]            = Table[next];
+         Table[next].Used        = false;
+         Table[next].Referenced  = false;
+         index = next;
+      }
+   }
+}
+
+
+// ###### Evict one entry using the CLOCK algorithm #########################
+void TTLCache::evict(const uint64_t now)
+{
+   assure(Entries > 0);
+   for(;;) {
+      Slot& slot = Table[ClockHand];
+      if(slot.Used) {
+         if( (slot.Referenced == false) || (isExpired(slot, now)) ) {
+            HPCT_LOG(trace) << "TTLCache: Evicting " << slot.Destination;
+            erase(ClockHand);
+            return;
+         }
+         slot.Referenced = false;   // Second chance
+      }
+      ClockHand = (ClockHand + 1) & Mask;
+   }
+}
+
+
+// ###### Load snapshot from file ###########################################
+bool TTLCache::load(const std::filesystem::path& fileName)
+{
+   std::ifstream inputFile(fileName);
+   if(!inputFile.good()) {
+      HPCT_LOG(debug) << "No TTL cache snapshot " << fileName;
+      return false;
+   }
+
+   const uint64_t now     = usSinceEpoch(std::chrono::system_clock::now());
+   unsigned int   loaded  = 0;
+   unsigned int   expired = 0;
+   std::string    inputLine;
+   while(std::getline(inputFile, inputLine)) {
+      if( (inputLine.size() == 0) || (inputLine[0] == '#') ) {
+         continue;
+      }
+
+      // ====== Parse entry =================================================
+      std::istringstream          is(inputLine);
+      std::string                 addressString;
+      unsigned int                trafficClass;
+      unsigned int                ttl;
+      uint64_t                    lastUpdate;
+      boost::system::error_code   errorCode;
+      if(!(is >> addressString >> std::hex >> trafficClass >> std::dec >> ttl >> std::hex >> lastUpdate)) {
+         HPCT_LOG(warning) << "Bad line in TTL cache snapshot " << fileName
+                           << ": " << inputLine;
+         continue;
+      }
+      const boost::asio::ip::address address =
+         boost::asio::ip::make_address(addressString, errorCode);
+      if( (errorCode) || (trafficClass > 0xff) || (ttl < 1) || (ttl > 255) ) {
+         HPCT_LOG(warning) << "Bad entry in TTL cache snapshot " << fileName
+                           << ": " << inputLine;
+         continue;
+      }
+
+      // ====== Add entry, unless it is too old =============================
+      Slot slot;
+      slot.LastUpdate = lastUpdate;
+      if(isExpired(slot, now)) {
+         expired++;
+         continue;
+      }
+      insert(DestinationInfo(address, trafficClass), ttl, lastUpdate);
+      loaded++;
+   }
+
+   HPCT_LOG(info) << "Loaded TTL cache snapshot " << fileName << ": "
+                  << loaded << " entries, " << expired << " expired";
+   return true;
+}
+
+
+// ###### Save snapshot to file #############################################
+bool TTLCache::save(const std::filesystem::path& fileName) const
+{
+   // ====== Write temporary file ===========================================
+   std::filesystem::path tempFileName = fileName;
+   tempFileName += ".tmp";
+   std::ofstream outputFile(tempFileName, std::ios::out | std::ios::trunc);
+   if(!outputFile.good()) {
+      HPCT_LOG(error) << "Unable to create TTL cache snapshot " << tempFileName;
+      return false;
+   }
+   outputFile << "#? HPCT TTLCache 1\n";
+   for(const Slot& slot : Table) {
+      if(slot.Used) {
+         outputFile << boost::format("%s %02x %u %x\n")
+                          % slot.Destination.address().to_string()
+                          % (unsigned int)slot.Destination.trafficClass()
+                          % slot.TTL
+                          % slot.LastUpdate;
+      }
+   }
+   outputFile.close();
+   if(!outputFile.good()) {
+      HPCT_LOG(error) << "Unable to write TTL cache snapshot " << tempFileName;
+      return false;
+   }
+
+   // ====== Atomically replace the old snapshot ============================
+   std::error_code errorCode;
+   std::filesystem::rename(tempFileName, fileName, errorCode);
+   if(errorCode) {
+      HPCT_LOG(error) << "Unable to rename TTL cache snapshot " << tempFileName
+                      << " to " << fileName << ": " << errorCode.message();
+      return false;
+   }
+   HPCT_LOG(debug) << "Saved TTL cache snapshot " << fileName << ": "
+                   << Entries << " entries";
+   return true;
+}
@@ -0,0 +1,91 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+#ifndef TTLCACHE_H
+#define TTLCACHE_H
+
+#include "destinationinfo.h"
+
+#include <filesystem>
+#include <vector>
+
+
+class TTLCache
+{
+   public:
+   TTLCache(const unsigned int capacity,
+            const unsigned int maxAge);
+   ~TTLCache();
+
+   inline size_t size() const {
+      return Entries;
+   }
+   inline size_t capacity() const {
+      return Capacity;
+   }
+
+   bool lookup(const DestinationInfo& destination,
+               unsigned int&          ttl);
+   void update(const DestinationInfo& destination,
+               const unsigned int     ttl);
+   void clear();
+
+   bool load(const std::filesystem::path& fileName);
+   bool save(const std::filesystem::path& fileName) const;
+
+   private:
+   struct Slot {
+      DestinationInfo Destination;
+      size_t          Hash;
+      uint64_t        LastUpdate;   // Microseconds since the epoch
+      unsigned int    TTL;
+      bool            Used;
+      bool            Referenced;   // CLOCK reference bit
+   };
+
+   static size_t hashDestination(const DestinationInfo& destination);
+   size_t        findSlot(const DestinationInfo& destination,
+                          const size_t           hash) const;
+   void          insert(const DestinationInfo& destination,
+                        const unsigned int     ttl,
+                        const uint64_t         lastUpdate);
+   void          erase(size_t index);
+   void          evict(const uint64_t now);
+   inline bool   isExpired(const Slot& slot, const uint64_t now) const {
+      return (MaxAge > 0) && (slot.LastUpdate + 1000000ULL * MaxAge < now);
+   }
+
+   const size_t       Capacity;
+   const unsigned int MaxAge;
+   std::vector<Slot>  Table;
+   size_t             Mask;
+   size_t             Entries;
+   size_t             ClockHand;
+};
+
+#endif
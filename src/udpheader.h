@@ -105,4 +105,30 @@ class UDPHeader
    uint8_t Data[8];
 };
 
+
+
+// Read-only view on a UDP header within a receive buffer, without copying.
+// valid() is only true if the buffer holds the complete header.
+class UDPHeaderView
+{
+   public:
+   UDPHeaderView(const uint8_t* data, const size_t length)
+      : Data((length >= 8) ? data : nullptr) { }
+
+   inline bool     valid()           const { return Data != nullptr; }
+   inline size_t   size()            const { return 8;               }
+
+   inline uint16_t sourcePort()      const { return decode(0, 1);    }
+   inline uint16_t destinationPort() const { return decode(2, 3);    }
+   inline uint16_t length()          const { return decode(4, 5);    }
+   inline uint16_t checksum()        const { return decode(6, 7);    }
+
+   private:
+   inline uint16_t decode(const unsigned int a, const unsigned int b) const {
+      return ((uint16_t)Data[a] << 8) + Data[b];
+   }
+
+   const uint8_t* Data;
+};
+
 #endif
@@ -35,6 +35,11 @@
 
 #include <boost/filesystem/operations.hpp>
 
+#include <condition_variable>
+#include <fstream>
+#include <set>
+#include <thread>
+
 
 // ###### < operator for sorting ############################################
 bool operator<(const UniversalImporter::WorkerMapping& a,
@@ -117,21 +122,33 @@ bool UniversalImporter::start(const bool quitWhenIdle)
                                            std::placeholders::_1,
                                            std::placeholders::_2));
 
-   // ====== Look for files =================================================
-   HPCT_LOG(info) << "Performing initial directory traversal to look for input files ...";
-   lookForFiles();
-   HPCT_LOG(info) << "Importer status after initial directory traversal:\n" << *this;
-
    // ====== Start workers ==================================================
+   // The workers are started before the initial directory traversal, i.e.
+   // they import the files already found while the traversal goes on.
+   // To import the files of each source in chronological order, the readers
+   // hold back the files which the traversal has not yet passed (see
+   // lookForFiles()).
    HPCT_LOG(info) << "Starting " << WorkerMap.size() << " worker threads ...";
    for(std::map<const WorkerMapping, Worker*>::iterator workerMappingIterator = WorkerMap.begin();
        workerMappingIterator != WorkerMap.end(); workerMappingIterator++) {
       Worker* worker = workerMappingIterator->second;
-      worker->start(quitWhenIdle);
+      worker->start();
    }
 
+   // ====== Look for files =================================================
+   HPCT_LOG(info) << "Performing initial directory traversal to look for input files ...";
+   lookForFiles();
+   HPCT_LOG(info) << "Importer status after initial directory traversal:\n" << *this;
+
    // ====== Quit when idle? ================================================
    if(quitWhenIdle) {
+      // Only now, after the initial directory traversal, the workers may
+      // quit when running out of input files.
+      for(std::map<const WorkerMapping, Worker*>::iterator workerMappingIterator = WorkerMap.begin();
+          workerMappingIterator != WorkerMap.end(); workerMappingIterator++) {
+         Worker* worker = workerMappingIterator->second;
+         worker->setQuitWhenIdle(true);
+      }
       INotifyStream.cancel();
       StatusTimer.cancel();
       GarbageCollectionTimer.cancel();
@@ -327,8 +344,95 @@ void UniversalImporter::lookForFiles()
 {
    HPCT_LOG(info) << "Looking for input files in directory " << ImporterConfig.getImportFilePath()
                   << " (filter \"" << ImportPathFilter << "\") ...";
-   lookForFiles(ImporterConfig.getImportFilePath(),
-                1, ImporterConfig.getImportMaxDepth());
+   const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+   readJournal();
+
+   // ====== Traverse the directory tree with multiple threads ==============
+   // Each thread takes the first directory from the queue, adds its files
+   // and puts its subdirectories back into the queue. So, the directories
+   // are read in the order of their paths, i.e. a timestamp hierarchy is
+   // read in chronological order. The first directory which is still queued
+   // or being read is the watermark: files in directories before it are
+   // complete, the files from it on are held back by the readers.
+   std::map<std::filesystem::path, unsigned int> directoryQueue;
+   std::set<std::filesystem::path>               busyDirectories;
+   std::filesystem::path                         watermark = ImporterConfig.getImportFilePath();
+   std::mutex                                    queueMutex;
+   std::condition_variable                       queueNotification;
+   std::atomic<unsigned long long>               files(0);
+   std::atomic<unsigned long long>               directories(0);
+   std::atomic<unsigned long long>               unchangedDirectories(0);
+
+   setHoldBack(watermark);
+   directoryQueue.insert(std::pair<std::filesystem::path, unsigned int>(watermark, 1));
+   auto scanner = [&]() {
+      std::unique_lock lock(queueMutex);
+      while(true) {
+         queueNotification.wait(lock, [&]() {
+            return (!directoryQueue.empty()) || (busyDirectories.empty());
+         });
+         if(directoryQueue.empty()) {
+            break;   // Queue is empty, and no thread is busy -> done!
+         }
+         const std::pair<std::filesystem::path, unsigned int> entry = *directoryQueue.begin();
+         directoryQueue.erase(directoryQueue.begin());
+         busyDirectories.insert(entry.first);
+         lock.unlock();
+
+         std::list<std::pair<std::filesystem::path, unsigned int>> subDirectoryList;
+         bool unchanged = false;
+         try {
+            files += scanDirectory(entry.first, entry.second,
+                                   ImporterConfig.getImportMaxDepth(),
+                                   subDirectoryList, unchanged);
+         }
+         catch(const std::filesystem::filesystem_error& e) {
+            HPCT_LOG(warning) << "Unable to read directory " << entry.first << ": " << e.what();
+         }
+         directories++;
+         if(unchanged) {
+            unchangedDirectories++;
+         }
+
+         lock.lock();
+         directoryQueue.insert(subDirectoryList.begin(), subDirectoryList.end());
+         busyDirectories.erase(entry.first);
+
+         // ------ Advance the watermark -----------------------------------
+         std::filesystem::path newWatermark;
+         if(!directoryQueue.empty()) {
+            newWatermark = directoryQueue.begin()->first;
+         }
+         if( (!busyDirectories.empty()) &&
+             ( (newWatermark.empty()) || (*busyDirectories.begin() < newWatermark) ) ) {
+            newWatermark = *busyDirectories.begin();
+         }
+         if(newWatermark != watermark) {
+            watermark = newWatermark;
+            setHoldBack(watermark);
+         }
+         queueNotification.notify_all();
+      }
+   };
+
+   const unsigned int threads = std::max(1U, std::min(8U, std::thread::hardware_concurrency()));
+   std::vector<std::thread> scannerThreads;
+   for(unsigned int i = 0; i < threads; i++) {
+      scannerThreads.push_back(std::thread(scanner));
+   }
+   for(std::thread& scannerThread : scannerThreads) {
+      scannerThread.join();
+   }
+
+   const std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+   HPCT_LOG(info) << "Found " << files << " files in " << directories << " directories ("
+                  << unchangedDirectories << " unchanged since the journal) in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << " ms";
+
+   // ====== Update the journal =============================================
+   writeJournal();
+   Journal.clear();
+   NewJournal.clear();
 }
 
 
@@ -337,18 +441,12 @@ unsigned long long UniversalImporter::lookForFiles(const std::filesystem::path&
                                                    const unsigned int           currentDepth,
                                                    const unsigned int           maxDepth)
 {
-   std::smatch match;
    unsigned long long n = 0;
    for(const std::filesystem::directory_entry& dirEntry : std::filesystem::directory_iterator(importFilePath)) {
 
       // ====== Filter name =================================================
-      // Optimisation: only check if there actually is a filter!
-      if(HasImportPathFilter) {
-         const std::string d = (dirEntry.path() / "").string();
-         if(!std::regex_match(d, match, ImportPathFilterRegEx)) {
-            HPCT_LOG(info) << "Skipping " << d;
-            continue;
-         }
+      if(!passesImportPathFilter(dirEntry.path())) {
+         continue;
       }
 
       // ====== Add file ====================================================
@@ -359,17 +457,7 @@ unsigned long long UniversalImporter::lookForFiles(const std::filesystem::path&
 
       // ====== Add directory ===============================================
       else if(dirEntry.is_directory()) {
-         // ------ Create INotify watch -------------------------------------
-         const int wd = inotify_add_watch(INotifyFD, dirEntry.path().c_str(),
-                                          IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_TO);
-         if(wd >= 0) {
-            INotifyWatchDescriptors.insert(boost::bimap<int, std::filesystem::path>::value_type(wd, dirEntry.path()));
-            addOrUpdateLastWriteTimePoint(dirEntry.path());
-         }
-         else {
-            HPCT_LOG(error) << "Adding INotify watch for " << dirEntry.path()
-                            << " failed: " << strerror(errno);
-         }
+         addDirectoryWatch(dirEntry.path());
 
          // ------ Recursive directory traversal ----------------------------
          if(currentDepth < maxDepth) {
@@ -382,14 +470,262 @@ unsigned long long UniversalImporter::lookForFiles(const std::filesystem::path&
 }
 
 
+// ###### Look for input files in one directory of the initial traversal ####
+unsigned long long UniversalImporter::scanDirectory(const std::filesystem::path& directory,
+                                                    const unsigned int           currentDepth,
+                                                    const unsigned int           maxDepth,
+                                                    std::list<std::pair<std::filesystem::path,
+                                                                        unsigned int>>& subDirectoryList,
+                                                    bool&                        unchanged)
+{
+   // ====== Get the directory's modification time ==========================
+   // NOTE: The modification time has to be obtained *before* reading the
+   //       directory. Any later change updates it.
+   const std::filesystem::file_time_type lastWrite = std::filesystem::last_write_time(directory);
+   const std::filesystem::file_time_type listTime  = std::filesystem::file_time_type::clock::now();
+   JournalDirectory                      entries;
+   entries.MTime = lastWrite.time_since_epoch().count();
+
+   // ====== Unchanged since the journal -> take its entries ================
+   std::map<std::filesystem::path, JournalDirectory>::const_iterator found =
+      Journal.find(directory);
+   if( (found != Journal.end()) && (found->second.MTime == entries.MTime) ) {
+      entries.Files          = found->second.Files;
+      entries.SubDirectories = found->second.SubDirectories;
+      unchanged = true;
+   }
+
+   // ====== Otherwise, read the directory ==================================
+   else {
+      for(const std::filesystem::directory_entry& dirEntry : std::filesystem::directory_iterator(directory)) {
+         if(dirEntry.is_regular_file()) {
+            entries.Files.push_back(dirEntry.path().filename().string());
+         }
+         else if(dirEntry.is_directory()) {
+            entries.SubDirectories.push_back(dirEntry.path().filename().string());
+         }
+      }
+      unchanged = false;
+   }
+
+   // ====== Add files ======================================================
+   unsigned long long n = 0;
+   for(const std::string& name : entries.Files) {
+      const std::filesystem::path dataFile = directory / name;
+      if(passesImportPathFilter(dataFile)) {
+         addFile(dataFile);
+         n++;
+      }
+   }
+
+   // ====== Add directories ================================================
+   for(const std::string& name : entries.SubDirectories) {
+      const std::filesystem::path subDirectory = directory / name;
+      if(passesImportPathFilter(subDirectory)) {
+         addDirectoryWatch(subDirectory);
+         if(currentDepth < maxDepth) {
+            subDirectoryList.push_back(std::pair<std::filesystem::path, unsigned int>(
+                                          subDirectory, currentDepth + 1));
+         }
+      }
+   }
+
+   // ====== Remember the entries for the journal ===========================
+   // Directories modified just before reading them are not journalled, since
+   // a further change within the timestamp granularity would go unnoticed.
+   if( (!ImporterConfig.getImportJournalFile().empty()) &&
+       (listTime - lastWrite >= std::chrono::seconds(2)) ) {
+      std::unique_lock lock(ScanMutex);
+      NewJournal.insert_or_assign(directory, std::move(entries));
+   }
+
+   return n;
+}
+
+
+// ###### Hold back files of the readers ####################################
+void UniversalImporter::setHoldBack(const std::filesystem::path& watermark)
+{
+   for(ReaderBase* reader : ReaderList) {
+      reader->setHoldBack(watermark);
+   }
+   for(std::map<const WorkerMapping, Worker*>::iterator workerMappingIterator = WorkerMap.begin();
+       workerMappingIterator != WorkerMap.end(); workerMappingIterator++) {
+      Worker* worker = workerMappingIterator->second;
+      worker->wakeUp();
+   }
+}
+
+
+// ###### Check import path filter ##########################################
+bool UniversalImporter::passesImportPathFilter(const std::filesystem::path& path) const
+{
+   // Optimisation: only check if there actually is a filter!
+   if(HasImportPathFilter) {
+      const std::string d = (path / "").string();
+      std::smatch       match;
+      if(!std::regex_match(d, match, ImportPathFilterRegEx)) {
+         HPCT_LOG(info) << "Skipping " << d;
+         return false;
+      }
+   }
+   return true;
+}
+
+
+// ###### Create INotify watch for directory ################################
+void UniversalImporter::addDirectoryWatch(const std::filesystem::path& directory)
+{
+   const int wd = inotify_add_watch(INotifyFD, directory.c_str(),
+                                    IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_TO);
+   if(wd >= 0) {
+      std::unique_lock lock(ScanMutex);
+      INotifyWatchDescriptors.insert(boost::bimap<int, std::filesystem::path>::value_type(wd, directory));
+      addOrUpdateLastWriteTimePoint(directory);
+   }
+   else {
+      HPCT_LOG(error) << "Adding INotify watch for " << directory
+                      << " failed: " << strerror(errno);
+   }
+}
+
+
+// ###### Read journal of the import directory ##############################
+bool UniversalImporter::readJournal()
+{
+   const std::filesystem::path& journalFile = ImporterConfig.getImportJournalFile();
+   Journal.clear();
+   if(journalFile.empty()) {
+      return false;
+   }
+
+   std::ifstream journalStream(journalFile);
+   if(!journalStream.good()) {
+      HPCT_LOG(info) << "No journal " << journalFile << " available";
+      return false;
+   }
+
+   // ====== Check header ===================================================
+   const std::filesystem::path& importFilePath = ImporterConfig.getImportFilePath();
+   std::string line;
+   if( (!std::getline(journalStream, line)) ||
+       (line != "#HPCT-Importer-Journal " + importFilePath.string()) ) {
+      HPCT_LOG(warning) << "Ignoring journal " << journalFile << " of another import directory";
+      return false;
+   }
+
+   // ====== Read directories ===============================================
+   JournalDirectory* journalDirectory = nullptr;
+   while(std::getline(journalStream, line)) {
+      if( (line.size() < 3) || (line[1] != ' ') ||
+          ( (line[0] != 'D') && (journalDirectory == nullptr) ) ) {
+         HPCT_LOG(warning) << "Ignoring bad journal " << journalFile;
+         Journal.clear();
+         return false;
+      }
+      const std::string_view value = std::string_view(line).substr(2);
+      switch(line[0]) {
+         case 'D': {
+               // ------ Directory: D <modification time> <relative path> ----
+               const size_t separator = value.find(' ');
+               long long    mtime;
+               if( (separator == std::string_view::npos) ||
+                   (parseNumber(value.substr(0, separator), mtime) != std::errc()) ) {
+                  HPCT_LOG(warning) << "Ignoring bad journal " << journalFile;
+                  Journal.clear();
+                  return false;
+               }
+               const std::string_view directory = value.substr(separator + 1);
+               journalDirectory = &Journal[(directory == ".") ? importFilePath :
+                                              importFilePath / directory];
+               journalDirectory->MTime = mtime;
+            }
+          break;
+         case 'F':
+            journalDirectory->Files.emplace_back(value);
+          break;
+         case 'S':
+            journalDirectory->SubDirectories.emplace_back(value);
+          break;
+         default:
+            HPCT_LOG(warning) << "Ignoring bad journal " << journalFile;
+            Journal.clear();
+            return false;
+          break;
+      }
+   }
+
+   HPCT_LOG(info) << "Read journal " << journalFile << " with "
+                  << Journal.size() << " directories";
+   return true;
+}
+
+
+// ###### Write journal of the import directory #############################
+bool UniversalImporter::writeJournal()
+{
+   const std::filesystem::path& journalFile = ImporterConfig.getImportJournalFile();
+   if(journalFile.empty()) {
+      return true;
+   }
+
+   // The journal is written into a temporary file first, which then replaces
+   // the old journal. So, there is never an incomplete journal.
+   const std::filesystem::path& importFilePath = ImporterConfig.getImportFilePath();
+   const std::filesystem::path  tempFile       = journalFile.string() + ".tmp";
+   try {
+      std::ofstream journalStream;
+      journalStream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+      journalStream.open(tempFile, std::ios::out | std::ios::trunc);
+      journalStream << "#HPCT-Importer-Journal " << importFilePath.string() << "\n";
+      for(const auto& [directory, entries] : NewJournal) {
+         const std::string relativePath = directory.lexically_relative(importFilePath).string();
+
+         // ------ Skip directories with newlines in names ------------------
+         bool hasNewline = (relativePath.find('\n') != std::string::npos);
+         for(const std::string& name : entries.Files) {
+            hasNewline |= (name.find('\n') != std::string::npos);
+         }
+         for(const std::string& name : entries.SubDirectories) {
+            hasNewline |= (name.find('\n') != std::string::npos);
+         }
+         if(hasNewline) {
+            continue;
+         }
+
+         // ------ Write directory and its entries --------------------------
+         journalStream << "D " << entries.MTime << " " << relativePath << "\n";
+         for(const std::string& name : entries.Files) {
+            journalStream << "F " << name << "\n";
+         }
+         for(const std::string& name : entries.SubDirectories) {
+            journalStream << "S " << name << "\n";
+         }
+      }
+      journalStream.close();
+      std::filesystem::rename(tempFile, journalFile);
+   }
+   catch(const std::exception& e) {
+      HPCT_LOG(warning) << "Unable to write journal " << journalFile << ": " << e.what();
+      std::error_code ec;
+      std::filesystem::remove(tempFile, ec);
+      return false;
+   }
+
+   HPCT_LOG(info) << "Wrote journal " << journalFile << " with "
+                  << NewJournal.size() << " directories";
+   return true;
+}
+
+
 // ###### Add input file ####################################################
 bool UniversalImporter::addFile(const std::filesystem::path& dataFile)
 {
    const std::string& filename = dataFile.filename().string();
-   std::smatch        match;
+   ResultsFileName    resultsFileName;
    for(ReaderBase* reader : ReaderList) {
-      if(std::regex_match(filename, match, reader->getFileNameRegExp())) {
-         const int worker = reader->addFile(dataFile, match);
+      if(reader->parseFileName(filename, resultsFileName)) {
+         const int worker = reader->addFile(dataFile, resultsFileName);
          if(worker >= 0) {
             WorkerMapping workerMapping;
             workerMapping.Reader   = reader;
@@ -398,6 +734,17 @@ bool UniversalImporter::addFile(const std::filesystem::path& dataFile)
             if(found != WorkerMap.end()) {
                Worker* worker = found->second;
                worker->wakeUp();
+
+               // ------ Busy worker -> let idle workers take over sources ---
+               if(reader->getBacklog(workerMapping.WorkerID) > 2 * reader->getMaxTransactionSize()) {
+                  for(unsigned int w = 0; w < reader->getWorkers(); w++) {
+                     workerMapping.WorkerID = w;
+                     found = WorkerMap.find(workerMapping);
+                     if(found != WorkerMap.end()) {
+                        found->second->wakeUp();
+                     }
+                  }
+               }
                return true;
             }
          }
@@ -411,10 +758,10 @@ bool UniversalImporter::addFile(const std::filesystem::path& dataFile)
 bool UniversalImporter::removeFile(const std::filesystem::path& dataFile)
 {
    const std::string& filename = dataFile.filename().string();
-   std::smatch        match;
+   ResultsFileName    resultsFileName;
    for(ReaderBase* reader : ReaderList) {
-      if(std::regex_match(filename, match, reader->getFileNameRegExp())) {
-         if(reader->removeFile(dataFile, match)) {
+      if(reader->parseFileName(filename, resultsFileName)) {
+         if(reader->removeFile(dataFile, resultsFileName)) {
             return true;
          }
          break;
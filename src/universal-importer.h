@@ -37,6 +37,9 @@
 #include <boost/asio.hpp>
 #include <boost/bimap.hpp>
 
+#include <mutex>
+#include <regex>
+
 #include <sys/inotify.h>
 
 
@@ -71,6 +74,17 @@ class UniversalImporter
    unsigned long long lookForFiles(const std::filesystem::path& importFilePath,
                                    const unsigned int           currentDepth,
                                    const unsigned int           maxDepth);
+   unsigned long long scanDirectory(const std::filesystem::path& directory,
+                                    const unsigned int           currentDepth,
+                                    const unsigned int           maxDepth,
+                                    std::list<std::pair<std::filesystem::path,
+                                                        unsigned int>>& subDirectoryList,
+                                    bool&                        unchanged);
+   void setHoldBack(const std::filesystem::path& watermark);
+   bool passesImportPathFilter(const std::filesystem::path& path) const;
+   void addDirectoryWatch(const std::filesystem::path& directory);
+   bool readJournal();
+   bool writeJournal();
    bool addFile(const std::filesystem::path& dataFile);
    bool removeFile(const std::filesystem::path& dataFile);
    void handleStatusTimer(const boost::system::error_code& errorCode);
@@ -83,6 +97,19 @@ class UniversalImporter
    void performDirectoryCleanUp();
    void handleGarbageCollectionTimer(const boost::system::error_code& errorCode);
 
+   // ====== Journal of the import directory ================================
+   // For each directory listed by the initial traversal, the journal
+   // contains its modification time and its entries. On restart, directories
+   // with unchanged modification time do not need to be read again.
+   // The journal is only written after the initial traversal, i.e. it is a
+   // startup cache. Later changes update the modification times, so that
+   // the changed directories are read again on the next restart.
+   struct JournalDirectory {
+      long long                MTime;
+      std::vector<std::string> Files;
+      std::vector<std::string> SubDirectories;
+   };
+
    struct WorkerMapping {
       ReaderBase*  Reader;
       unsigned int WorkerID;
@@ -111,6 +138,12 @@ class UniversalImporter
             SystemTimePoint>                INotifyWatchLastWrite;
    boost::asio::posix::stream_descriptor    INotifyStream;
    char                                     INotifyEventBuffer[65536 * sizeof(inotify_event)];
+
+   std::mutex                               ScanMutex;   // Initial traversal threads
+   std::map<std::filesystem::path,
+            JournalDirectory>               Journal;
+   std::map<std::filesystem::path,
+            JournalDirectory>               NewJournal;
 };
 
 #endif
@@ -31,8 +31,16 @@
 #include "database-configuration.h"
 #include "inputstream.h"
 #include "logger.h"
+#include "resultsarchive.h"
+#include "resultsindex.h"
 #include "tools.h"
 
+#include <algorithm>
+#include <set>
+
+#include <boost/format.hpp>
+#include <boost/iostreams/device/array.hpp>
+
 
 // ###### Constructor #######################################################
 Worker::Worker(const unsigned int           workerID,
@@ -48,6 +56,10 @@ Worker::Worker(const unsigned int           workerID,
      Identification(Reader.getIdentification() + "/" + std::to_string(WorkerID))
 {
    StopRequested.exchange(false);
+   PrefetchedBytes = 0;
+   PrefetchStop    = false;
+   WakeUpPending   = false;
+   QuitWhenIdle    = false;
 }
 
 
@@ -63,7 +75,8 @@ Worker::~Worker()
 void Worker::start(const bool quitWhenIdle)
 {
    StopRequested.exchange(false);
-   QuitWhenIdle = quitWhenIdle;
+   WakeUpPending = false;
+   QuitWhenIdle  = quitWhenIdle;
    Thread = std::thread(&Worker::run, this);
 }
 
@@ -82,6 +95,9 @@ void Worker::requestStop()
 {
    StopRequested.exchange(true);
    wakeUp();
+
+   std::unique_lock lock(PrefetchMutex);
+   PrefetchNotification.notify_all();
 }
 
 
@@ -89,10 +105,19 @@ void Worker::requestStop()
 void Worker::wakeUp()
 {
    std::unique_lock lock(Mutex);
+   WakeUpPending = true;
    Notification.notify_one();
 }
 
 
+// ###### Set whether to quit when idle #####################################
+void Worker::setQuitWhenIdle(const bool quitWhenIdle)
+{
+   QuitWhenIdle = quitWhenIdle;
+   wakeUp();
+}
+
+
 // ###### Get list of input files ###########################################
 void Worker::processFile(DatabaseClientBase&          databaseClient,
                          unsigned long long&          rows,
@@ -107,6 +132,33 @@ void Worker::processFile(DatabaseClientBase&          databaseClient,
    }
 
    else {
+      // ====== Skip file without records, according to its index ==========
+      ResultsIndex index;
+      if(index.readIndex(ResultsIndex::getIndexFileName(dataFile))) {
+         if(index.records() == 0) {
+            HPCT_LOG(debug) << getIdentification() << ": Skipping input file "
+                            << relativeTo(dataFile, ImporterConfig.getImportFilePath())
+                            << " without records";
+            return;
+         }
+
+         // ------ Add index to the totals of its source ---------------------
+         const std::string& filename = dataFile.filename().string();
+         ResultsFileName    resultsFileName;
+         if(Reader.parseFileName(filename, resultsFileName)) {
+            TransactionIndexes[std::string(resultsFileName.Source)].merge(index);
+         }
+      }
+
+      // ====== Use already decompressed contents, if available ============
+      std::string contents;
+      if(takePrefetchedFile(dataFile, contents)) {
+         boost::iostreams::filtering_istream inputStream;
+         inputStream.push(boost::iostreams::array_source(contents.data(), contents.size()));
+         Reader.parseContents(databaseClient, rows, dataFile, inputStream);
+         return;
+      }
+
       // ====== Open input stream ===========================================
       InputStream inputStream;
       try {
@@ -129,6 +181,8 @@ void Worker::deleteImportedFile(const std::filesystem::path& dataFile)
 {
    try {
       std::filesystem::remove(dataFile);
+      std::error_code ec;
+      std::filesystem::remove(ResultsIndex::getIndexFileName(dataFile), ec);
       HPCT_LOG(trace) << getIdentification() << ": Deleted imported file "
                       << relativeTo(dataFile, ImporterConfig.getImportFilePath());
    }
@@ -141,19 +195,23 @@ void Worker::deleteImportedFile(const std::filesystem::path& dataFile)
 
 // ###### Move successfully imported file to good or bad files ##############
 void Worker::moveImportedFile(const std::filesystem::path& dataFile,
-                              const std::smatch            match,
+                              const ResultsFileName&       resultsFileName,
                               const bool                   isGood)
 {
    // ====== Construct destination path =====================================
    if(subDirectoryOf(dataFile, ImporterConfig.getImportFilePath()) > 0) {
       const std::filesystem::path targetPath =
          ((isGood == true) ? ImporterConfig.getGoodFilePath() : ImporterConfig.getBadFilePath()) /
-         Reader.getDirectoryHierarchy(dataFile, match);
+         Reader.getDirectoryHierarchy(dataFile, resultsFileName);
 
       // ====== Create destination directory and move file =====================
       try {
          std::filesystem::create_directories(targetPath);
          std::filesystem::rename(dataFile, targetPath / dataFile.filename());
+         const std::filesystem::path indexFile = ResultsIndex::getIndexFileName(dataFile);
+         if(std::filesystem::exists(indexFile)) {
+            std::filesystem::rename(indexFile, targetPath / indexFile.filename());
+         }
          HPCT_LOG(debug) << getIdentification() << ": Moved " << ((isGood == true) ? "good" : "bad") <<  " file "
                          << relativeTo(dataFile, ImporterConfig.getImportFilePath());
       }
@@ -171,14 +229,49 @@ void Worker::moveImportedFile(const std::filesystem::path& dataFile,
 }
 
 
+// ###### Append successfully imported file to archive #####################
+void Worker::compactImportedFile(const std::filesystem::path& dataFile,
+                                 const ResultsFileName&       resultsFileName)
+{
+   // ====== Construct archive path =========================================
+   if(subDirectoryOf(dataFile, ImporterConfig.getImportFilePath()) > 0) {
+      const std::filesystem::path archiveFile =
+         ImporterConfig.getGoodFilePath() / Reader.getArchiveFile(dataFile, resultsFileName);
+
+      // ====== Create archive directory and append file ====================
+      try {
+         std::filesystem::create_directories(archiveFile.parent_path());
+         ResultsArchive::appendFile(archiveFile, dataFile);
+         HPCT_LOG(debug) << getIdentification() << ": Appended good file "
+                         << relativeTo(dataFile, ImporterConfig.getImportFilePath())
+                         << " to archive "
+                         << relativeTo(archiveFile, ImporterConfig.getGoodFilePath());
+         deleteImportedFile(dataFile);
+      }
+      catch(std::exception& e) {
+         // The archive is unchanged => just move the file instead.
+         HPCT_LOG(warning) << getIdentification() << ": Archiving good file "
+                           << relativeTo(dataFile, ImporterConfig.getImportFilePath())
+                           << " failed: " << e.what();
+         moveImportedFile(dataFile, resultsFileName, true);
+      }
+   }
+   else {
+      HPCT_LOG(error) << getIdentification() << ": "
+                      << dataFile << " is not in a sub-directory of the import path "
+                      << ImporterConfig.getImportFilePath();
+   }
+}
+
+
 // ###### Delete finished input file ########################################
 void Worker::finishedFile(const std::filesystem::path& dataFile,
                           const bool                   success)
 {
    // Need to extract the file name parts again, in order to find the entry:
    const std::string& filename = dataFile.filename().string();
-   std::smatch        match;
-   const bool         isMatching = std::regex_match(filename, match, Reader.getFileNameRegExp());
+   ResultsFileName    resultsFileName;
+   const bool         isMatching = Reader.parseFileName(filename, resultsFileName);
    assert(isMatching);
 
    // ====== File has been imported successfully ============================
@@ -189,7 +282,11 @@ void Worker::finishedFile(const std::filesystem::path& dataFile,
       }
       // ------ Move imported file ------------------------------------------
       else if(ImporterConfig.getImportMode() == ImportModeType::MoveImportedFiles) {
-         moveImportedFile(dataFile, match, true);
+         moveImportedFile(dataFile, resultsFileName, true);
+      }
+      // ------ Append imported file to archive -----------------------------
+      else if(ImporterConfig.getImportMode() == ImportModeType::CompactImportedFiles) {
+         compactImportedFile(dataFile, resultsFileName);
       }
       // ------ Keep imported file where it is ------------------------------
       else  if(ImporterConfig.getImportMode() == ImportModeType::KeepImportedFiles) {
@@ -198,30 +295,177 @@ void Worker::finishedFile(const std::filesystem::path& dataFile,
    }
    // ====== File is bad ====================================================
    else {
-      moveImportedFile(dataFile, match, false);
+      moveImportedFile(dataFile, resultsFileName, false);
    }
 
    // ====== Remove file from the reader ====================================
-   const bool fileRemoved = Reader.removeFile(dataFile, match);
+   const bool fileRemoved = Reader.removeFile(dataFile, resultsFileName);
    assert(fileRemoved);
 }
 
 
+// ###### Fetch files for the next transaction ##############################
+unsigned int Worker::fetchFiles(std::list<std::filesystem::path>& dataFileList)
+{
+   // ====== Fetch files of this and the next transaction ===================
+   // The files of the next transaction are only handed to the prefetcher.
+   // They remain in the reader, i.e. the order of the imports is still
+   // defined by the reader.
+   std::list<std::filesystem::path> candidateList;
+   Reader.fetchFiles(candidateList, WorkerID, 2 * Reader.getMaxTransactionSize());
+   prefetchFiles(candidateList);
+
+   dataFileList.clear();
+   for(const std::filesystem::path& dataFile : candidateList) {
+      if(dataFileList.size() >= Reader.getMaxTransactionSize()) {
+         break;
+      }
+      dataFileList.push_back(dataFile);
+   }
+   return dataFileList.size();
+}
+
+
+// ###### Hand files over to the prefetcher #################################
+void Worker::prefetchFiles(const std::list<std::filesystem::path>& dataFileList)
+{
+   std::unique_lock lock(PrefetchMutex);
+
+   // ====== Drop files that are not needed any more ========================
+   std::set<std::filesystem::path> needed(dataFileList.begin(), dataFileList.end());
+   for(auto iterator = PrefetchedFiles.begin(); iterator != PrefetchedFiles.end(); ) {
+      if( (iterator->second.Ready) && (needed.find(iterator->first) == needed.end()) ) {
+         PrefetchedBytes -= iterator->second.Contents.size();
+         iterator = PrefetchedFiles.erase(iterator);
+      }
+      else {
+         iterator++;
+      }
+   }
+   PrefetchQueue.clear();
+
+   // ====== Queue files in import order ====================================
+   for(const std::filesystem::path& dataFile : dataFileList) {
+      if(PrefetchedFiles.find(dataFile) == PrefetchedFiles.end()) {
+         PrefetchQueue.push_back(dataFile);
+      }
+   }
+   PrefetchNotification.notify_all();
+}
+
+
+// ###### Take decompressed contents of a file from the prefetcher ##########
+bool Worker::takePrefetchedFile(const std::filesystem::path& dataFile,
+                                std::string&                 contents)
+{
+   std::unique_lock lock(PrefetchMutex);
+
+   std::map<std::filesystem::path, PrefetchedFile>::iterator found = PrefetchedFiles.find(dataFile);
+   if(found == PrefetchedFiles.end()) {
+      // Not decompressed yet -> the worker thread handles it directly:
+      std::deque<std::filesystem::path>::iterator queued =
+         std::find(PrefetchQueue.begin(), PrefetchQueue.end(), dataFile);
+      if(queued != PrefetchQueue.end()) {
+         PrefetchQueue.erase(queued);
+      }
+      return false;
+   }
+
+   // ====== Wait until the decompression in progress is finished ===========
+   PrefetchNotification.wait(lock, [&]() { return found->second.Ready; });
+
+   // ====== Take the contents ==============================================
+   // NOTE: If the prefetcher failed, the worker thread processes the file
+   //       again, with the usual error handling.
+   const bool success = !found->second.Failed;
+   if(success) {
+      contents.swap(found->second.Contents);
+      PrefetchedBytes -= contents.size();
+   }
+   PrefetchedFiles.erase(found);
+   PrefetchNotification.notify_all();
+   return success;
+}
+
+
+// ###### Prefetcher loop ###################################################
+void Worker::runPrefetcher()
+{
+   // NOTE: The prefetcher must only finish on PrefetchStop, which is set
+   //       after the worker loop has ended. Until then, the worker thread
+   //       may still wait for a file in progress in takePrefetchedFile().
+   //       On StopRequested, just no further files are started.
+   std::unique_lock lock(PrefetchMutex);
+   while(true) {
+      PrefetchNotification.wait(lock, [&]() {
+         return (PrefetchStop) ||
+                ( (!StopRequested) &&
+                  (!PrefetchQueue.empty()) && (PrefetchedBytes < PrefetchMaxBytes) );
+      });
+      if(PrefetchStop) {
+         break;
+      }
+
+      // ====== Decompress next file ========================================
+      const std::filesystem::path dataFile = PrefetchQueue.front();
+      PrefetchQueue.pop_front();
+      PrefetchedFile& prefetchedFile = PrefetchedFiles[dataFile];
+      prefetchedFile.Ready  = false;
+      prefetchedFile.Failed = false;
+      lock.unlock();
+
+      std::string contents;
+      bool        failed = false;
+      try {
+         InputStream inputStream;
+         inputStream.openStream(dataFile);
+         char buffer[65536];
+         while( (inputStream.read(buffer, sizeof(buffer))) || (inputStream.gcount() > 0) ) {
+            contents.append(buffer, inputStream.gcount());
+         }
+         failed = inputStream.bad();
+      }
+      catch(std::exception& e) {
+         failed = true;
+      }
+
+      // ====== Hand over the contents ======================================
+      lock.lock();
+      prefetchedFile.Ready  = true;
+      prefetchedFile.Failed = failed;
+      if(!failed) {
+         prefetchedFile.Contents.swap(contents);
+         PrefetchedBytes += prefetchedFile.Contents.size();
+      }
+      PrefetchNotification.notify_all();
+   }
+
+   PrefetchQueue.clear();
+   PrefetchedFiles.clear();
+   PrefetchedBytes = 0;
+}
+
+
 // ###### Import list of files ##############################################
-bool Worker::importFiles(const std::list<std::filesystem::path>& dataFileList)
+// The files are imported in one transaction. On error, the transaction is
+// rolled back, and the result tells how to recover. If the bad file is
+// known (reader or decompression error), it is returned in badFile.
+Worker::ImportResult Worker::importFiles(const std::list<std::filesystem::path>& dataFileList,
+                                         std::filesystem::path&                  badFile)
 {
-   const bool fastMode = (dataFileList.size() > 1);
-   if(fastMode) {
+   if(dataFileList.size() > 1) {
       HPCT_LOG(debug) << getIdentification() << ": Trying to import "
-                      << dataFileList.size() << " files in "
-                      << ((fastMode == true) ? "fast" : "slow") << " mode ...";
+                      << dataFileList.size() << " files ...";
    }
    // for(const std::filesystem::path& d : dataFileList) {
    //    std::cout << "- " << d << "\n";
    // }
 
-   unsigned long long rows = 0;
+   unsigned long long    rows = 0;
    std::filesystem::path dataFile;
+   ImportResult          result;
+   badFile.clear();
+   TransactionIndexes.clear();
    try {
       // ====== Import multiple input files in one transaction ========
       DatabaseClient.startTransaction();
@@ -230,15 +474,21 @@ bool Worker::importFiles(const std::list<std::filesystem::path>& dataFileList)
           iterator != dataFileList.end(); iterator++) {
          dataFile = std::filesystem::path(*iterator);
          if(StopRequested) {
-            break;
+            // Do not commit an incomplete transaction!
+            DatabaseClient.rollback();
+            return ImportStopped;
          }
          HPCT_LOG(trace) << getIdentification() << ": Parsing "
                          << relativeTo(dataFile, ImporterConfig.getImportFilePath()) << " ...";
          processFile(DatabaseClient, rows, dataFile);
       }
+      dataFile.clear();
       if(Reader.finishParsing(DatabaseClient, rows)) {
          DatabaseClient.commit();
          HPCT_LOG(debug) << getIdentification() << ": Committed " << rows << " rows";
+         for(const auto& transactionIndex : TransactionIndexes) {
+            ImportedIndexes[transactionIndex.first].merge(transactionIndex.second);
+         }
       }
       else {
          DatabaseClient.rollback();
@@ -250,113 +500,195 @@ bool Worker::importFiles(const std::list<std::filesystem::path>& dataFileList)
       for(const std::filesystem::path& dataFile : dataFileList) {
          finishedFile(dataFile);
       }
-      return true;
+      return ImportSuccess;
    }
 
    //  ====== Error in input data ===========================================
    // NOTE: The database connection is still okay!
    catch(ResultsReaderDataErrorException& exception) {
-      HPCT_LOG(warning) << getIdentification() << ": Import in "
-                        << ((fastMode == true) ? "fast" : "slow") << " mode failed with reader data error: "
+      HPCT_LOG(warning) << getIdentification() << ": Import of "
+                        << dataFileList.size() << " files failed with reader data error: "
                         << exception.what();
-      try {
-         DatabaseClient.rollback();
-         if( (!fastMode) && (!dataFile.empty()) ) {
-            finishedFile(dataFile, false);
-         }
-         return false;
-      }
-      catch(ResultsDatabaseException& exception) {
-         // Now, the database connection is broken -> reconnect.
-      }
+      badFile = dataFile;
+      result  = ImportDataError;
+   }
+
+   //  ====== Data already in database ======================================
+   // NOTE: The database connection is still okay!
+   catch(ResultsDatabaseDuplicateKeyException& exception) {
+      HPCT_LOG(warning) << getIdentification() << ": Import of "
+                        << dataFileList.size() << " files failed with duplicate key: "
+                        << exception.what();
+      result = ImportDuplicateKey;
    }
 
    //  ====== Error in database data ========================================
    // NOTE: The database connection is still okay!
    catch(ResultsDatabaseDataErrorException& exception) {
-      HPCT_LOG(warning) << getIdentification() << ": Import in "
-                        << ((fastMode == true) ? "fast" : "slow") << " mode failed with database data error: "
+      HPCT_LOG(warning) << getIdentification() << ": Import of "
+                        << dataFileList.size() << " files failed with database data error: "
                         << exception.what();
-      try {
-         DatabaseClient.rollback();
-         if(!fastMode) {
-            finishedFile(dataFile, false);
-         }
-         return false;
-      }
-      catch(ResultsDatabaseException& exception) {
-         // Now, the database connection is broken -> reconnect.
-      }
+      result = ImportDataError;
+   }
+
+   //  ====== Temporary database problem ====================================
+   // NOTE: The database connection is still okay!
+   catch(ResultsDatabaseTransientErrorException& exception) {
+      HPCT_LOG(warning) << getIdentification() << ": Import of "
+                        << dataFileList.size() << " files failed with transient database error: "
+                        << exception.what();
+      result = ImportTransientError;
    }
 
    //  ====== Error in database handling ====================================
    // NOTE: Requires reconnect to database!
    catch(ResultsDatabaseException& exception) {
-      HPCT_LOG(warning) << getIdentification() << ": Import in "
-                        << ((fastMode == true) ? "fast" : "slow") << " mode failed with database exception: "
+      HPCT_LOG(warning) << getIdentification() << ": Import of "
+                        << dataFileList.size() << " files failed with database exception: "
                         << exception.what();
-      // The database connection is broken -> reconnect.
+      return ImportConnectionError;
    }
 
    //  ====== Other error (e.g. decompression) ==============================
    // NOTE: The database connection is still okay!
    catch(std::exception& exception) {
-      HPCT_LOG(warning) << getIdentification() << ": Import in "
-                        << ((fastMode == true) ? "fast" : "slow") << " mode failed with generic error: "
+      HPCT_LOG(warning) << getIdentification() << ": Import of "
+                        << dataFileList.size() << " files failed with generic error: "
                         << exception.what();
-      try {
-         DatabaseClient.rollback();
-         if(!fastMode) {
-            finishedFile(dataFile, false);
+      badFile = dataFile;
+      result  = ImportDataError;
+   }
+
+   // ====== Roll back ======================================================
+   try {
+      DatabaseClient.rollback();
+   }
+   catch(ResultsDatabaseException& exception) {
+      // Now, the database connection is broken -> reconnect.
+      return ImportConnectionError;
+   }
+   return result;
+}
+
+
+// ###### Import list of files, with recovery from errors ###################
+// Bad files are isolated by bisection: each half of the list is imported
+// separately, until the bad files are found. So, a single bad file costs
+// O(log n) additional transactions, instead of one transaction per file.
+void Worker::importFilesWithRecovery(const std::list<std::filesystem::path>& dataFileList)
+{
+   std::list<std::filesystem::path> remainingFileList(dataFileList);
+   unsigned int                     transientErrors = 0;
+   while( (!remainingFileList.empty()) && (!StopRequested) ) {
+      std::filesystem::path badFile;
+      const ImportResult    result = importFiles(remainingFileList, badFile);
+      switch(result) {
+         case ImportSuccess:
+         case ImportStopped:
+            return;
+         // ====== Transient error -> retry the same files ==================
+         case ImportTransientError:
+            if(++transientErrors < MaxTransientErrors) {
+               continue;
+            }
+            // Still failing -> handle like a broken connection.
+            transientErrors = 0;
+            if(!StopRequested) {
+               reconnect();
+            }
+            continue;
+         case ImportConnectionError:
+            if(!StopRequested) {
+               reconnect();
+            }
+            continue;
+         default:
+          break;
+      }
+
+      // ====== Single file -> isolated =====================================
+      if(remainingFileList.size() == 1) {
+         if(result == ImportDuplicateKey) {
+            // Some data of this file is already in the database, e.g. after
+            // an interrupted run of the importer. With transactions, the
+            // other rows of the file have been rolled back. Without
+            // transactions (MongoDB), some of them may have been inserted.
+            // So, the file has to be checked manually.
+            HPCT_LOG(warning) << getIdentification() << ": Data of file "
+                              << relativeTo(remainingFileList.front(), ImporterConfig.getImportFilePath())
+                              << " is partially in the database already";
          }
-         return false;
+         finishedFile(remainingFileList.front(), false);
+         return;
       }
-      catch(ResultsDatabaseException& exception) {
-         // Now, the database connection is broken -> reconnect.
+
+      // ====== Known bad file -> remove it, and retry the others ===========
+      if(!badFile.empty()) {
+         finishedFile(badFile, false);
+         remainingFileList.remove(badFile);
+         continue;
       }
+
+      // ====== Bisection ===================================================
+      std::list<std::filesystem::path> firstHalf;
+      std::list<std::filesystem::path>::iterator middle = remainingFileList.begin();
+      std::advance(middle, remainingFileList.size() / 2);
+      firstHalf.splice(firstHalf.begin(), remainingFileList,
+                       remainingFileList.begin(), middle);
+      HPCT_LOG(debug) << getIdentification() << ": Bisecting into "
+                      << firstHalf.size() << " + " << remainingFileList.size() << " files ...";
+      importFilesWithRecovery(firstHalf);
+      transientErrors = 0;
    }
+}
+
+
+// ###### Report indexed totals per source ##################################
+// The totals are taken from the index files of the committed files. Files
+// without index file are not included.
+void Worker::reportImportedIndexes()
+{
+   for(const auto& importedIndex : ImportedIndexes) {
+      const ResultsIndex& index = importedIndex.second;
+      HPCT_LOG(info) << getIdentification() << ": Imported "
+                     << index.records() << " indexed records from source "
+                     << importedIndex.first << ", time stamps "
+                     << str(boost::format("%x") % index.firstTimeStamp()) << " - "
+                     << str(boost::format("%x") % index.lastTimeStamp());
+   }
+   ImportedIndexes.clear();
+}
+
 
-   // ====== Reconnect ======================================================
+// ###### Wait and reconnect to database ####################################
+void Worker::reconnect()
+{
    HPCT_LOG(warning) << getIdentification() << ": Waiting " << DatabaseConfig.getReconnectDelay() << " ...";
    std::this_thread::sleep_for(std::chrono::seconds(DatabaseConfig.getReconnectDelay()));
    HPCT_LOG(warning) << getIdentification() << ": Trying reconnect ...";
    DatabaseClient.reconnect();
-
-   return false;
 }
 
 
 // ###### Worker loop #######################################################
 void Worker::run()
 {
+   // ====== Start decompression stage ======================================
+   PrefetchStop   = false;
+   PrefetchThread = std::thread(&Worker::runPrefetcher, this);
+
    while(!StopRequested) {
       // ====== Look for new input files ====================================
       HPCT_LOG(trace) << getIdentification() << ": Processing new input files ...";
 
-      // ====== Fast import: try to combine files ===========================
+      // ====== Import files, combined into transactions ====================
       std::list<std::filesystem::path> dataFileList;
-      unsigned int files = Reader.fetchFiles(dataFileList, WorkerID, Reader.getMaxTransactionSize());
+      unsigned int files = fetchFiles(dataFileList);
       while( (files > 0) && (!StopRequested) ) {
-         // ====== Fast Mode ================================================
-         if(!importFiles(dataFileList)) {
-
-            // ====== Slow Mode =============================================
-            if(files > 1) {
-               HPCT_LOG(debug) << getIdentification() << ": Trying to import "
-                               << dataFileList.size() << " files in slow mode ...";
-               for(const std::filesystem::path& dataFile : dataFileList) {
-                  std::list<std::filesystem::path> singleFileList;
-                  if(StopRequested) {
-                     break;
-                  }
-                  singleFileList.push_back(dataFile);
-                  assert(singleFileList.size() == 1);
-                  importFiles(singleFileList);
-               }
-            }
-         }
-         files = Reader.fetchFiles(dataFileList, WorkerID, Reader.getMaxTransactionSize());
+         importFilesWithRecovery(dataFileList);
+         files = fetchFiles(dataFileList);
       }
+      reportImportedIndexes();
 
       // ====== Quit when idle? =============================================
       if( (files == 0) && (QuitWhenIdle) ) {
@@ -368,9 +700,19 @@ void Worker::run()
       if(!StopRequested) {
          std::unique_lock lock(Mutex);
          HPCT_LOG(trace) << getIdentification() << ": Sleeping ...";
-         Notification.wait(lock);
+         Notification.wait(lock, [&]() { return WakeUpPending || StopRequested; });
+         WakeUpPending = false;
          HPCT_LOG(trace) << getIdentification() << ": Wakeup!";
       }
    }
+
+   // ====== Stop decompression stage =======================================
+   {
+      std::unique_lock lock(PrefetchMutex);
+      PrefetchStop = true;
+      PrefetchNotification.notify_all();
+   }
+   PrefetchThread.join();
+
    HPCT_LOG(trace) << getIdentification() << ": Finished";
 }
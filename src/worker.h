@@ -33,10 +33,14 @@
 #include "databaseclient-base.h"
 #include "importer-configuration.h"
 #include "reader-base.h"
+#include "resultsindex.h"
 
 #include <atomic>
-#include <thread>
 #include <condition_variable>
+#include <deque>
+#include <map>
+#include <string>
+#include <thread>
 
 
 class Worker
@@ -53,6 +57,7 @@ class Worker
    void join();
    void requestStop();
    void wakeUp();
+   void setQuitWhenIdle(const bool quitWhenIdle);
 
    inline const std::string& getIdentification() const { return Identification; }
 
@@ -65,12 +70,54 @@ class Worker
                      const bool                   success = true);
    void deleteImportedFile(const std::filesystem::path& dataFile);
    void moveImportedFile(const std::filesystem::path& dataFile,
-                         const std::smatch            match,
+                         const ResultsFileName&       resultsFileName,
                          const bool                   isGood);
+   void compactImportedFile(const std::filesystem::path& dataFile,
+                            const ResultsFileName&       resultsFileName);
 
-   bool importFiles(const std::list<std::filesystem::path>& dataFileList);
+   unsigned int fetchFiles(std::list<std::filesystem::path>& dataFileList);
+   void prefetchFiles(const std::list<std::filesystem::path>& dataFileList);
+   bool takePrefetchedFile(const std::filesystem::path& dataFile,
+                           std::string&                 contents);
+   enum ImportResult {
+      ImportSuccess         = 0,
+      ImportStopped         = 1,   // Stop requested, nothing committed
+      ImportDataError       = 2,   // Bad input data -> isolate bad files
+      ImportDuplicateKey    = 3,   // Data already in database -> isolate bad files
+      ImportTransientError  = 4,   // Deadlock, etc. -> retry the same files
+      ImportConnectionError = 5    // Broken connection -> reconnect and retry
+   };
+   static const unsigned int MaxTransientErrors = 3;
+   ImportResult importFiles(const std::list<std::filesystem::path>& dataFileList,
+                            std::filesystem::path&                  badFile);
+   void importFilesWithRecovery(const std::list<std::filesystem::path>& dataFileList);
+   void reportImportedIndexes();
+   void reconnect();
+   void runPrefetcher();
    void run();
 
+   // ====== Decompression stage ============================================
+   // The prefetcher thread decompresses the files of the current and the
+   // next transaction into memory, while the worker thread parses and
+   // loads the data into the database.
+   struct PrefetchedFile {
+      bool        Ready;
+      bool        Failed;
+      std::string Contents;
+   };
+   static const size_t                             PrefetchMaxBytes = 64 * 1024 * 1024;
+   std::thread                                     PrefetchThread;
+   std::mutex                                      PrefetchMutex;
+   std::condition_variable                         PrefetchNotification;
+   std::deque<std::filesystem::path>               PrefetchQueue;
+   std::map<std::filesystem::path, PrefetchedFile> PrefetchedFiles;
+   size_t                                          PrefetchedBytes;
+   bool                                            PrefetchStop;
+
+   // ====== Indexed totals per source ======================================
+   std::map<std::string, ResultsIndex>             TransactionIndexes;   // Files of current transaction
+   std::map<std::string, ResultsIndex>             ImportedIndexes;      // Files of committed transactions
+
    std::atomic<bool>            StopRequested;
    const unsigned int           WorkerID;
    ReaderBase&                  Reader;
@@ -81,7 +128,8 @@ class Worker
    std::thread                  Thread;
    std::mutex                   Mutex;
    std::condition_variable      Notification;
-   bool                         QuitWhenIdle;
+   bool                         WakeUpPending;
+   std::atomic<bool>            QuitWhenIdle;
 };
 
 #endif
@@ -0,0 +1,180 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#include "zstddictionary.h"
+#include "logger.h"
+
+#include <fstream>
+#include <iterator>
+
+#include <zdict.h>
+
+
+std::mutex                                              ZSTDDictionary::RegistryMutex;
+std::map<unsigned int, std::unique_ptr<ZSTDDictionary>> ZSTDDictionary::Registry;
+
+
+// ###### Constructor #######################################################
+ZSTDDictionary::ZSTDDictionary(const std::filesystem::path& fileName,
+                               const int                    compressionLevel)
+   : FileName(fileName),
+     CompressionLevel(compressionLevel)
+{
+   std::ifstream is(FileName, std::ios::binary);
+   if(!is.good()) {
+      throw std::runtime_error("Unable to read ZSTD dictionary " + FileName.string());
+   }
+   Content.assign((std::istreambuf_iterator<char>(is)),
+                  std::istreambuf_iterator<char>());
+
+   ID = ZSTD_getDictID_fromDict(Content.data(), Content.size());
+   if(ID == 0) {
+      throw std::runtime_error("ZSTD dictionary " + FileName.string() + " has no dictionary ID");
+   }
+   CompressionDictionary   = ZSTD_createCDict(Content.data(), Content.size(),
+                                              CompressionLevel);
+   DecompressionDictionary = ZSTD_createDDict(Content.data(), Content.size());
+   if( (CompressionDictionary == nullptr) || (DecompressionDictionary == nullptr) ) {
+      ZSTD_freeCDict(CompressionDictionary);
+      ZSTD_freeDDict(DecompressionDictionary);
+      throw std::runtime_error("Invalid ZSTD dictionary " + FileName.string());
+   }
+}
+
+
+// ###### Destructor ########################################################
+ZSTDDictionary::~ZSTDDictionary()
+{
+   ZSTD_freeCDict(CompressionDictionary);
+   ZSTD_freeDDict(DecompressionDictionary);
+   for(std::pair<const int, ZSTD_CDict*>& levelDictionary : LevelDictionaries) {
+      ZSTD_freeCDict(levelDictionary.second);
+   }
+}
+
+
+// ###### Get digested dictionary for compression level #####################
+// The compression level of a ZSTD_CDict is fixed, i.e. each further level
+// needs its own one. A level of 0 selects the dictionary's default level.
+const ZSTD_CDict* ZSTDDictionary::compressionDictionary(const int compressionLevel) const
+{
+   if( (compressionLevel == 0) || (compressionLevel == CompressionLevel) ) {
+      return CompressionDictionary;
+   }
+
+   std::lock_guard<std::mutex> lock(LevelMutex);
+   std::map<int, ZSTD_CDict*>::const_iterator found = LevelDictionaries.find(compressionLevel);
+   if(found != LevelDictionaries.end()) {
+      return found->second;
+   }
+   ZSTD_CDict* levelDictionary = ZSTD_createCDict(Content.data(), Content.size(),
+                                                  compressionLevel);
+   if(levelDictionary == nullptr) {
+      throw std::bad_alloc();
+   }
+   LevelDictionaries.insert(std::pair<int, ZSTD_CDict*>(compressionLevel, levelDictionary));
+   return levelDictionary;
+}
+
+
+// ###### Load dictionary and register it by its ID #########################
+const ZSTDDictionary* ZSTDDictionary::loadDictionary(const std::filesystem::path& fileName)
+{
+   std::unique_ptr<ZSTDDictionary> dictionary(new ZSTDDictionary(fileName));
+
+   std::lock_guard<std::mutex> lock(RegistryMutex);
+   std::map<unsigned int, std::unique_ptr<ZSTDDictionary>>::const_iterator found =
+      Registry.find(dictionary->id());
+   if(found != Registry.end()) {
+      HPCT_LOG(warning) << "ZSTD dictionary " << fileName << " has the same ID "
+                        << dictionary->id() << " as " << found->second->fileName()
+                        << " -> using the latter";
+      return found->second.get();
+   }
+   HPCT_LOG(debug) << "Loaded ZSTD dictionary " << fileName
+                   << " with ID " << dictionary->id();
+   const ZSTDDictionary* result = dictionary.get();
+   Registry.insert(std::pair<unsigned int, std::unique_ptr<ZSTDDictionary>>(
+                      dictionary->id(), std::move(dictionary)));
+   return result;
+}
+
+
+// ###### Find registered dictionary by its ID ##############################
+const ZSTDDictionary* ZSTDDictionary::getDictionary(const unsigned int id)
+{
+   std::lock_guard<std::mutex> lock(RegistryMutex);
+   std::map<unsigned int, std::unique_ptr<ZSTDDictionary>>::const_iterator found =
+      Registry.find(id);
+   if(found != Registry.end()) {
+      return found->second.get();
+   }
+   return nullptr;
+}
+
+
+// ###### Train dictionary from samples (e.g. results files) ################
+unsigned int ZSTDDictionary::trainDictionary(const std::vector<std::string>& samples,
+                                             const std::filesystem::path&    fileName,
+                                             const size_t                    maxDictionarySize)
+{
+   // ====== Concatenate the samples ========================================
+   std::string         sampleBuffer;
+   std::vector<size_t> sampleSizes;
+   sampleSizes.reserve(samples.size());
+   for(const std::string& sample : samples) {
+      sampleBuffer += sample;
+      sampleSizes.push_back(sample.size());
+   }
+
+   // ====== Train the dictionary ===========================================
+   std::vector<char> dictionary(maxDictionarySize);
+   const size_t dictionarySize =
+      ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+                            sampleBuffer.data(), sampleSizes.data(),
+                            (unsigned int)sampleSizes.size());
+   if(ZDICT_isError(dictionarySize)) {
+      throw std::runtime_error(std::string("Training ZSTD dictionary failed: ") +
+                               ZDICT_getErrorName(dictionarySize));
+   }
+
+   // ====== Write the dictionary ===========================================
+   const std::filesystem::path tmpFileName = fileName.string() + ".tmp";
+   std::ofstream os(tmpFileName, std::ios::binary|std::ios::trunc);
+   os.write(dictionary.data(), dictionarySize);
+   os.close();
+   if(!os.good()) {
+      std::filesystem::remove(tmpFileName);
+      throw std::runtime_error("Unable to write ZSTD dictionary " + fileName.string());
+   }
+   std::filesystem::rename(tmpFileName, fileName);
+
+   return ZSTD_getDictID_fromDict(dictionary.data(), dictionarySize);
+}
+
@@ -0,0 +1,94 @@
+// ==========================================================================
+//     _   _ _ ____            ____          _____
+//    | | | (_)  _ \ ___ _ __ / ___|___  _ _|_   _| __ __ _  ___ ___ _ __
+//    | |_| | | |_) / _ \ '__| |   / _ \| '_ \| || '__/ _` |/ __/ _ \ '__|
+//    |  _  | |  __/  __/ |  | |__| (_) | | | | || | | (_| | (_|  __/ |
+//    |_| |_|_|_|   \___|_|   \____\___/|_| |_|_||_|  \__,_|\___\___|_|
+//
+//       ---  High-Performance Connectivity Tracer (HiPerConTracer)  ---
+//                 https://www.nntb.no/~dreibh/hipercontracer/
+// ==========================================================================
+//
+// High-Performance Connectivity Tracer (HiPerConTracer)
+// Copyright (C) 2015-2026 by Thomas Dreibholz
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact: dreibh@simula.no
+
+#ifndef ZSTDDICTIONARY_H
+#define ZSTDDICTIONARY_H
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <zstd.h>
+
+
+// ==========================================================================
+// ZSTD dictionaries for small results files.
+//
+// Results files are rotated frequently, i.e. they are small. Without a
+// dictionary, every file starts compression with an empty window. A trained
+// dictionary provides the repetitive parts of the records up front.
+// The dictionary ID is stored in the ZSTD frame header, i.e. a reader only
+// needs the dictionary with this ID to be loaded.
+// ==========================================================================
+
+class ZSTDDictionary
+{
+   public:
+   ZSTDDictionary(const std::filesystem::path& fileName,
+                  const int                    compressionLevel = ZSTD_CLEVEL_DEFAULT);
+   ~ZSTDDictionary();
+
+   inline unsigned int id() const {
+      return ID;
+   }
+   inline const std::filesystem::path& fileName() const {
+      return FileName;
+   }
+   const ZSTD_CDict* compressionDictionary(const int compressionLevel = 0) const;
+   inline const ZSTD_DDict* decompressionDictionary() const {
+      return DecompressionDictionary;
+   }
+
+   static const ZSTDDictionary* loadDictionary(const std::filesystem::path& fileName);
+   static const ZSTDDictionary* getDictionary(const unsigned int id);
+   static unsigned int trainDictionary(const std::vector<std::string>& samples,
+                                       const std::filesystem::path&    fileName,
+                                       const size_t                    maxDictionarySize);
+
+   private:
+   const std::filesystem::path                                    FileName;
+   const int                                                      CompressionLevel;
+   std::string                                                    Content;
+   unsigned int                                                   ID;
+   ZSTD_CDict*                                                    CompressionDictionary;
+   ZSTD_DDict*                                                    DecompressionDictionary;
+
+   // Digested dictionaries for other compression levels, created on demand:
+   mutable std::mutex                                             LevelMutex;
+   mutable std::map<int, ZSTD_CDict*>                             LevelDictionaries;
+
+   static std::mutex                                              RegistryMutex;
+   static std::map<unsigned int, std::unique_ptr<ZSTDDictionary>> Registry;
+};
+
+#endif